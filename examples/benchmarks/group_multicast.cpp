@@ -0,0 +1,75 @@
+/******************************************************************************
+ *  Micro benchmark for publishing messages to a local group with many        *
+ *  subscribers. Measures the time until all subscribers received all         *
+ *  messages.                                                                 *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include "caf/all.hpp"
+
+using std::endl;
+using namespace caf;
+
+namespace {
+
+using tick_atom = atom_constant<atom("tick")>;
+
+// Counts received ticks and reports to `listener` after receiving `n` ticks.
+behavior subscriber(event_based_actor* self, actor listener, int n) {
+  auto received = std::make_shared<int>(0);
+  return {
+    [=](tick_atom) {
+      if (++*received == n) {
+        self->send(listener, ok_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(subscribers, "subscribers,s", "number of group subscribers")
+    .add(messages, "messages,m", "number of messages published to the group");
+  }
+
+  int subscribers = 10000;
+  int messages = 100;
+};
+
+void caf_main(actor_system& sys, const config& cfg) {
+  using clock_type = std::chrono::steady_clock;
+  scoped_actor self{sys};
+  auto grp = sys.groups().anonymous();
+  for (auto i = 0; i < cfg.subscribers; ++i)
+    sys.spawn_in_group(grp, subscriber, actor{self}, cfg.messages);
+  auto t0 = clock_type::now();
+  // Publish from outside of any actor to exercise the path for external
+  // enqueues into the scheduler.
+  for (auto i = 0; i < cfg.messages; ++i)
+    anon_send(grp, tick_atom::value);
+  int done = 0;
+  self->receive_for(done, cfg.subscribers)(
+    [](ok_atom) {
+      // nop
+    }
+  );
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto deliveries = static_cast<double>(cfg.subscribers) * cfg.messages;
+  std::cout << cfg.messages << " messages to " << cfg.subscribers
+            << " subscribers took " << ms.count() << "ms ("
+            << static_cast<uint64_t>(deliveries * 1000
+                                     / std::max<int64_t>(ms.count(), 1))
+            << " deliveries/s)" << endl;
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
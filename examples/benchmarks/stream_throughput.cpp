@@ -0,0 +1,290 @@
+/******************************************************************************
+ *  Micro benchmark for streams. Measures throughput, batch latency, and CPU  *
+ *  time per item for the following setups:                                   *
+ *  - direct:    source -> sink                                               *
+ *  - pipeline:  source -> stage(s) -> sink                                   *
+ *  - broadcast: source -> N sinks                                            *
+ *  - remote:    source -> sink in a second actor system (BASP via loopback)  *
+ *                                                                            *
+ *  Stream settings such as --stream.desired-batch-complexity and             *
+ *  --stream.max-batch-delay apply to all setups.                             *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::endl;
+using std::string;
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// Returns the current time in nanoseconds since the epoch of `clock_type`.
+int64_t now_ns() {
+  auto t = clock_type::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+// A stream element carrying its creation time and a configurable payload.
+struct item {
+  int64_t created;
+  string payload;
+};
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, item& x) {
+  return f(meta::type_name("item"), x.created, x.payload);
+}
+
+// Collects the measurements of a single sink.
+struct report {
+  size_t received = 0;
+  std::vector<int64_t> latencies;
+};
+
+using report_ptr = std::shared_ptr<report>;
+
+behavior source(event_based_actor* self, int num_items, size_t item_size) {
+  auto init = [](int& x) {
+    x = 0;
+  };
+  auto pull = [=](int& x, downstream<item>& out, size_t hint) {
+    auto t = now_ns();
+    auto n = std::min(num_items - x, static_cast<int>(hint));
+    for (int i = 0; i < n; ++i)
+      out.push(item{t, string(item_size, 'x')});
+    x += n;
+  };
+  auto done = [=](const int& x) {
+    return x == num_items;
+  };
+  return {
+    [=](const std::vector<actor>& sinks) {
+      auto res = self->make_source(sinks.front(), init, pull, done);
+      for (size_t i = 1; i < sinks.size(); ++i)
+        res.ptr()->add_outbound_path(sinks[i]);
+    },
+    [=](open_atom) {
+      return self->make_source(init, pull, done);
+    }
+  };
+}
+
+behavior stage(event_based_actor* self) {
+  return {
+    [=](stream<item> in) {
+      return self->make_stage(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [](unit_t&, downstream<item>& out, item x) {
+          out.push(std::move(x));
+        }
+      );
+    }
+  };
+}
+
+behavior sink(event_based_actor* self, report_ptr rep, actor listener) {
+  return {
+    [=](stream<item> in) {
+      return self->make_sink(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        // Measure the latency of each batch by its oldest item.
+        [=](unit_t&, std::vector<item>& xs) {
+          if (xs.empty())
+            return;
+          rep->received += xs.size();
+          rep->latencies.emplace_back(now_ns() - xs.front().created);
+        },
+        [=](unit_t&, const error& err) {
+          if (err)
+            std::cerr << "sink aborted: " << to_string(err) << endl;
+          self->send(listener, ok_atom::value);
+        }
+      );
+    }
+  };
+}
+
+struct config : actor_system_config {
+  config() {
+    add_message_type<item>("item");
+    opt_group{custom_options_, "global"}
+    .add(scenario, "scenario,S",
+         "direct, pipeline, broadcast, remote, or all (default)")
+    .add(items, "items,n", "number of items produced by the source")
+    .add(item_size, "item-size,e", "payload size of each item in bytes")
+    .add(stages, "stages,t", "number of stages in the pipeline setup")
+    .add(sinks, "sinks,s", "number of sinks in the broadcast setup");
+  }
+
+  string scenario = "all";
+  int items = 1000000;
+  int item_size = 16;
+  int stages = 3;
+  int sinks = 4;
+};
+
+// Prints throughput, CPU time per item, and latency percentiles.
+void print_results(const string& name, const config& cfg,
+                   clock_type::duration wall_time, std::clock_t cpu_time,
+                   const std::vector<report_ptr>& reports) {
+  size_t received = 0;
+  std::vector<int64_t> xs;
+  for (auto& rep : reports) {
+    received += rep->received;
+    xs.insert(xs.end(), rep->latencies.begin(), rep->latencies.end());
+  }
+  if (received != static_cast<size_t>(cfg.items) * reports.size())
+    std::cerr << name << ": sinks received " << received << " items" << endl;
+  std::sort(xs.begin(), xs.end());
+  auto percentile = [&](size_t p) -> int64_t {
+    if (xs.empty())
+      return 0;
+    return xs[std::min(xs.size() - 1, xs.size() * p / 100)] / 1000;
+  };
+  using std::chrono::duration_cast;
+  auto ms = duration_cast<std::chrono::milliseconds>(wall_time).count();
+  auto items_per_sec = received * 1000 / static_cast<size_t>(std::max(ms,
+                                                                 int64_t{1}));
+  auto cpu_ns = static_cast<double>(cpu_time) * 1e9 / CLOCKS_PER_SEC;
+  std::cout << name << ": " << received << " items in " << ms << "ms ("
+            << items_per_sec << " items/s, "
+            << static_cast<int64_t>(cpu_ns / std::max(received, size_t{1}))
+            << "ns CPU/item), " << xs.size()
+            << " batches with latency in us: p50=" << percentile(50)
+            << " p90=" << percentile(90) << " p99=" << percentile(99)
+            << " max=" << (xs.empty() ? 0 : xs.back() / 1000) << endl;
+}
+
+// Spawns `num_sinks` sinks in `sys` that report to `self`.
+std::vector<actor> spawn_sinks(actor_system& sys, scoped_actor& self,
+                               int num_sinks,
+                               std::vector<report_ptr>& reports) {
+  std::vector<actor> result;
+  for (int i = 0; i < num_sinks; ++i) {
+    reports.emplace_back(std::make_shared<report>());
+    result.emplace_back(sys.spawn(sink, reports.back(), actor{self}));
+  }
+  return result;
+}
+
+// Waits until `num_sinks` sinks are done and prints the results.
+void await_sinks(scoped_actor& self, const string& name, const config& cfg,
+                 int num_sinks, clock_type::time_point t0, std::clock_t c0,
+                 const std::vector<report_ptr>& reports) {
+  int done = 0;
+  self->receive_for(done, num_sinks)(
+    [](ok_atom) {
+      // nop
+    }
+  );
+  print_results(name, cfg, clock_type::now() - t0, std::clock() - c0,
+                reports);
+}
+
+void run_pipeline(actor_system& sys, const config& cfg, const string& name,
+                  int num_stages) {
+  scoped_actor self{sys};
+  std::vector<report_ptr> reports;
+  auto snk = spawn_sinks(sys, self, 1, reports).front();
+  auto src = sys.spawn(source, cfg.items, static_cast<size_t>(cfg.item_size));
+  auto pipeline = snk;
+  std::vector<actor> stages;
+  for (int i = 0; i < num_stages; ++i) {
+    stages.emplace_back(sys.spawn(stage));
+    pipeline = pipeline * stages.back();
+  }
+  pipeline = pipeline * src;
+  auto t0 = clock_type::now();
+  auto c0 = std::clock();
+  anon_send(pipeline, open_atom::value);
+  await_sinks(self, name, cfg, 1, t0, c0, reports);
+}
+
+void run_broadcast(actor_system& sys, const config& cfg) {
+  scoped_actor self{sys};
+  std::vector<report_ptr> reports;
+  auto sinks = spawn_sinks(sys, self, std::max(cfg.sinks, 1), reports);
+  auto src = sys.spawn(source, cfg.items, static_cast<size_t>(cfg.item_size));
+  auto t0 = clock_type::now();
+  auto c0 = std::clock();
+  anon_send(src, sinks);
+  await_sinks(self, "broadcast", cfg, static_cast<int>(sinks.size()), t0, c0,
+              reports);
+}
+
+void run_remote(actor_system& sys, const config& cfg) {
+  // Run the sink in a second actor system that only shares the stream
+  // settings with the first one.
+  config remote_cfg;
+  remote_cfg.load<io::middleman>();
+  remote_cfg.stream_desired_batch_complexity
+    = cfg.stream_desired_batch_complexity;
+  remote_cfg.stream_max_batch_delay = cfg.stream_max_batch_delay;
+  remote_cfg.stream_credit_round_interval = cfg.stream_credit_round_interval;
+  actor_system remote_sys{remote_cfg};
+  scoped_actor self{remote_sys};
+  std::vector<report_ptr> reports;
+  auto snk = spawn_sinks(remote_sys, self, 1, reports).front();
+  auto port = remote_sys.middleman().publish(snk, 0, "127.0.0.1");
+  if (!port) {
+    std::cerr << "remote: unable to publish sink: "
+              << remote_sys.render(port.error()) << endl;
+    return;
+  }
+  auto proxy = sys.middleman().remote_actor("127.0.0.1", *port);
+  if (!proxy) {
+    std::cerr << "remote: unable to connect to sink: "
+              << sys.render(proxy.error()) << endl;
+    return;
+  }
+  auto src = sys.spawn(source, cfg.items, static_cast<size_t>(cfg.item_size));
+  auto t0 = clock_type::now();
+  auto c0 = std::clock();
+  anon_send(src, std::vector<actor>{*proxy});
+  await_sinks(self, "remote", cfg, 1, t0, c0, reports);
+  // The middleman keeps references to both actors for the BASP connection,
+  // i.e., they do not terminate on their own.
+  anon_send_exit(src, exit_reason::user_shutdown);
+  anon_send_exit(snk, exit_reason::user_shutdown);
+}
+
+void caf_main(actor_system& sys, const config& cfg) {
+  std::cout << "items: " << cfg.items << ", item size: " << cfg.item_size
+            << " bytes, desired batch complexity: "
+            << deep_to_string(cfg.stream_desired_batch_complexity)
+            << ", max batch delay: " << deep_to_string(cfg.stream_max_batch_delay)
+            << endl;
+  auto enabled = [&](const char* name) {
+    return cfg.scenario == "all" || cfg.scenario == name;
+  };
+  if (enabled("direct"))
+    run_pipeline(sys, cfg, "direct", 0);
+  if (enabled("pipeline"))
+    run_pipeline(sys, cfg, "pipeline", std::max(cfg.stages, 1));
+  if (enabled("broadcast"))
+    run_broadcast(sys, cfg);
+  if (enabled("remote"))
+    run_remote(sys, cfg);
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN(io::middleman)
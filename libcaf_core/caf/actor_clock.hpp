@@ -19,6 +19,7 @@
 #pragma once
 
 #include <chrono>
+#include <vector>
 
 #include "caf/fwd.hpp"
 
@@ -73,6 +74,11 @@ public:
   /// Cancels the pending request timeout for `id`.
   virtual void cancel_request_timeout(abstract_actor* self, message_id id) = 0;
 
+  /// Cancels the pending request timeouts for all `ids` at once. The default
+  /// implementation calls `cancel_request_timeout` for each ID.
+  virtual void cancel_request_timeouts(abstract_actor* self,
+                                       const std::vector<message_id>& ids);
+
   /// Cancels all timeouts for `self`.
   virtual void cancel_timeouts(abstract_actor* self) = 0;
 
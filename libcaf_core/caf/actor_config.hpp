@@ -25,6 +25,7 @@
 #include "caf/detail/unique_function.hpp"
 #include "caf/fwd.hpp"
 #include "caf/input_range.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf {
 
@@ -46,6 +47,14 @@ public:
   input_range<const group>* groups;
   detail::unique_function<behavior(local_actor*)> init_fun;
 
+  /// Maximum number of messages the actor handles per activation. Uses the
+  /// setting of the scheduler if 0.
+  size_t max_throughput;
+
+  /// Desired processing time per activation. If non-zero, the actor lowers
+  /// its throughput limit based on the observed cost per message.
+  timespan throughput_budget;
+
   // -- properties -------------------------------------------------------------
 
   actor_config& add_flag(int x) {
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include <cstdint>
 #include <unordered_map>
 #include <condition_variable>
@@ -31,6 +32,7 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_control_block.hpp"
 
+#include "caf/detail/sharded.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 
 namespace caf {
@@ -59,6 +61,18 @@ public:
       put_impl(key, actor_cast<strong_actor_ptr>(val));
   }
 
+  /// Associates each actor in the range `[first, last)` with its ID. Acquires
+  /// the lock of each shard at most once, which makes this function
+  /// considerably cheaper than calling `put` for each actor when registering
+  /// large numbers of actors at once.
+  template <class Iterator>
+  void put_all(Iterator first, Iterator last) {
+    std::vector<strong_actor_ptr> xs;
+    for (; first != last; ++first)
+      xs.emplace_back(actor_cast<strong_actor_ptr>(*first));
+    put_all_impl(std::move(xs));
+  }
+
   /// Removes an actor from this registry,
   /// leaving `reason` for future reference.
   void erase(actor_id key);
@@ -109,6 +123,9 @@ private:
   /// Associates a local actor with its ID.
   void put_impl(actor_id key, strong_actor_ptr val);
 
+  /// Associates each actor in `xs` with its ID.
+  void put_all_impl(std::vector<strong_actor_ptr> xs);
+
   /// Returns the actor associated with `key` or `invalid_actor`.
   strong_actor_ptr get_impl(atom_value key) const;
 
@@ -117,14 +134,36 @@ private:
 
   using entries = std::unordered_map<actor_id, strong_actor_ptr>;
 
+  /// Number of shards for ID-to-actor mappings. Must be a power of two.
+  static constexpr size_t num_shards = 64;
+
+  /// Guards subsets of all ID-to-actor mappings. Actor IDs are consecutive,
+  /// hence the lower bits distribute actors evenly and we use the ID itself
+  /// for picking a shard.
+  using shards = detail::sharded<entries, num_shards>;
+
+  using shard = shards::shard;
+
+  /// Returns the shard responsible for `key`.
+  inline shard& shard_of(actor_id key) {
+    return shards_[key];
+  }
+
+  /// Returns the shard responsible for `key`.
+  inline const shard& shard_of(actor_id key) const {
+    return shards_[key];
+  }
+
+  /// Removes the mapping for `key` when the actor terminates.
+  void attach_erase_functor(actor_id key, const strong_actor_ptr& val);
+
   actor_registry(actor_system& sys);
 
   std::atomic<size_t> running_;
   mutable std::mutex running_mtx_;
   mutable std::condition_variable running_cv_;
 
-  mutable detail::shared_spinlock instances_mtx_;
-  entries entries_;
+  shards shards_;
 
   name_map named_entries_;
   mutable detail::shared_spinlock named_entries_mtx_;
@@ -36,6 +36,7 @@
 #include "caf/actor_registry.hpp"
 #include "caf/composable_behavior_based_actor.hpp"
 #include "caf/detail/init_fun_factory.hpp"
+#include "caf/detail/memory_pool.hpp"
 #include "caf/detail/spawn_fwd.hpp"
 #include "caf/detail/spawnable.hpp"
 #include "caf/fwd.hpp"
@@ -258,6 +259,10 @@ public:
   /// Returns a string representation for `err`.
   std::string render(const error& x) const;
 
+  /// Returns allocation statistics for mailbox elements and message data.
+  /// @note The memory pool is shared by all actor systems in this process.
+  detail::memory_pool::statistics allocation_stats() const;
+
   /// Returns the system-wide group manager.
   group_manager& groups();
 
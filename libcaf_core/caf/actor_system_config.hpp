@@ -34,13 +34,17 @@
 #include "caf/dictionary.hpp"
 #include "caf/fwd.hpp"
 #include "caf/is_typed_actor.hpp"
+#include "caf/make_counted.hpp"
 #include "caf/named_actor_config.hpp"
+#include "caf/rtti_pair.hpp"
 #include "caf/settings.hpp"
 #include "caf/stream.hpp"
 #include "caf/thread_hook.hpp"
 #include "caf/type_erased_value.hpp"
 
+#include "caf/detail/message_data.hpp"
 #include "caf/detail/safe_equal.hpp"
+#include "caf/detail/tuple_vals.hpp"
 #include "caf/detail/type_traits.hpp"
 
 namespace caf {
@@ -69,6 +73,11 @@ public:
 
   using value_factory_rtti_map = hash_map<std::type_index, value_factory>;
 
+  using message_factory = std::function<detail::message_data::cow_ptr ()>;
+
+  using message_factory_vector
+    = std::vector<std::pair<std::vector<rtti_pair>, message_factory>>;
+
   using actor_factory_map = hash_map<std::string, actor_factory>;
 
   using portable_name_map = hash_map<std::type_index, std::string>;
@@ -159,6 +168,20 @@ public:
     return add_actor_factory(std::move(name), make_actor_factory(std::move(f)));
   }
 
+  /// Allows CAF to deserialize messages with the element types `Ts...` into
+  /// a single memory block instead of allocating each element individually.
+  /// All types in `Ts...` must be builtin types or added via
+  /// `add_message_type` before starting the actor system.
+  /// @experimental
+  template <class... Ts>
+  actor_system_config& add_message_signature() {
+    static_assert(sizeof...(Ts) > 0, "empty messages need no factory");
+    message_factories.emplace_back(std::vector<rtti_pair>{
+                                     make_rtti_pair<Ts>()...},
+                                   &make_message_data<Ts...>);
+    return *this;
+  }
+
   /// Adds message type `T` with runtime type info `name`.
   template <class T>
   actor_system_config& add_message_type(std::string name) {
@@ -286,6 +309,7 @@ public:
 
   value_factory_string_map value_factories_by_name;
   value_factory_rtti_map value_factories_by_rtti;
+  message_factory_vector message_factories;
   actor_factory_map actor_factories;
   module_factory_vector module_factories;
   hook_factory_vector hook_factories;
@@ -332,6 +356,12 @@ protected:
   config_option_set custom_options_;
 
 private:
+  template <class... Ts>
+  static detail::message_data::cow_ptr make_message_data() {
+    return detail::message_data::cow_ptr{
+      make_counted<detail::tuple_vals<Ts...>>()};
+  }
+
   template <class T>
   void add_message_type_impl(std::string name) {
     type_names_by_rtti.emplace(std::type_index(typeid(T)), name);
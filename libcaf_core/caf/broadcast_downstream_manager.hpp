@@ -54,6 +54,9 @@ public:
   /// Container for caching `T`s per path with active filter.
   using path_state = detail::path_state<Filter, T>;
 
+  /// Type of chunks taken from the central buffer.
+  using typename super::chunk_type;
+
   /// Maps slot IDs to caches.
   using state_map_type = detail::unordered_flat_map<stream_slot, path_state>;
 
@@ -195,25 +198,7 @@ public:
 
   /// Forces the manager flush its buffer to the individual path buffers.
   void fan_out_flush() {
-    auto& buf = this->buf_;
-    auto f = [&](typename map_type::value_type& x,
-                 typename state_map_type::value_type& y) {
-      // Don't push new data into a closing path.
-      if (x.second->closing)
-        return;
-      // Push data from the global buffer to path buffers.
-      auto& st = y.second;
-      // TODO: replace with `if constexpr` when switching to C++17
-      if (std::is_same<select_type, detail::select_all>::value) {
-        st.buf.insert(st.buf.end(), buf.begin(), buf.end());
-      } else {
-        for (auto& piece : buf)
-          if (select_(st.filter, piece))
-            st.buf.emplace_back(piece);
-      }
-    };
-    detail::zip_foreach(f, this->paths_.container(), state_map_.container());
-    buf.clear();
+    fan_out(this->get_chunk(this->buf_.size()));
   }
 
 protected:
@@ -269,29 +254,63 @@ private:
       };
       detail::zip_foreach(g, this->paths_.container(), state_map_.container());
     } else {
+      fan_out(std::move(chunk));
       auto g = [&](typename map_type::value_type& x,
                    typename state_map_type::value_type& y) {
-        auto& st = y.second;
-        // Don't enqueue new data into a closing path.
-        if (!x.second->closing) {
-          // Push data from the global buffer to path buffers.
-          // TODO: replace with `if constexpr` when switching to C++17
-          if (std::is_same<select_type, detail::select_all>::value) {
-            st.buf.insert(st.buf.end(), chunk.begin(), chunk.end());
-          } else {
-            for (auto& piece : chunk)
-              if (select_(st.filter, piece))
-                st.buf.emplace_back(piece);
-          }
-        }
         // Always force batches on closing paths.
-        x.second->emit_batches(this->self(), st.buf,
+        x.second->emit_batches(this->self(), y.second.buf,
                                force_underfull || x.second->closing);
       };
       detail::zip_foreach(g, this->paths_.container(), state_map_.container());
     }
   }
 
+  /// Distributes `xs` to the buffers of all paths that aren't closing. Splits
+  /// `xs` into shared chunks of the smallest desired batch size, allowing
+  /// paths to ship chunks as batches without copying any element.
+  void fan_out(chunk_type xs) {
+    using buffer_type = detail::shared_chunk_buffer<T>;
+    if (xs.empty())
+      return;
+    auto chunk_size = std::numeric_limits<size_t>::max();
+    for (auto& kvp : this->paths_)
+      if (!kvp.second->closing && kvp.second->desired_batch_size > 0)
+        chunk_size = std::min(chunk_size, static_cast<size_t>(
+                                            kvp.second->desired_batch_size));
+    auto n = xs.size();
+    for (size_t pos = 0; pos < n; pos += chunk_size) {
+      message chunk;
+      if (chunk_size >= n) {
+        chunk = buffer_type::make_chunk(std::move(xs));
+      } else {
+        auto first = xs.begin() + static_cast<ptrdiff_t>(pos);
+        auto last = first + static_cast<ptrdiff_t>(std::min(chunk_size,
+                                                            n - pos));
+        chunk = buffer_type::make_chunk(chunk_type{
+          std::make_move_iterator(first), std::make_move_iterator(last)});
+      }
+      auto& ys = buffer_type::elements(chunk);
+      auto f = [&](typename map_type::value_type& x,
+                   typename state_map_type::value_type& y) {
+        // Don't push new data into a closing path.
+        if (x.second->closing)
+          return;
+        auto& st = y.second;
+        // TODO: replace with `if constexpr` when switching to C++17
+        if (std::is_same<select_type, detail::select_all>::value) {
+          st.buf.push_back(chunk);
+        } else {
+          typename buffer_type::index_list indices;
+          for (size_t i = 0; i < ys.size(); ++i)
+            if (select_(st.filter, ys[i]))
+              indices.emplace_back(static_cast<uint32_t>(i));
+          st.buf.push_back(chunk, std::move(indices));
+        }
+      };
+      detail::zip_foreach(f, this->paths_.container(), state_map_.container());
+    }
+  }
+
   state_map_type state_map_;
   select_type select_;
 };
@@ -0,0 +1,122 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "caf/actor_clock.hpp"
+#include "caf/downstream_msg.hpp"
+#include "caf/fwd.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf {
+
+/// Computes credit for an attached source.
+class credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Wraps an assignment of the controller to its source.
+  struct assignment {
+    /// Maximum number of items the source may have in flight, i.e., sent but
+    /// not yet processed.
+    int32_t credit;
+
+    /// Number of items per batch.
+    int32_t batch_size;
+  };
+
+  /// Bundles all inputs for computing credit at the start of a credit round.
+  struct cycle_info {
+    /// Time between two credit rounds.
+    timespan cycle;
+
+    /// Desired processing time per batch.
+    timespan desired_batch_complexity;
+
+    /// Accumulated size of all batches that currently wait in the mailbox.
+    int32_t queued_items;
+
+    /// Amount of credit the source still holds from previous rounds.
+    int32_t assigned_credit;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit credit_controller(actor_clock& clock);
+
+  virtual ~credit_controller();
+
+  // -- properties -------------------------------------------------------------
+
+  actor_clock& clock() noexcept {
+    return clock_;
+  }
+
+  // -- pure virtual functions -------------------------------------------------
+
+  /// Called before processing the batch `x` in order to allow the controller
+  /// to keep statistics on incoming batches.
+  virtual void before_processing(downstream_msg::batch& x) = 0;
+
+  /// Called after processing the batch `x` in order to allow the controller to
+  /// keep statistics on incoming batches.
+  virtual void after_processing(downstream_msg::batch& x) = 0;
+
+  /// Assigns initial credit during the stream handshake.
+  virtual assignment compute_initial() = 0;
+
+  /// Computes a credit assignment for the next credit round.
+  virtual assignment compute(const cycle_info& x) = 0;
+
+private:
+  actor_clock& clock_;
+};
+
+/// @relates credit_controller
+using credit_controller_ptr = std::unique_ptr<credit_controller>;
+
+/// Creates a credit controller for an inbound path. An empty factory selects
+/// the default controller.
+/// @relates credit_controller
+using credit_controller_factory =
+  std::function<credit_controller_ptr (inbound_path*)>;
+
+/// Returns a factory for controllers that estimate how many items an actor
+/// processes per credit round based on the measured processing time per item.
+/// This is the default controller.
+/// @relates credit_controller
+credit_controller_factory complexity_based_credit();
+
+/// Returns a factory for controllers that extend the estimate of
+/// `complexity_based_credit` by the round-trip time to the source and limit
+/// the number of items waiting in the mailbox. Suited for remote sources.
+/// @relates credit_controller
+credit_controller_factory latency_aware_credit();
+
+/// Returns a factory for controllers that allow each source `credit` items in
+/// flight and that always ask for batches of size `batch_size`.
+/// @pre `credit > 0 && batch_size > 0`
+/// @relates credit_controller
+credit_controller_factory fixed_credit(int32_t credit, int32_t batch_size);
+
+} // namespace caf
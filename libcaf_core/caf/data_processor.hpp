@@ -314,7 +314,8 @@ public:
   // Applies this processor as Derived to `xs` in saving mode.
   template <class D, class T>
   static typename std::enable_if<
-    D::reads_state && !detail::is_byte_sequence<T>::value,
+    D::reads_state && !detail::is_byte_sequence<T>::value
+    && !detail::is_arithmetic_sequence<T>::value,
     error
   >::type
   apply_sequence(D& self, T& xs) {
@@ -327,7 +328,8 @@ public:
   // Applies this processor as Derived to `xs` in loading mode.
   template <class D, class T>
   static typename std::enable_if<
-    !D::reads_state && !detail::is_byte_sequence<T>::value,
+    !D::reads_state && !detail::is_byte_sequence<T>::value
+    && !detail::is_arithmetic_sequence<T>::value,
     error
   >::type
   apply_sequence(D& self, T& xs) {
@@ -366,6 +368,39 @@ public:
                        [&] { return self.end_sequence(); });
   }
 
+  // Optimized saving for contiguous sequences of integers or floats.
+  template <class D, class T>
+  static typename std::enable_if<
+    D::reads_state && detail::is_arithmetic_sequence<T>::value,
+    error
+  >::type
+  apply_sequence(D& self, T& xs) {
+    auto s = xs.size();
+    auto type = builtin_of<typename T::value_type>::value;
+    return error::eval([&] { return self.begin_sequence(s); },
+                       [&] { return s > 0 ? self.apply_builtin_range(type, s,
+                                                                     &xs[0])
+                                          : none; },
+                       [&] { return self.end_sequence(); });
+  }
+
+  // Optimized loading for contiguous sequences of integers or floats.
+  template <class D, class T>
+  static typename std::enable_if<
+    !D::reads_state && detail::is_arithmetic_sequence<T>::value,
+    error
+  >::type
+  apply_sequence(D& self, T& xs) {
+    size_t s;
+    auto type = builtin_of<typename T::value_type>::value;
+    return error::eval([&] { return self.begin_sequence(s); },
+                       [&] { xs.resize(s);
+                             return s > 0 ? self.apply_builtin_range(type, s,
+                                                                     &xs[0])
+                                          : none; },
+                       [&] { return self.end_sequence(); });
+  }
+
   /// Applies this processor to a sequence of values.
   template <class T>
   typename std::enable_if<
@@ -552,7 +587,64 @@ protected:
   /// Applies this processor to a single builtin value.
   virtual error apply_builtin(builtin in_out_type, void* in_out) = 0;
 
+  /// Applies this processor to `num` consecutive builtin values of type
+  /// `in_out_type`, starting at `first`. The default implementation calls
+  /// `apply_builtin` for each value. Implementations may override this
+  /// function to process numeric sequences in bulk.
+  /// @pre `in_out_type` denotes an integer or floating point type
+  virtual error apply_builtin_range(builtin in_out_type, size_t num,
+                                    void* first) {
+    auto ptr = static_cast<char*>(first);
+    auto step = builtin_size(in_out_type);
+    for (size_t i = 0; i < num; ++i) {
+      auto err = apply_builtin(in_out_type, ptr + i * step);
+      if (err)
+        return err;
+    }
+    return none;
+  }
+
+  /// Returns the size of a single value of numeric type `x` in bytes.
+  static size_t builtin_size(builtin x) {
+    switch (x) {
+      default:
+        // i8_v and u8_v
+        return 1;
+      case i16_v:
+      case u16_v:
+        return 2;
+      case i32_v:
+      case u32_v:
+        return 4;
+      case i64_v:
+      case u64_v:
+        return 8;
+      case float_v:
+        return sizeof(float);
+      case double_v:
+        return sizeof(double);
+    }
+  }
+
 private:
+  // Maps integer and floating point types to their `builtin` enum value.
+  template <class T, bool IsIntegral = std::is_integral<T>::value>
+  struct builtin_of {
+    static constexpr builtin value =
+      static_cast<builtin>(detail::tl_index_of<builtin_t, T>::value);
+  };
+
+  template <class T>
+  struct builtin_of<T, true> {
+    using type =
+      typename detail::select_integer_type<
+        static_cast<int>(sizeof(T)) * (std::is_signed<T>::value ? -1 : 1)
+      >::type;
+
+    static constexpr builtin value =
+      static_cast<builtin>(detail::tl_index_of<builtin_t, type>::value);
+  };
+
   template <class T>
   T& deconst(const T& x) {
     return const_cast<T&>(x);
@@ -43,6 +43,7 @@ extern const timespan credit_round_interval;
 namespace scheduler {
 
 extern const atom_value policy;
+extern const atom_value clock;
 extern string_view profiling_output_file;
 extern const size_t max_threads;
 extern const size_t max_throughput;
@@ -52,6 +53,7 @@ extern const timespan profiling_resolution;
 
 namespace work_stealing {
 
+extern const atom_value queue_type;
 extern const size_t aggressive_poll_attempts;
 extern const size_t aggressive_steal_interval;
 extern const size_t moderate_poll_attempts;
@@ -59,6 +61,8 @@ extern const size_t moderate_steal_interval;
 extern const timespan moderate_sleep_duration;
 extern const size_t relaxed_steal_interval;
 extern const timespan relaxed_sleep_duration;
+extern const bool pin_workers;
+extern const size_t remote_steal_threshold;
 
 } // namespace work_stealing
 
@@ -68,12 +72,19 @@ extern string_view component_filter;
 extern const atom_value console;
 extern string_view console_format;
 extern const atom_value console_verbosity;
+extern const atom_value file_encoding;
 extern string_view file_format;
 extern string_view file_name;
 extern const atom_value file_verbosity;
 
 } // namespace logger
 
+namespace groups {
+
+extern const size_t relay_fan_out;
+
+} // namespace groups
+
 namespace middleman {
 
 extern std::vector<std::string> app_identifiers;
@@ -82,6 +93,8 @@ extern const size_t max_consecutive_reads;
 extern const size_t heartbeat_interval;
 extern const size_t cached_udp_buffers;
 extern const size_t max_pending_msgs;
+extern const bool compact_type_ids;
+extern const size_t multiplexer_threads;
 
 } // namespace middleman
 
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Recycles the storage of stream batches. Sinks and stages hand the vectors
+/// of processed batches back to the pool and outbound paths fill their next
+/// batches from recycled vectors instead of allocating new ones. Each thread
+/// owns a bounded free list per element type, i.e., `take` and `recycle`
+/// never synchronize. Stages consume and produce batches on the same worker,
+/// which makes them the main beneficiary. Building CAF without `thread_local`
+/// support disables caching.
+template <class T>
+class batch_buffer_pool {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using buffer_type = std::vector<T>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum number of cached buffers per element type and thread.
+  static constexpr size_t max_buffers = 64;
+
+  /// Maximum capacity of cached buffers. Larger buffers get released to avoid
+  /// holding on to memory after a burst.
+  static constexpr size_t max_capacity = 4096;
+
+  // -- static member functions ------------------------------------------------
+
+  /// Returns an empty buffer, reusing storage from a batch this thread
+  /// processed earlier if possible.
+  static buffer_type take() {
+    buffer_type result;
+#ifndef CAF_NO_THREAD_LOCAL
+    auto& buffers = local_buffers();
+    if (!buffers.empty()) {
+      result.swap(buffers.back());
+      buffers.pop_back();
+    }
+#endif
+    return result;
+  }
+
+  /// Clears `xs` and stores its storage for future batches of this thread.
+  static void recycle(buffer_type&& xs) {
+#ifndef CAF_NO_THREAD_LOCAL
+    if (xs.capacity() == 0 || xs.capacity() > max_capacity)
+      return;
+    auto& buffers = local_buffers();
+    if (buffers.size() < max_buffers) {
+      xs.clear();
+      buffers.emplace_back(std::move(xs));
+    }
+#else
+    static_cast<void>(xs);
+#endif
+  }
+
+  /// Returns the number of buffers cached by this thread.
+  static size_t size() {
+#ifndef CAF_NO_THREAD_LOCAL
+    return local_buffers().size();
+#else
+    return 0;
+#endif
+  }
+
+  /// Releases all buffers cached by this thread.
+  static void clear() {
+#ifndef CAF_NO_THREAD_LOCAL
+    local_buffers().clear();
+#endif
+  }
+
+private:
+#ifndef CAF_NO_THREAD_LOCAL
+  static std::vector<buffer_type>& local_buffers() {
+    thread_local std::vector<buffer_type> buffers;
+    return buffers;
+  }
+#endif
+};
+
+template <class T>
+constexpr size_t batch_buffer_pool<T>::max_buffers;
+
+template <class T>
+constexpr size_t batch_buffer_pool<T>::max_capacity;
+
+} // namespace detail
+} // namespace caf
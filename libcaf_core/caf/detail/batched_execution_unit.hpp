@@ -0,0 +1,55 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include "caf/execution_unit.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Collects resumables instead of scheduling them one by one. Passing this
+/// unit to `enqueue` while delivering a message to many receivers allows the
+/// caller to schedule all receivers that became ready at once by calling
+/// `flush`, i.e., waking up each worker at most once.
+class batched_execution_unit : public execution_unit {
+public:
+  /// Creates a unit that delegates to `host` on flush or directly to the
+  /// scheduler of `sys` if `host == nullptr`.
+  /// @pre `sys != nullptr`
+  batched_execution_unit(actor_system* sys, execution_unit* host);
+
+  ~batched_execution_unit() override;
+
+  /// Stores `ptr` until the next call to `flush`.
+  void exec_later(resumable* ptr) override;
+
+  /// Schedules all collected resumables.
+  void flush();
+
+private:
+  execution_unit* host_;
+  std::vector<resumable*> jobs_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <tuple>
+#include <vector>
 #include <type_traits>
 
 #include "caf/none.hpp"
@@ -80,9 +81,32 @@ public:
   pointer or_else(const pointer& other);
 
 protected:
+  /// Builds an index for dispatching messages to the match cases in
+  /// `[begin_, end_)` by their type token and leading atom constant. Subtypes
+  /// call this member function after setting `begin_` and `end_`. Does
+  /// nothing for small behaviors, because scanning a few match cases is
+  /// cheaper than a lookup.
+  void build_dispatch_index();
+
   duration timeout_;
   match_case_info* begin_;
   match_case_info* end_;
+
+private:
+  /// Selects a match case by type token and leading atom constant.
+  struct dispatch_entry {
+    uint32_t type_token;
+    atom_value leading_atom;
+    match_case_info* ptr;
+  };
+
+  /// Orders dispatch entries by type token and leading atom.
+  static bool dispatch_key_less(const dispatch_entry& x,
+                                const dispatch_entry& y);
+
+  /// Sorted by type token, leading atom and position of the match case. Empty
+  /// if this behavior dispatches by scanning all match cases.
+  std::vector<dispatch_entry> dispatch_index_;
 };
 
 template <class Tuple>
@@ -173,6 +197,7 @@ private:
             std::integral_constant<size_t, Last>) {
     this->begin_ = arr_.data();
     this->end_ = arr_.data() + arr_.size();
+    this->build_dispatch_index();
     std::integral_constant<bool, has_timeout> token;
     set_timeout(token);
   }
@@ -0,0 +1,147 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "caf/logger.hpp"
+#include "caf/timestamp.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Type tags for the records of a binary log.
+///
+/// A binary log starts with the 8-byte magic number `CAFBLOG\1`, followed by
+/// a 32-bit byte order mark with value `0x01020304` and the start time of the
+/// logger as 64-bit nanoseconds since epoch. The remainder of the file
+/// consists of records. All integers use the byte order of the writer.
+enum class binary_log_record : uint8_t {
+  /// Introduces a source location, i.e., a 32-bit ID, a 32-bit line number
+  /// and the strings for file name, pretty function name and function name.
+  location = 1,
+  /// Introduces a thread, i.e., a 32-bit ID and the name of the thread.
+  thread = 2,
+  /// Stores an event, i.e., the timestamp (64 bit), thread ID (32 bit), actor
+  /// ID (64 bit), component (64 bit), level (8 bit), location ID (32 bit) and
+  /// the message in the encoding of `logger::line_builder`. Thread and
+  /// location IDs refer to previous records.
+  event = 3,
+};
+
+/// Writes logger events in a compact binary format. Each source location
+/// and each thread appears only once in the output, events refer to them by
+/// their ID. Strings are prefixed with their size as 32-bit integer.
+class binary_log_writer {
+public:
+  explicit binary_log_writer(std::ostream& out);
+
+  /// Writes the file header.
+  void write_header(timestamp t0);
+
+  /// Writes `x`, preceded by location and thread records if `x` is the first
+  /// event from its source location or thread.
+  void write(const logger::event& x);
+
+private:
+  struct location_key {
+    const char* file;
+    const char* fun;
+    unsigned line;
+
+    inline bool operator==(const location_key& other) const noexcept {
+      return file == other.file && fun == other.fun && line == other.line;
+    }
+  };
+
+  struct location_hash {
+    size_t operator()(const location_key& x) const noexcept;
+  };
+
+  uint32_t location_id(const logger::event& x);
+
+  uint32_t thread_id(std::thread::id x);
+
+  template <class T>
+  void append(T x);
+
+  void append(string_view x);
+
+  void flush();
+
+  std::ostream& out_;
+
+  /// Assembles records before writing them.
+  std::vector<char> buf_;
+
+  std::unordered_map<location_key, uint32_t, location_hash> locations_;
+
+  std::unordered_map<std::thread::id, uint32_t> threads_;
+};
+
+/// Reads events from a binary log file.
+class binary_log_reader {
+public:
+  explicit binary_log_reader(std::istream& in);
+
+  /// Reads the file header and returns whether the input is a binary log in
+  /// the byte order of this machine.
+  bool read_header();
+
+  /// Returns the start time of the logger.
+  inline timestamp t0() const noexcept {
+    return t0_;
+  }
+
+  /// Reads the next event into `x` and stores the name of its thread in
+  /// `thread_name`. Returns `false` at the end of input or on error. The
+  /// string views in `x` remain valid for the lifetime of the reader.
+  bool read(logger::event& x, std::string& thread_name);
+
+private:
+  struct location {
+    unsigned line;
+    std::string file;
+    std::string pretty_fun;
+    std::string simple_fun;
+  };
+
+  template <class T>
+  bool consume(T& x);
+
+  bool consume(std::string& x);
+
+  std::istream& in_;
+
+  timestamp t0_;
+
+  /// Uses a deque to keep references to elements valid.
+  std::deque<location> locations_;
+
+  std::vector<std::string> threads_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,137 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A bounded, lock-free queue for multiple producers and multiple consumers
+/// based on Dmitry Vyukov's array-based design. The queue stores raw pointers
+/// in a preallocated ring buffer, i.e., neither `push` nor `pop` allocate.
+/// @note The capacity is rounded up to the next power of two.
+template <class T>
+class bounded_mpmc_queue {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+  using size_type = size_t;
+
+  explicit bounded_mpmc_queue(size_type min_capacity)
+      : mask_(round_up(min_capacity) - 1),
+        cells_(new cell[mask_ + 1]) {
+    for (size_type i = 0; i <= mask_; ++i)
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    push_pos_.store(0, std::memory_order_relaxed);
+    pop_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  bounded_mpmc_queue(const bounded_mpmc_queue&) = delete;
+  bounded_mpmc_queue& operator=(const bounded_mpmc_queue&) = delete;
+
+  /// Tries to append `value` to the queue. Returns `false` if the queue is
+  /// full, in which case the queue remains unchanged.
+  bool push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto pos = push_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& x = cells_[pos & mask_];
+      auto seq = x.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          x.value = value;
+          x.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Tries to remove the oldest element from the queue. Returns `nullptr` if
+  /// the queue is empty.
+  pointer pop() {
+    auto pos = pop_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& x = cells_[pos & mask_];
+      auto seq = x.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (pop_pos_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          auto result = x.value;
+          x.seq.store(pos + mask_ + 1, std::memory_order_release);
+          return result;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = pop_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Returns whether the queue appears to be empty. The result is only a
+  /// snapshot when accessed concurrently.
+  bool empty() const {
+    return pop_pos_.load(std::memory_order_acquire)
+           >= push_pos_.load(std::memory_order_acquire);
+  }
+
+  /// Returns the maximum number of elements in the queue.
+  size_type capacity() const {
+    return mask_ + 1;
+  }
+
+private:
+  struct cell {
+    std::atomic<size_type> seq;
+    pointer value;
+  };
+
+  static size_type round_up(size_type x) {
+    size_type result = 2;
+    while (result < x)
+      result <<= 1;
+    return result;
+  }
+
+  const size_type mask_;
+  std::unique_ptr<cell[]> cells_;
+  char pad1_[CAF_CACHE_LINE_SIZE];
+  std::atomic<size_type> push_pos_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>)];
+  std::atomic<size_type> pop_pos_;
+  char pad3_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>)];
+};
+
+} // namespace detail
+} // namespace caf
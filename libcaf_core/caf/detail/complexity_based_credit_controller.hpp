@@ -0,0 +1,71 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "caf/credit_controller.hpp"
+#include "caf/inbound_path.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Computes credit for an attached source based on measuring the complexity
+/// of incoming batches, i.e., the processing time per item.
+class complexity_based_credit_controller : public credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = credit_controller;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit complexity_based_credit_controller(actor_clock& clock);
+
+  ~complexity_based_credit_controller() override;
+
+  // -- overrides --------------------------------------------------------------
+
+  void before_processing(downstream_msg::batch& x) override;
+
+  void after_processing(downstream_msg::batch& x) override;
+
+  assignment compute_initial() override;
+
+  assignment compute(const cycle_info& x) override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the measurements since the last credit round.
+  const inbound_path::stats_t& stats() const noexcept {
+    return stats_;
+  }
+
+protected:
+  // -- member variables -------------------------------------------------------
+
+  /// Start time of the current batch.
+  actor_clock::time_point t0_;
+
+  /// Summarizes how many elements we processed during the last cycle and how
+  /// much time we spent processing those elements.
+  inbound_path::stats_t stats_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,145 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace caf {
+namespace detail {
+
+/// Maps hash values to nodes by placing a fixed number of virtual points per
+/// node on a ring of 64-bit integers. A hash value belongs to the node owning
+/// the first point at or after it. Hence, inserting a node only moves hash
+/// values to the new node and erasing a node only moves the hash values of
+/// the erased node.
+template <class Node>
+class consistent_hash_ring {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// A virtual point on the ring.
+  using point = std::pair<uint64_t, Node>;
+
+  /// A list of points sorted by their position on the ring.
+  using point_list = std::vector<point>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Default number of virtual points per node.
+  static constexpr size_t default_replicas = 64;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit consistent_hash_ring(size_t replicas = default_replicas)
+      : replicas_(replicas > 0 ? replicas : 1) {
+    // nop
+  }
+
+  // -- static utility functions -----------------------------------------------
+
+  /// Scrambles the bits of `x` to spread hash values that differ only in a few
+  /// bits, e.g., the results of `std::hash` for integers, over the ring.
+  static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether the ring contains no nodes.
+  bool empty() const noexcept {
+    return points_.empty();
+  }
+
+  /// Returns the number of virtual points per node.
+  size_t replicas() const noexcept {
+    return replicas_;
+  }
+
+  /// Returns all virtual points.
+  const point_list& points() const noexcept {
+    return points_;
+  }
+
+  /// Returns whether `x` owns points on the ring.
+  bool contains(const Node& x) const {
+    return std::any_of(points_.begin(), points_.end(),
+                       [&](const point& y) { return y.second == x; });
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `x` to the ring. The positions of the points of `x` depend only on
+  /// `seed`, i.e., re-adding a node with the same seed restores its previous
+  /// share of hash values.
+  /// @pre `!contains(x)`
+  void insert(const Node& x, uint64_t seed) {
+    for (uint64_t i = 0; i < replicas_; ++i)
+      points_.emplace_back(mix(seed * replicas_ + i), x);
+    std::sort(points_.begin(), points_.end(),
+              [](const point& y, const point& z) { return y.first < z.first; });
+  }
+
+  /// Removes all points of `x` from the ring.
+  void erase(const Node& x) {
+    auto pred = [&](const point& y) { return y.second == x; };
+    points_.erase(std::remove_if(points_.begin(), points_.end(), pred),
+                  points_.end());
+  }
+
+  // -- lookup -----------------------------------------------------------------
+
+  /// Returns the node responsible for `hash_value` or `nullptr` if the ring is
+  /// empty.
+  const Node* find(uint64_t hash_value) const {
+    if (points_.empty())
+      return nullptr;
+    auto pos = mix(hash_value);
+    auto i = std::lower_bound(points_.begin(), points_.end(), pos,
+                              [](const point& y, uint64_t z) {
+                                return y.first < z;
+                              });
+    if (i == points_.end())
+      i = points_.begin();
+    return &i->second;
+  }
+
+private:
+  // -- member variables -------------------------------------------------------
+
+  /// Number of virtual points per node.
+  uint64_t replicas_;
+
+  /// Stores all virtual points in ascending order.
+  point_list points_;
+};
+
+template <class Node>
+constexpr size_t consistent_hash_ring<Node>::default_replicas;
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "caf/string_view.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Groups the CPUs available to this process into locality domains. A domain
+/// is a NUMA node or, on machines with a single NUMA node, a set of CPUs
+/// sharing a last-level (L3) cache.
+struct cpu_topology {
+  /// CPU IDs, grouped by locality domain. Never empty after `detect`.
+  std::vector<std::vector<int>> domains;
+
+  /// Returns the index of the domain that contains `cpu` or 0 if no domain
+  /// contains `cpu`.
+  size_t domain_of(int cpu) const;
+
+  /// Returns the total number of CPUs in all domains.
+  size_t num_cpus() const;
+
+  /// Queries the topology of the machine, as visible to this process. Falls
+  /// back to a single domain with `std::thread::hardware_concurrency()` CPUs
+  /// on platforms without topology information.
+  static cpu_topology detect();
+};
+
+/// Parses a CPU list in the format used by the Linux sysfs, e.g., "0-3,8".
+/// Returns an empty vector on error.
+std::vector<int> parse_cpu_list(string_view str);
+
+/// Pins the calling thread to `cpu`. Returns `false` if the platform does
+/// not support thread affinity or if the system call failed.
+bool pin_this_thread(int cpu);
+
+/// Returns the CPU the calling thread currently runs on or -1 if the platform
+/// does not support querying it.
+int current_cpu();
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "caf/credit_controller.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Allows a source a fixed number of items in flight and asks for batches of
+/// a fixed size.
+class fixed_credit_controller : public credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = credit_controller;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  fixed_credit_controller(actor_clock& clock, int32_t credit,
+                          int32_t batch_size);
+
+  ~fixed_credit_controller() override;
+
+  // -- overrides --------------------------------------------------------------
+
+  void before_processing(downstream_msg::batch& x) override;
+
+  void after_processing(downstream_msg::batch& x) override;
+
+  assignment compute_initial() override;
+
+  assignment compute(const cycle_info& x) override;
+
+private:
+  // -- member variables -------------------------------------------------------
+
+  assignment value_;
+};
+
+} // namespace detail
+} // namespace caf
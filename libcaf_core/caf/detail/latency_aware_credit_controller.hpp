@@ -0,0 +1,73 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "caf/detail/complexity_based_credit_controller.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Extends the complexity-based estimate by the round-trip time to the source.
+/// The controller hands out enough credit to keep the source busy until new
+/// credit arrives and shrinks credit when items pile up in the mailbox.
+class latency_aware_credit_controller
+  : public complexity_based_credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = complexity_based_credit_controller;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit latency_aware_credit_controller(actor_clock& clock);
+
+  ~latency_aware_credit_controller() override;
+
+  // -- overrides --------------------------------------------------------------
+
+  void before_processing(downstream_msg::batch& x) override;
+
+  assignment compute_initial() override;
+
+  assignment compute(const cycle_info& x) override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the smoothed round-trip time to the source.
+  timespan rtt() const noexcept {
+    return rtt_;
+  }
+
+private:
+  // -- member variables -------------------------------------------------------
+
+  /// Smoothed round-trip time, i.e., the time between granting credit to a
+  /// source without credit and receiving its next batch.
+  timespan rtt_;
+
+  /// Time of the last credit grant to a source without credit.
+  actor_clock::time_point grant_time_;
+
+  /// Stores whether the next batch completes an RTT measurement.
+  bool measuring_;
+};
+
+} // namespace detail
+} // namespace caf
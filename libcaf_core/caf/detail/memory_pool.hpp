@@ -0,0 +1,124 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "caf/config.hpp"
+#include "caf/detail/build_config.hpp"
+
+#if !defined(CAF_NO_MEM_MANAGEMENT) && !defined(CAF_NO_THREAD_LOCAL)
+#define CAF_ENABLE_MEMORY_POOL
+#endif
+
+namespace caf {
+namespace detail {
+
+/// A size-class allocator with a thread-local cache for each thread. Threads
+/// allocate from their local free lists without synchronization. Blocks freed
+/// by a thread other than the allocating thread travel back to their owner in
+/// batches via a lock-free stack. Requests exceeding the largest size class go
+/// to `malloc`.
+///
+/// The pool never returns memory to the operating system. Each thread keeps
+/// the chunks it reserved for its free lists, and when a thread terminates,
+/// the next thread that uses the pool adopts its cache with all of its
+/// blocks. Hence, the pool holds on to the peak amount of memory the threads
+/// of the process used for small objects.
+///
+/// The pool backs mailbox elements and message data. Building CAF with
+/// `CAF_NO_MEM_MANAGEMENT` (or on platforms without `thread_local`) turns
+/// `allocate` and `deallocate` into plain calls to `malloc` and `free`.
+class memory_pool {
+public:
+  /// Aggregated counters of all thread-local caches.
+  struct statistics {
+    /// Number of calls to `allocate`.
+    uint64_t allocations;
+    /// Number of calls to `deallocate`.
+    uint64_t deallocations;
+    /// Number of `deallocate` calls for blocks owned by another thread.
+    uint64_t remote_deallocations;
+    /// Number of remote blocks returned to their owner in batches.
+    uint64_t returned_batches;
+    /// Number of allocations served by `malloc` instead of a free list.
+    uint64_t heap_allocations;
+    /// Number of bytes the pool reserved from the heap for its free lists.
+    uint64_t reserved_bytes;
+    /// Number of thread-local caches, i.e., threads that used the pool.
+    uint64_t caches;
+  };
+
+  /// Number of blocks a thread collects before returning them to their owner.
+  static constexpr size_t batch_size = 32;
+
+  /// Size of the largest size class. Larger requests go to `malloc`.
+  static constexpr size_t max_block_size = 1024;
+
+  /// Alignment of all blocks returned by `allocate`. Blocks start 16 bytes
+  /// after an address returned by `malloc`.
+  static constexpr size_t alignment = alignof(std::max_align_t) < 16
+                                        ? alignof(std::max_align_t)
+                                        : 16;
+
+  /// Returns memory for an object of `size` bytes.
+  static void* allocate(size_t size);
+
+  /// Stores memory for `n` objects of `size` bytes each in `out`. Equivalent
+  /// to calling `allocate` `n` times, but visits the thread-local cache only
+  /// once. Each block gets released individually via `deallocate`.
+  static void allocate(size_t size, size_t n, void** out);
+
+  /// Releases memory previously acquired via `allocate`.
+  static void deallocate(void* ptr) noexcept;
+
+  /// Returns memory for an object of type `T`, or of a type derived from `T`
+  /// if `size` exceeds `sizeof(T)`. Types with a stricter alignment than the
+  /// pool provides bypass the pool and use `::operator new` instead.
+  template <class T>
+  static void* allocate_for(size_t size) {
+    if (alignof(T) > alignment)
+      return ::operator new(size);
+    return allocate(size);
+  }
+
+  /// Releases memory previously acquired via `allocate_for<T>`.
+  template <class T>
+  static void deallocate_for(void* ptr) noexcept {
+    if (alignof(T) > alignment)
+      ::operator delete(ptr);
+    else
+      deallocate(ptr);
+  }
+
+  /// Returns the aggregated statistics of all thread-local caches. The
+  /// counters are collected without stopping any thread, i.e., they are only
+  /// consistent while no other thread uses the pool.
+  static statistics stats();
+
+  /// Hands all blocks the calling thread collected for other threads back to
+  /// their owners, even if the batches are incomplete.
+  static void flush_thread_cache();
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,253 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+#include "caf/actor.hpp"
+#include "caf/behavior.hpp"
+#include "caf/downstream.hpp"
+#include "caf/error.hpp"
+#include "caf/exit_reason.hpp"
+#include "caf/message_priority.hpp"
+#include "caf/send.hpp"
+#include "caf/stream_manager.hpp"
+#include "caf/stream_stage_driver.hpp"
+#include "caf/stream_stage_trait.hpp"
+#include "caf/unit.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Implements a `stream_stage_driver` that runs a stateless `process` function
+/// on a pool of worker actors. The driver splits each incoming batch into one
+/// chunk per worker and pushes results downstream as workers respond, either
+/// in order of the input or in order of arrival.
+template <class Input, class DownstreamManager, class Process>
+class parallel_stage_driver final
+    : public stream_stage_driver<Input, DownstreamManager> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = stream_stage_driver<Input, DownstreamManager>;
+
+  using typename super::input_type;
+
+  using typename super::output_type;
+
+  using typename super::stream_type;
+
+  using trait = stream_stage_trait_t<Process>;
+
+  using input_batch = std::vector<input_type>;
+
+  using output_batch = std::vector<output_type>;
+
+  static_assert(std::is_same<typename trait::state, unit_t>::value,
+                "parallel stages require stateless process functions");
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel_stage_driver(DownstreamManager& out, size_t num_workers,
+                        Process f, bool ordered)
+      : super(out),
+        ordered_(ordered),
+        stopped_(false),
+        next_worker_(0),
+        next_id_(0),
+        next_emitted_id_(0),
+        in_flight_(0) {
+    if (num_workers == 0)
+      num_workers = 1;
+    // Allow two chunks per worker in flight to keep all workers busy while
+    // the stage waits for results.
+    max_in_flight_ = 2 * num_workers;
+    auto& sys = out.self()->system();
+    for (size_t i = 0; i < num_workers; ++i)
+      workers_.emplace_back(sys.spawn(worker, f));
+  }
+
+  ~parallel_stage_driver() override {
+    stop_workers();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the actors running the `process` function.
+  const std::vector<actor>& workers() const noexcept {
+    return workers_;
+  }
+
+  /// Returns the number of chunks currently processed by workers.
+  size_t in_flight() const noexcept {
+    return in_flight_;
+  }
+
+  // -- implementation of virtual functions ------------------------------------
+
+  void process(downstream<output_type>&, input_batch& batch) override {
+    if (batch.empty())
+      return;
+    auto n = workers_.size();
+    auto chunk_size = (batch.size() + n - 1) / n;
+    for (size_t pos = 0; pos < batch.size(); pos += chunk_size) {
+      auto first = batch.begin() + static_cast<ptrdiff_t>(pos);
+      auto last = first + static_cast<ptrdiff_t>(std::min(chunk_size,
+                                                          batch.size() - pos));
+      dispatch(input_batch{std::make_move_iterator(first),
+                           std::make_move_iterator(last)});
+    }
+  }
+
+  void finalize(const error&) override {
+    stopped_ = true;
+    stop_workers();
+  }
+
+  bool congested() const noexcept override {
+    return in_flight_ >= max_in_flight_ || super::congested();
+  }
+
+  bool done() const noexcept override {
+    return in_flight_ == 0;
+  }
+
+private:
+  // -- worker implementation --------------------------------------------------
+
+  static behavior worker(event_based_actor*, Process f) {
+    return {
+      [=](input_batch& xs) mutable -> output_batch {
+        unit_t st;
+        typename downstream<output_type>::queue_type buf;
+        downstream<output_type> out{buf};
+        trait::process::invoke(f, st, out, xs);
+        return {std::make_move_iterator(buf.begin()),
+                std::make_move_iterator(buf.end())};
+      }
+    };
+  }
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Sends `xs` to the next worker in round-robin order.
+  void dispatch(input_batch xs) {
+    auto self = this->out_.self();
+    auto& dest = workers_[next_worker_];
+    next_worker_ = (next_worker_ + 1) % workers_.size();
+    auto id = next_id_++;
+    ++in_flight_;
+    // Keeps the manager and thus this driver alive until the worker responds.
+    stream_manager_ptr mgr{this->out_.parent()};
+    auto req_id = self->new_request_id(message_priority::normal);
+    dest->eq_impl(req_id, self->ctrl(), self->context(), std::move(xs));
+    self->add_multiplexed_response_handler(
+      req_id.response_id(),
+      behavior{
+        [=](output_batch& ys) {
+          if (!stopped_)
+            deliver(mgr, id, ys);
+        },
+        [=](error& err) {
+          if (!stopped_) {
+            --in_flight_;
+            abort(mgr, std::move(err));
+          }
+        }
+      });
+  }
+
+  /// Pushes results of the chunk `id` downstream, respecting the input order
+  /// if necessary.
+  void deliver(const stream_manager_ptr& mgr, uint64_t id, output_batch& ys) {
+    --in_flight_;
+    auto& buf = this->out_.buf();
+    if (!ordered_) {
+      buf.insert(buf.end(), std::make_move_iterator(ys.begin()),
+                 std::make_move_iterator(ys.end()));
+    } else {
+      pending_.emplace(id, std::move(ys));
+      auto i = pending_.begin();
+      while (i != pending_.end() && i->first == next_emitted_id_) {
+        buf.insert(buf.end(), std::make_move_iterator(i->second.begin()),
+                   std::make_move_iterator(i->second.end()));
+        ++next_emitted_id_;
+        i = pending_.erase(i);
+      }
+    }
+    mgr->push();
+    // The stage may have received its final batch while waiting for results.
+    if (mgr->done()) {
+      auto self = this->out_.self();
+      self->erase_stream_manager(mgr);
+      mgr->stop();
+    }
+  }
+
+  /// Aborts the stream after a worker failed.
+  void abort(const stream_manager_ptr& mgr, error reason) {
+    auto self = this->out_.self();
+    self->erase_stream_manager(mgr);
+    mgr->stop(std::move(reason));
+  }
+
+  void stop_workers() {
+    for (auto& x : workers_)
+      anon_send_exit(x, exit_reason::user_shutdown);
+    workers_.clear();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Stores whether results must follow the order of the input.
+  bool ordered_;
+
+  /// Stores whether `finalize` was called.
+  bool stopped_;
+
+  /// Runs the `process` function.
+  std::vector<actor> workers_;
+
+  /// Position of the next worker for dispatching a chunk.
+  size_t next_worker_;
+
+  /// ID for the next dispatched chunk.
+  uint64_t next_id_;
+
+  /// ID of the next chunk for pushing downstream when preserving order.
+  uint64_t next_emitted_id_;
+
+  /// Number of dispatched chunks without response.
+  size_t in_flight_;
+
+  /// Maximum number of dispatched chunks without response.
+  size_t max_in_flight_;
+
+  /// Buffers results that arrived out of order.
+  std::map<uint64_t, output_batch> pending_;
+};
+
+} // namespace detail
+} // namespace caf
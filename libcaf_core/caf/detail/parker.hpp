@@ -0,0 +1,104 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "caf/config.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Puts a single thread to sleep until another thread calls `unpark` or a
+/// timeout occurs. Implements an event count: the sleeping thread announces
+/// its intent via `prepare_park`, re-checks its wakeup condition and then
+/// either calls `park` or `cancel_park`. Other threads first make the wakeup
+/// condition true and then call `unpark`, which only performs a system call if
+/// the thread actually sleeps. Uses a futex on Linux and a mutex plus
+/// condition variable on other platforms.
+class parker {
+public:
+  parker();
+
+  parker(const parker&) = delete;
+  parker& operator=(const parker&) = delete;
+
+  /// Announces that the calling thread is going to park. The caller must
+  /// re-check its wakeup condition afterwards.
+  /// @warning Must only be called by the owning thread.
+  void prepare_park() {
+    state_.store(parked, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /// Withdraws a previous call to `prepare_park`.
+  /// @warning Must only be called by the owning thread.
+  void cancel_park() {
+    state_.store(running, std::memory_order_relaxed);
+  }
+
+  /// Blocks the calling thread until a call to `unpark` or until `timeout`
+  /// passes. Returns `true` if another thread called `unpark`.
+  /// @pre `prepare_park` was called.
+  /// @warning Must only be called by the owning thread.
+  bool park(timespan timeout);
+
+  /// Wakes up the owning thread if it is parked or about to park. Returns
+  /// `true` if this call ended a parking attempt. Callers must make the wakeup
+  /// condition of the owning thread true *before* calling this function.
+  /// @note Safe to call from any thread.
+  bool unpark() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto expected = parked;
+    if (state_.load(std::memory_order_relaxed) != parked
+        || !state_.compare_exchange_strong(expected, notified,
+                                           std::memory_order_acq_rel))
+      return false;
+    wake();
+    return true;
+  }
+
+  /// Returns whether the owning thread is parked or about to park.
+  bool is_parked() const {
+    return state_.load(std::memory_order_relaxed) == parked;
+  }
+
+private:
+  static constexpr int running = 0;
+
+  static constexpr int parked = 1;
+
+  static constexpr int notified = 2;
+
+  void wake();
+
+  std::atomic<int> state_;
+
+#ifndef CAF_LINUX
+  std::mutex mtx_;
+  std::condition_variable cv_;
+#endif // CAF_LINUX
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace caf {
+namespace detail {
+
+/// Arranges the peers of a group in a spanning tree rooted at the origin of
+/// the group. The origin sends each message only to the roots, i.e., the first
+/// `fan_out` peers, and each peer relays messages to its own children. Peers
+/// form an implicit `fan_out`-ary tree based on their position: the children
+/// of the peer at position `i` occupy the positions `[(i + 1) * fan_out,
+/// (i + 2) * fan_out)`. A fan-out of 0 disables relaying, i.e., all peers are
+/// roots and the origin sends to each peer directly.
+template <class T>
+class relay_tree {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using list_type = std::vector<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit relay_tree(size_t fan_out = 0) : fan_out_(fan_out) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t fan_out() const noexcept {
+    return fan_out_;
+  }
+
+  const list_type& peers() const noexcept {
+    return peers_;
+  }
+
+  size_t size() const noexcept {
+    return peers_.size();
+  }
+
+  bool empty() const noexcept {
+    return peers_.empty();
+  }
+
+  /// Returns whether `x` is a peer.
+  bool contains(const T& x) const {
+    return std::find(peers_.begin(), peers_.end(), x) != peers_.end();
+  }
+
+  /// Returns the number of peers that receive messages directly from the
+  /// origin. The roots always occupy the first positions.
+  size_t num_roots() const noexcept {
+    if (fan_out_ == 0)
+      return peers_.size();
+    return std::min(fan_out_, peers_.size());
+  }
+
+  /// Calls `f(peer)` for each peer that receives messages directly from the
+  /// origin. Iterates the peers in place, since the origin calls this for
+  /// each message.
+  template <class F>
+  void for_each_root(F f) const {
+    auto n = num_roots();
+    for (size_t pos = 0; pos < n; ++pos)
+      f(peers_[pos]);
+  }
+
+  /// Returns the children of the peer at position `pos`.
+  list_type children(size_t pos) const {
+    if (fan_out_ == 0)
+      return {};
+    auto first = std::min((pos + 1) * fan_out_, peers_.size());
+    auto last = std::min(first + fan_out_, peers_.size());
+    return {peers_.begin() + static_cast<ptrdiff_t>(first),
+            peers_.begin() + static_cast<ptrdiff_t>(last)};
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Appends `x` to the tree unless `x` already is a peer.
+  /// @returns `true` if `x` was added, `false` otherwise.
+  bool add(T x) {
+    if (contains(x))
+      return false;
+    peers_.emplace_back(std::move(x));
+    synced_.emplace_back();
+    return true;
+  }
+
+  /// Removes `x` from the tree. Moves the last peer into the position of `x`
+  /// to keep the remaining tree as stable as possible.
+  /// @returns `true` if `x` was removed, `false` otherwise.
+  bool remove(const T& x) {
+    auto i = std::find(peers_.begin(), peers_.end(), x);
+    if (i == peers_.end())
+      return false;
+    auto pos = static_cast<size_t>(std::distance(peers_.begin(), i));
+    if (pos != peers_.size() - 1) {
+      using std::swap;
+      swap(peers_[pos], peers_.back());
+      swap(synced_[pos], synced_.back());
+    }
+    peers_.pop_back();
+    synced_.pop_back();
+    return true;
+  }
+
+  /// Removes all peers.
+  void clear() {
+    peers_.clear();
+    synced_.clear();
+  }
+
+  /// Calls `f(peer, children)` for each peer whose children changed since the
+  /// last call to `sync`.
+  template <class F>
+  void sync(F f) {
+    for (size_t pos = 0; pos < peers_.size(); ++pos) {
+      auto xs = children(pos);
+      if (xs != synced_[pos]) {
+        f(peers_[pos], xs);
+        synced_[pos] = std::move(xs);
+      }
+    }
+  }
+
+private:
+  /// Maximum number of children for the origin and each peer.
+  size_t fan_out_;
+
+  /// Stores all peers in tree order.
+  list_type peers_;
+
+  /// Stores the children of each peer as of the last call to `sync`.
+  std::vector<list_type> synced_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "caf/config.hpp"
+
+#include "caf/detail/shared_spinlock.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Splits a concurrent container into `NumShards` parts with a lock each.
+/// Users pick a shard by passing a hash of their key to `operator[]`, which
+/// uses the lower bits of the hash. Each shard ends with a cache line of
+/// padding to keep threads that work on neighboring shards from invalidating
+/// each other's cache lines.
+template <class T, size_t NumShards>
+class sharded {
+public:
+  // -- constants --------------------------------------------------------------
+
+  static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0,
+                "the number of shards must be a power of two");
+
+  static constexpr size_t num_shards = NumShards;
+
+  // -- member types -----------------------------------------------------------
+
+  struct shard {
+    mutable shared_spinlock mtx;
+    T data;
+    char pad[CAF_CACHE_LINE_SIZE];
+  };
+
+  using array_type = std::array<shard, NumShards>;
+
+  using iterator = typename array_type::iterator;
+
+  using const_iterator = typename array_type::const_iterator;
+
+  // -- static member functions ------------------------------------------------
+
+  /// Returns the position of the shard responsible for `hash`.
+  static constexpr size_t index_of(size_t hash) {
+    return hash & (NumShards - 1);
+  }
+
+  // -- element access ---------------------------------------------------------
+
+  shard& operator[](size_t hash) {
+    return shards_[index_of(hash)];
+  }
+
+  const shard& operator[](size_t hash) const {
+    return shards_[index_of(hash)];
+  }
+
+  // -- iterators --------------------------------------------------------------
+
+  iterator begin() {
+    return shards_.begin();
+  }
+
+  iterator end() {
+    return shards_.end();
+  }
+
+  const_iterator begin() const {
+    return shards_.begin();
+  }
+
+  const_iterator end() const {
+    return shards_.end();
+  }
+
+private:
+  array_type shards_;
+};
+
+template <class T, size_t NumShards>
+constexpr size_t sharded<T, NumShards>::num_shards;
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,181 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "caf/config.hpp"
+#include "caf/make_message.hpp"
+#include "caf/message.hpp"
+
+#include "caf/detail/batch_buffer_pool.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Caches stream elements for a single path without owning them. The buffer
+/// stores slices of immutable chunks, i.e., messages wrapping a
+/// `std::vector<T>`, that multiple paths share. Taking a slice that spans an
+/// entire chunk hands out the chunk itself instead of copying its elements.
+template <class T>
+class shared_chunk_buffer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Type of the elements in a chunk.
+  using chunk_type = std::vector<T>;
+
+  /// Positions of selected elements in a chunk.
+  using index_list = std::vector<uint32_t>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shared_chunk_buffer() : size_(0) {
+    // nop
+  }
+
+  // -- static utility functions -----------------------------------------------
+
+  /// Wraps `xs` into a reference-counted, immutable chunk.
+  static message make_chunk(chunk_type xs) {
+    return make_message(std::move(xs));
+  }
+
+  /// Returns the elements of `chunk`.
+  static const chunk_type& elements(const message& chunk) {
+    return chunk.get_as<chunk_type>(0);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of cached elements.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns whether this buffer contains no elements.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Appends all elements of `chunk`.
+  void push_back(message chunk) {
+    auto n = elements(chunk).size();
+    if (n == 0)
+      return;
+    slices_.emplace_back(std::move(chunk), index_list{}, n);
+    size_ += n;
+  }
+
+  /// Appends the elements of `chunk` at given positions.
+  /// @pre `indices` is sorted and all positions are valid
+  void push_back(message chunk, index_list indices) {
+    auto n = indices.size();
+    if (n == 0)
+      return;
+    if (n == elements(chunk).size()) {
+      push_back(std::move(chunk));
+      return;
+    }
+    slices_.emplace_back(std::move(chunk), std::move(indices), n);
+    size_ += n;
+  }
+
+  /// Removes the first `n` elements and returns them as a single chunk. Hands
+  /// out the stored chunk without copying if the first slice covers an entire
+  /// chunk of exactly `n` elements.
+  /// @pre `n <= size()`
+  message take(size_t n) {
+    CAF_ASSERT(n <= size_);
+    if (n == 0)
+      return make_chunk({});
+    auto& front = slices_.front();
+    if (front.first == 0 && front.last == n && front.indices.empty()
+        && elements(front.chunk).size() == n) {
+      auto result = std::move(front.chunk);
+      slices_.pop_front();
+      size_ -= n;
+      return result;
+    }
+    auto xs = batch_buffer_pool<T>::take();
+    xs.reserve(n);
+    size_ -= n;
+    while (n > 0) {
+      auto& slice = slices_.front();
+      auto& ys = elements(slice.chunk);
+      auto k = std::min(n, slice.last - slice.first);
+      if (slice.indices.empty()) {
+        auto first = ys.begin() + static_cast<ptrdiff_t>(slice.first);
+        xs.insert(xs.end(), first, first + static_cast<ptrdiff_t>(k));
+      } else {
+        for (auto i = slice.first; i != slice.first + k; ++i)
+          xs.emplace_back(ys[slice.indices[i]]);
+      }
+      slice.first += k;
+      n -= k;
+      if (slice.first == slice.last)
+        slices_.pop_front();
+    }
+    return make_chunk(std::move(xs));
+  }
+
+  /// Drops all elements.
+  void clear() {
+    slices_.clear();
+    size_ = 0;
+  }
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  /// Refers to the elements `[first, last)` of a chunk if `indices` is empty.
+  /// Otherwise, refers to the elements at the positions `[first, last)` in
+  /// `indices`.
+  struct slice {
+    slice(message x, index_list xs, size_t n)
+        : chunk(std::move(x)),
+          indices(std::move(xs)),
+          first(0),
+          last(n) {
+      // nop
+    }
+
+    message chunk;
+    index_list indices;
+    size_t first;
+    size_t last;
+  };
+
+  // -- member variables -------------------------------------------------------
+
+  /// Stores slices in order of arrival.
+  std::deque<slice> slices_;
+
+  /// Caches the sum of all slice sizes.
+  size_t size_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -116,6 +116,9 @@ public:
 
   void cancel_request_timeout(abstract_actor* self, message_id id) override;
 
+  void cancel_request_timeouts(abstract_actor* self,
+                               const std::vector<message_id>& ids) override;
+
   void cancel_timeouts(abstract_actor* self) override;
 
   void schedule_message(time_point t, strong_actor_ptr receiver,
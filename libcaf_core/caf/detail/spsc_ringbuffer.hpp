@@ -0,0 +1,95 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+// A lock-free ringbuffer for a single producer and a single consumer that can
+// hold a maximum of `Size` elements. The buffer allocates all slots upfront
+// and never blocks: appending to a full buffer fails.
+template <class T, size_t Size>
+class spsc_ringbuffer {
+public:
+  static_assert(Size > 0 && (Size & (Size - 1)) == 0,
+                "Size must be a power of two");
+
+  spsc_ringbuffer() : wr_pos_(0), rd_pos_(0) {
+    // nop
+  }
+
+  /// Tries to append `x` to the buffer and returns `false` if the buffer is
+  /// full. Must only get called by the producer.
+  bool try_push(T&& x) {
+    auto wp = wr_pos_.load(std::memory_order_relaxed);
+    if (wp - rd_pos_.load(std::memory_order_acquire) == Size)
+      return false;
+    buf_[wp & mask] = std::move(x);
+    wr_pos_.store(wp + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Calls `f` for each element in the buffer and returns the number of
+  /// consumed elements. Must only get called by the consumer.
+  template <class F>
+  size_t consume(F f) {
+    auto rp = rd_pos_.load(std::memory_order_relaxed);
+    auto wp = wr_pos_.load(std::memory_order_acquire);
+    for (auto i = rp; i != wp; ++i)
+      f(buf_[i & mask]);
+    rd_pos_.store(wp, std::memory_order_release);
+    return wp - rp;
+  }
+
+  bool empty() const noexcept {
+    return rd_pos_.load(std::memory_order_acquire)
+           == wr_pos_.load(std::memory_order_acquire);
+  }
+
+  size_t size() const noexcept {
+    // Read the position of the consumer first, because it never overtakes the
+    // position of the producer.
+    auto rp = rd_pos_.load(std::memory_order_acquire);
+    return wr_pos_.load(std::memory_order_acquire) - rp;
+  }
+
+private:
+  static constexpr size_t mask = Size - 1;
+
+  // Stores the number of elements the producer has written so far.
+  std::atomic<size_t> wr_pos_;
+
+  // Keeps read and write position on separate cache lines.
+  char pad_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+  // Stores the number of elements the consumer has read so far.
+  std::atomic<size_t> rd_pos_;
+
+  // Stores events in a circular ringbuffer.
+  std::array<T, Size> buf_;
+};
+
+} // namespace detail
+} // namespace caf
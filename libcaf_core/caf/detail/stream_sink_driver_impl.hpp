@@ -52,6 +52,10 @@ public:
     return trait::process::invoke(process_, state_, xs);
   }
 
+  void process_shared(const std::vector<input_type>& xs) override {
+    return trait::process::invoke(process_, state_, xs);
+  }
+
   void finalize(const error& err) override {
     stream_finalize_trait<Finalize, state_type>::invoke(fin_, state_, err);
   }
@@ -28,6 +28,8 @@
 
 #include "caf/policy/arg.hpp"
 
+#include "caf/detail/batch_buffer_pool.hpp"
+
 namespace caf {
 namespace detail {
 
@@ -54,7 +56,14 @@ public:
     CAF_LOG_TRACE(CAF_ARG(x));
     using vec_type = std::vector<input_type>;
     if (x.xs.match_elements<vec_type>()) {
-      driver_.process(x.xs.get_mutable_as<vec_type>(0));
+      // Detaching a batch that other receivers share would copy all elements.
+      if (x.xs.shared()) {
+        driver_.process_shared(x.xs.get_as<vec_type>(0));
+        return;
+      }
+      auto& xs = x.xs.get_mutable_as<vec_type>(0);
+      driver_.process(xs);
+      batch_buffer_pool<input_type>::recycle(std::move(xs));
       return;
     }
     CAF_LOG_ERROR("received unexpected batch type (dropped)");
@@ -62,6 +62,11 @@ public:
     trait::process::invoke(process_, state_, out, batch);
   }
 
+  void process_shared(downstream<output_type>& out,
+                      const std::vector<input_type>& batch) override {
+    trait::process::invoke(process_, state_, out, batch);
+  }
+
   void finalize(const error& err) override {
     stream_finalize_trait<Finalize, state_type>::invoke(fin_, state_, err);
   }
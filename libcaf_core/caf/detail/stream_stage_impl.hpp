@@ -27,6 +27,8 @@
 #include "caf/stream_stage.hpp"
 #include "caf/stream_stage_trait.hpp"
 
+#include "caf/detail/batch_buffer_pool.hpp"
+
 namespace caf {
 namespace detail {
 
@@ -64,7 +66,14 @@ public:
     using vec_type = std::vector<input_type>;
     if (x.xs.match_elements<vec_type>()) {
       downstream<output_type> ds{this->out_.buf()};
-      driver_.process(ds, x.xs.get_mutable_as<vec_type>(0));
+      // Detaching a batch that other receivers share would copy all elements.
+      if (x.xs.shared()) {
+        driver_.process_shared(ds, x.xs.get_as<vec_type>(0));
+        return;
+      }
+      auto& xs = x.xs.get_mutable_as<vec_type>(0);
+      driver_.process(ds, xs);
+      batch_buffer_pool<input_type>::recycle(std::move(xs));
       return;
     }
     CAF_LOG_ERROR("received unexpected batch type (dropped)");
@@ -78,6 +87,14 @@ public:
     return driver_.acquire_credit(path, desired);
   }
 
+  bool done() const override {
+    return super::done() && driver_.done();
+  }
+
+  bool idle() const noexcept override {
+    return super::idle() && driver_.done();
+  }
+
 protected:
   void finalize(const error& reason) override {
     driver_.finalize(reason);
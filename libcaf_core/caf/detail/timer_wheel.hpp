@@ -0,0 +1,184 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace caf {
+namespace detail {
+
+/// A hierarchical timing wheel with four levels of 256 slots each. The wheel
+/// measures time in abstract ticks and stores intrusive nodes, i.e., inserting
+/// and erasing a timer never allocates and runs in constant time. Timers that
+/// expire more than 2^32 ticks in the future wait in an overflow list.
+class timer_wheel {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using tick_type = uint64_t;
+
+  /// Base type for all timers in the wheel.
+  struct node {
+    node* prev = nullptr;
+    node* next = nullptr;
+    tick_type expiry = 0;
+
+    inline bool linked() const noexcept {
+      return next != nullptr;
+    }
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr size_t slot_bits = 8;
+
+  static constexpr size_t num_slots = size_t{1} << slot_bits;
+
+  static constexpr size_t num_levels = 4;
+
+  static constexpr tick_type infinite = std::numeric_limits<tick_type>::max();
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  timer_wheel();
+
+  timer_wheel(const timer_wheel&) = delete;
+
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the current tick of the wheel.
+  inline tick_type now() const noexcept {
+    return now_;
+  }
+
+  /// Returns the number of timers in the wheel.
+  inline size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns whether the wheel contains no timer.
+  inline bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the earliest tick at which `advance` has some work to do or
+  /// `infinite` if the wheel is empty. The result may be earlier than the
+  /// expiry of any timer, because moving timers from higher levels to lower
+  /// levels also requires `advance` to stop at the tick.
+  tick_type next_tick() const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Inserts `x` with expiry `t`. Timers with `t <= now()` expire on the next
+  /// call to `advance`.
+  void insert(node* x, tick_type t);
+
+  /// Removes `x` from the wheel.
+  void erase(node* x);
+
+  /// Advances the wheel to tick `t` and calls `f` for each expired timer.
+  /// Callbacks must not modify the wheel.
+  template <class F>
+  void advance(tick_type t, F f) {
+    fire(expired_, f);
+    while (now_ < t && size_ > 0) {
+      auto next = next_tick();
+      if (next > t)
+        break;
+      now_ = next;
+      // Move timers down from all levels that start a new round at this tick,
+      // starting with the overflow list.
+      if ((now_ & level_mask(num_levels)) == 0)
+        cascade(overflow_);
+      for (auto level = num_levels - 1; level > 0; --level)
+        if ((now_ & level_mask(level)) == 0)
+          cascade(slot(level, now_));
+      fire(slots_[0][now_ & (num_slots - 1)], f);
+      fire(expired_, f);
+    }
+    if (now_ < t)
+      now_ = t;
+  }
+
+  /// Removes all timers from the wheel, calling `f` for each one.
+  template <class F>
+  void clear(F f) {
+    for (auto& level : slots_)
+      for (auto& x : level)
+        fire(x, f);
+    fire(overflow_, f);
+    fire(expired_, f);
+  }
+
+private:
+  // -- utility functions ------------------------------------------------------
+
+  static constexpr tick_type level_mask(size_t level) {
+    return (tick_type{1} << (level * slot_bits)) - 1;
+  }
+
+  inline node& slot(size_t level, tick_type t) {
+    return slots_[level][(t >> (level * slot_bits)) & (num_slots - 1)];
+  }
+
+  static inline bool empty(const node& list) noexcept {
+    return list.next == &list;
+  }
+
+  static void push_back(node& list, node* x) noexcept;
+
+  static void unlink(node* x) noexcept;
+
+  /// Re-inserts all timers from `list` relative to the current tick.
+  void cascade(node& list);
+
+  template <class F>
+  void fire(node& list, F& f) {
+    while (!empty(list)) {
+      auto x = list.next;
+      unlink(x);
+      --size_;
+      f(x);
+    }
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Current position of the wheel.
+  tick_type now_;
+
+  /// Number of timers in the wheel.
+  size_t size_;
+
+  /// Sentinels for the circular lists of all slots.
+  node slots_[num_levels][num_slots];
+
+  /// Sentinel for timers that are too far in the future for the wheel.
+  node overflow_;
+
+  /// Sentinel for timers that expire on the next call to `advance`.
+  node expired_;
+};
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,235 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "caf/actor_clock.hpp"
+#include "caf/detail/simple_actor_clock.hpp"
+#include "caf/detail/timer_wheel.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A thread-safe clock based on a hierarchical timing wheel with a resolution
+/// of one millisecond. Callers never touch the wheel directly. Instead, they
+/// append commands to one of several insertion buffers, each with its own
+/// lock. The dispatch loop drains all buffers before advancing the wheel.
+/// Since the clock selects the buffer based on the actor, commands for the
+/// same actor always arrive in order. Timeouts never fire early but may fire
+/// up to one tick late.
+class timer_wheel_actor_clock : public actor_clock {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = simple_actor_clock::value_type;
+
+  /// Resolution of the wheel.
+  using tick_duration = std::chrono::milliseconds;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of insertion buffers.
+  static constexpr size_t num_stripes = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  timer_wheel_actor_clock();
+
+  ~timer_wheel_actor_clock() override;
+
+  // -- overridden member functions --------------------------------------------
+
+  void set_ordinary_timeout(time_point t, abstract_actor* self,
+                            atom_value type, uint64_t id) override;
+
+  void set_multi_timeout(time_point t, abstract_actor* self,
+                         atom_value type, uint64_t id) override;
+
+  void set_request_timeout(time_point t, abstract_actor* self,
+                           message_id id) override;
+
+  void cancel_ordinary_timeout(abstract_actor* self, atom_value type) override;
+
+  void cancel_request_timeout(abstract_actor* self, message_id id) override;
+
+  void cancel_request_timeouts(abstract_actor* self,
+                               const std::vector<message_id>& ids) override;
+
+  void cancel_timeouts(abstract_actor* self) override;
+
+  void schedule_message(time_point t, strong_actor_ptr receiver,
+                        mailbox_element_ptr content) override;
+
+  void schedule_message(time_point t, group target, strong_actor_ptr sender,
+                        message content) override;
+
+  void cancel_all() override;
+
+  // -- dispatching ------------------------------------------------------------
+
+  void run_dispatch_loop();
+
+  void cancel_dispatch_loop();
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  /// Identifies cancelable timeouts.
+  struct key_type {
+    abstract_actor* self;
+    uint64_t value;
+    bool request;
+
+    inline bool operator==(const key_type& other) const noexcept {
+      return self == other.self && value == other.value
+             && request == other.request;
+    }
+  };
+
+  struct key_hash {
+    size_t operator()(const key_type& x) const noexcept;
+  };
+
+  /// Timer in the wheel.
+  struct entry : timer_wheel::node {
+    /// Owner of the timeout or `nullptr` for scheduled messages.
+    abstract_actor* self = nullptr;
+
+    /// Neighbors in the list of all timeouts for `self`.
+    entry* prev_of_self = nullptr;
+    entry* next_of_self = nullptr;
+
+    /// Stores whether `key` identifies this entry.
+    bool keyed = false;
+
+    key_type key;
+
+    time_point due;
+
+    value_type value;
+
+    template <class T>
+    entry(time_point t, T&& x) : due(t), value(std::forward<T>(x)) {
+      // nop
+    }
+  };
+
+  using entry_ptr = std::unique_ptr<entry>;
+
+  enum command_type {
+    add_entry,
+    cancel_key,
+    cancel_self,
+  };
+
+  struct command {
+    command_type type;
+    key_type key;
+    entry_ptr ptr;
+  };
+
+  /// Insertion buffer with its own lock.
+  struct stripe {
+    std::mutex mtx;
+    std::vector<command> buf;
+    char pad[CAF_CACHE_LINE_SIZE];
+  };
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Returns the tick for dispatching timers that are due at `t`.
+  timer_wheel::tick_type to_tick(time_point t) const noexcept;
+
+  stripe& stripe_of(const void* ptr) noexcept;
+
+  /// Appends a command to the insertion buffer for `ptr` and wakes up the
+  /// dispatch loop if `t` is earlier than its next scheduled wakeup.
+  void push(const void* ptr, command x, time_point t);
+
+  void set_timeout(time_point t, abstract_actor* self, value_type x,
+                   bool keyed, key_type key);
+
+  void schedule(const void* ptr, time_point t, value_type x);
+
+  /// Moves all commands from the insertion buffers to the wheel.
+  void drain();
+
+  void apply(command& x);
+
+  /// Removes `ptr` from the lookup tables but leaves the wheel unchanged.
+  void forget(entry* ptr);
+
+  /// Removes `ptr` from the wheel and the lookup tables and destroys it.
+  void erase(entry* ptr);
+
+  void erase_all();
+
+  // -- member variables -------------------------------------------------------
+
+  /// Corresponds to tick 0 of the wheel.
+  time_point origin_;
+
+  /// Insertion buffers for producers.
+  std::array<stripe, num_stripes> stripes_;
+
+  /// Signals the dispatch loop to drop all timers before draining buffers.
+  /// Only accessed while holding the locks of all stripes.
+  bool clear_;
+
+  /// Stores whether the dispatch loop stopped.
+  std::atomic<bool> done_;
+
+  /// Next wakeup of the dispatch loop as time since epoch. Holds the maximum
+  /// value while the loop is running.
+  std::atomic<time_point::rep> wakeup_;
+
+  /// Protects `pending_`.
+  std::mutex mtx_;
+
+  /// Signals the dispatch loop.
+  std::condition_variable cv_;
+
+  /// Stores whether new commands may require an earlier wakeup.
+  bool pending_;
+
+  // -- state of the dispatch loop ---------------------------------------------
+
+  timer_wheel wheel_;
+
+  /// Scratch space for draining the insertion buffers.
+  std::vector<command> commands_;
+
+  /// Cancelable timeouts.
+  std::unordered_map<key_type, entry*, key_hash> keyed_;
+
+  /// Heads of the lists of all timeouts per actor.
+  std::unordered_map<abstract_actor*, entry*> by_self_;
+};
+
+} // namespace detail
+} // namespace caf
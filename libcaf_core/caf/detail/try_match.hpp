@@ -76,6 +76,18 @@ struct meta_elements<type_list<Ts...>> {
 bool try_match(const type_erased_tuple& xs, const meta_element* iter,
                size_t ps);
 
+/// Evaluates to the atom constant at the first position of a pattern or to 0
+/// if the pattern does not start with an atom constant.
+template <class TypeList>
+struct leading_atom_constant {
+  static constexpr atom_value value = static_cast<atom_value>(0);
+};
+
+template <atom_value V, class... Ts>
+struct leading_atom_constant<type_list<atom_constant<V>, Ts...>> {
+  static constexpr atom_value value = V;
+};
+
 } // namespace detail
 } // namespace caf
 
@@ -30,6 +30,7 @@
 
 #include "caf/detail/type_list.hpp"
 #include "caf/detail/safe_equal.hpp"
+#include "caf/detail/memory_pool.hpp"
 #include "caf/detail/message_data.hpp"
 #include "caf/detail/try_serialize.hpp"
 #include "caf/detail/stringification_inspector.hpp"
@@ -208,6 +209,16 @@ public:
   tuple_vals* copy() const override {
     return new tuple_vals(*this);
   }
+
+#ifdef CAF_ENABLE_MEMORY_POOL
+  static void* operator new(size_t size) {
+    return memory_pool::allocate_for<tuple_vals>(size);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    memory_pool::deallocate_for<tuple_vals>(ptr);
+  }
+#endif // CAF_ENABLE_MEMORY_POOL
 };
 
 } // namespace detail
@@ -251,6 +251,22 @@ struct is_byte_sequence<std::vector<unsigned char>> : std::true_type { };
 template <>
 struct is_byte_sequence<std::string> : std::true_type { };
 
+/// Checks whether T is a contiguous sequence of integers or floating point
+/// numbers (excluding byte sequences) that allows bulk processing.
+template <class T>
+struct is_arithmetic_sequence : std::false_type { };
+
+template <class T>
+struct is_arithmetic_sequence<std::vector<T>> {
+  static constexpr bool value =
+    ((std::is_integral<T>::value && !std::is_same<T, bool>::value)
+     || std::is_same<T, float>::value || std::is_same<T, double>::value)
+    && !is_byte_sequence<std::vector<T>>::value;
+};
+
+template <class T>
+constexpr bool is_arithmetic_sequence<std::vector<T>>::value;
+
 /// Checks whether `T` provides either a free function or a member function for
 /// serialization. The checks test whether both serialization and
 /// deserialization can succeed. The meta function tests the following
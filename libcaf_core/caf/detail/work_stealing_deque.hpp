@@ -0,0 +1,234 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "caf/config.hpp"
+#include "caf/detail/bounded_mpmc_queue.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A lock-free work-stealing deque based on the Chase-Lev algorithm in the
+/// formulation for weak memory models by Lê et al. ("Correct and Efficient
+/// Work-Stealing for Weak Memory Models", PPoPP'13).
+///
+/// The deque offers the same interface as `double_ended_queue` in order to
+/// serve as drop-in replacement for the job queue of the `work_stealing`
+/// policy, but has different concurrency guarantees:
+/// - `prepend` and `take_head` are restricted to the owning worker, which
+///   pushes and pops at the bottom of a growable circular array.
+/// - `take_tail` is safe to call from any thread (thieves steal the oldest
+///   element at the top of the array).
+/// - `append` is safe to call from any thread and places elements into a
+///   bounded MPMC ring buffer that the owner as well as thieves drain once the
+///   circular array runs empty.
+///
+/// None of these operations allocate in the steady state. The circular array
+/// grows by doubling its capacity and the ring buffer only falls back to a
+/// (locking) `double_ended_queue` when overflowing.
+template <class T>
+class work_stealing_deque {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type*;
+
+  static constexpr size_type default_capacity = 256;
+
+  static constexpr size_type default_inbox_capacity = 1024;
+
+  explicit work_stealing_deque(size_type capacity = default_capacity,
+                               size_type inbox_capacity
+                               = default_inbox_capacity)
+      : inbox_(inbox_capacity) {
+    size_type n = 2;
+    while (n < capacity)
+      n <<= 1;
+    auto ptr = new array(n);
+    retired_.emplace_back(ptr);
+    array_.store(ptr, std::memory_order_relaxed);
+    top_.store(0, std::memory_order_relaxed);
+    bottom_.store(0, std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  // -- owner interface --------------------------------------------------------
+
+  /// Pushes `value` to the bottom of the deque.
+  /// @warning Must only be called by the owner.
+  void prepend(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto a = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<index_type>(a->capacity) - 1)
+      a = grow(a, t, b);
+    a->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Pops the most recently pushed element from the bottom of the deque or
+  /// falls back to the inbox if the deque is empty. Returns `nullptr` if both
+  /// are empty.
+  /// @warning Must only be called by the owner.
+  pointer take_head() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    pointer result = nullptr;
+    if (t <= b) {
+      result = a->get(b);
+      if (t == b) {
+        // Last element: race against thieves.
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+          result = nullptr;
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result != nullptr ? result : take_from_inbox();
+  }
+
+  // -- concurrent interface ---------------------------------------------------
+
+  /// Enqueues `value` to the inbox of the deque.
+  /// @note Safe to call from any thread.
+  void append(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    if (!inbox_.push(value))
+      overflow_.append(value);
+  }
+
+  /// Steals the oldest element from the top of the deque or falls back to the
+  /// inbox if the deque is empty. Returns `nullptr` on failure, i.e., if the
+  /// deque is empty or if the thief lost a race with another thread.
+  /// @note Safe to call from any thread.
+  pointer take_tail() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t < b) {
+      auto a = array_.load(std::memory_order_acquire);
+      auto result = a->get(t);
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        return nullptr;
+      return result;
+    }
+    return take_from_inbox();
+  }
+
+  /// Returns whether the deque appears to be empty. The result is only a
+  /// snapshot when accessed concurrently.
+  bool empty() const {
+    auto b = bottom_.load(std::memory_order_acquire);
+    auto t = top_.load(std::memory_order_acquire);
+    return b <= t && inbox_.empty() && overflow_.empty();
+  }
+
+private:
+  using index_type = int64_t;
+
+  // A circular array of atomic pointers.
+  struct array {
+    explicit array(size_type n) : capacity(n), mask(n - 1), buf(new slot[n]) {
+      CAF_ASSERT((n & mask) == 0);
+    }
+
+    using slot = std::atomic<pointer>;
+
+    pointer get(index_type i) const {
+      return buf[static_cast<size_type>(i) & mask].load(
+        std::memory_order_relaxed);
+    }
+
+    void put(index_type i, pointer x) {
+      buf[static_cast<size_type>(i) & mask].store(x,
+                                                  std::memory_order_relaxed);
+    }
+
+    size_type capacity;
+    size_type mask;
+    std::unique_ptr<slot[]> buf;
+  };
+
+  // Replaces the current array with an array of twice its size. Thieves may
+  // still read from the old array, hence we retire it instead of deleting it.
+  array* grow(array* a, index_type t, index_type b) {
+    auto ptr = new array(a->capacity * 2);
+    retired_.emplace_back(ptr);
+    for (auto i = t; i != b; ++i)
+      ptr->put(i, a->get(i));
+    array_.store(ptr, std::memory_order_release);
+    return ptr;
+  }
+
+  pointer take_from_inbox() {
+    auto result = inbox_.pop();
+    if (result == nullptr && !overflow_.empty())
+      result = overflow_.take_head();
+    return result;
+  }
+
+  // Bottom index, written only by the owner.
+  std::atomic<index_type> bottom_;
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+
+  // Top index, incremented by the owner and thieves via CAS.
+  std::atomic<index_type> top_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+
+  // Current circular array.
+  std::atomic<array*> array_;
+
+  // Owns all arrays ever allocated by this deque, including the current one.
+  std::vector<std::unique_ptr<array>> retired_;
+
+  // Receives jobs from other threads.
+  bounded_mpmc_queue<T> inbox_;
+
+  // Receives jobs from other threads when `inbox_` is full.
+  double_ended_queue<T> overflow_;
+};
+
+template <class T>
+constexpr typename work_stealing_deque<T>::size_type
+  work_stealing_deque<T>::default_capacity;
+
+template <class T>
+constexpr typename work_stealing_deque<T>::size_type
+  work_stealing_deque<T>::default_inbox_capacity;
+
+} // namespace detail
+} // namespace caf
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "caf/fwd.hpp"
 
 #include "caf/config.hpp"
@@ -40,6 +42,12 @@ public:
   ///          executed by this execution unit.
   virtual void exec_later(resumable* ptr) = 0;
 
+  /// Enqueues all `ptrs` to the job list of the execution unit. The default
+  /// implementation calls `exec_later` for each resumable.
+  /// @warning Must only be called from a {@link resumable} currently
+  ///          executed by this execution unit.
+  virtual void exec_later_all(const std::vector<resumable*>& ptrs);
+
   /// Returns the enclosing actor system.
   /// @warning Must be set before the execution unit calls `resume` on an actor.
   actor_system& system() const {
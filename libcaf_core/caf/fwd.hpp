@@ -247,6 +247,7 @@ namespace detail {
 template <class> class type_erased_value_impl;
 template <class> class stream_distribution_tree;
 
+class binary_log_writer;
 class disposer;
 class dynamic_message_data;
 class group_manager;
@@ -23,6 +23,7 @@
 
 #include "caf/actor_clock.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/credit_controller.hpp"
 #include "caf/downstream_msg.hpp"
 #include "caf/meta/type_name.hpp"
 #include "caf/rtti_pair.hpp"
@@ -108,10 +109,6 @@ public:
     void reset();
   };
 
-  /// Summarizes how many elements we processed during the last cycle and how
-  /// much time we spent processing those elements.
-  stats_t stats;
-
   /// Stores the time point of the last credit decision for this source.
   actor_clock::time_point last_credit_decision;
 
@@ -138,9 +135,9 @@ public:
   /// Emits an `upstream_msg::ack_batch`.
   void emit_ack_open(local_actor* self, actor_addr rebind_from);
 
-  /// Sends an `upstream_msg::ack_batch` for granting new credit. Credit is
-  /// calculated from sampled batch durations, the cycle duration and the
-  /// desired batch complexity.
+  /// Sends an `upstream_msg::ack_batch` for granting new credit. The credit
+  /// controller of this path computes credit from the cycle duration, the
+  /// desired batch complexity and the number of queued items.
   /// @param self Points to the parent actor, i.e., sender of the message.
   /// @param queued_items Accumulated size of all batches that are currently
   ///                     waiting in the mailbox.
@@ -166,8 +163,16 @@ public:
                                       const strong_actor_ptr& hdl,
                                       error reason);
 
+  /// Returns the credit controller of this path.
+  credit_controller& controller() noexcept {
+    return *controller_;
+  }
+
 private:
   actor_clock& clock();
+
+  /// Computes credit for the source.
+  credit_controller_ptr controller_;
 };
 
 /// @relates inbound_path
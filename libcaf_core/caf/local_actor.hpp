@@ -90,7 +90,7 @@ public:
 
   /// Requests a new timeout for `mid`.
   /// @pre `mid.is_request()`
-  void request_response_timeout(const duration& d, message_id mid);
+  virtual void request_response_timeout(const duration& d, message_id mid);
 
   // -- spawn functions --------------------------------------------------------
 
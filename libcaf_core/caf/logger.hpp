@@ -18,8 +18,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <fstream>
+#include <cstdint>
 #include <cstring>
 #include <sstream>
 #include <iostream>
@@ -34,7 +39,7 @@
 #include "caf/detail/arg_wrapper.hpp"
 #include "caf/detail/log_level.hpp"
 #include "caf/detail/pretty_type_name.hpp"
-#include "caf/detail/ringbuffer.hpp"
+#include "caf/detail/spsc_ringbuffer.hpp"
 #include "caf/detail/scope_guard.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 #include "caf/fwd.hpp"
@@ -73,8 +78,9 @@ public:
 
   // -- constants --------------------------------------------------------------
 
-  /// Configures the size of the circular event queue.
-  static constexpr size_t queue_size = 128;
+  /// Configures the capacity of the per-thread event buffers. The logger
+  /// drops events if a thread fills up its buffer.
+  static constexpr size_t queue_size = 1024;
 
   // -- member types -----------------------------------------------------------
 
@@ -97,6 +103,10 @@ public:
     /// Configures whether the logger generates colored output.
     bool console_coloring : 1;
 
+    /// Configures whether the logger writes the compact binary format of
+    /// `detail::binary_log_writer` to its file instead of formatted text.
+    bool binary_file : 1;
+
     config();
   };
 
@@ -138,7 +148,7 @@ public:
     /// Name of the current file.
     string_view file_name;
 
-    /// User-provided message.
+    /// User-provided message, usually encoded by `line_builder`.
     std::string message;
 
     /// Thread ID of the caller.
@@ -180,16 +190,51 @@ public:
   using line_format = std::vector<field>;
 
   /// Utility class for building user-defined log messages with `CAF_ARG`.
+  /// The builder stores arithmetic values, strings, and atoms in a binary
+  /// encoding and leaves rendering them to the logger thread (or to
+  /// `caf-binlog` when writing binary logs). Values of any other type get
+  /// rendered immediately. Use `logger::render_message` to convert the
+  /// result of `get` to text.
   class line_builder {
   public:
+    /// Tags the elements of an encoded message.
+    enum element_type : uint8_t {
+      /// Plain text, separated from previous output with a space unless the
+      /// previous output ends with a space.
+      text_element = 1,
+      /// A single value, separated from previous output with a space.
+      value_element,
+      /// A value with a name, rendered as `name = value`.
+      arg_element,
+    };
+
+    /// Tags the type of encoded values.
+    enum value_type : uint8_t {
+      bool_type = 1,
+      int_type,
+      uint_type,
+      double_type,
+      string_type,
+      atom_type,
+      /// A value that was rendered by the caller.
+      text_type,
+    };
+
     line_builder();
 
     template <class T>
     detail::enable_if_t<!std::is_pointer<T>::value, line_builder&>
     operator<<(const T& x) {
-      if (!str_.empty())
-        str_ += " ";
-      str_ += deep_to_string(x);
+      put(value_element);
+      put_value(x);
+      return *this;
+    }
+
+    template <class T>
+    line_builder& operator<<(const detail::single_arg_wrapper<T>& x) {
+      put(arg_element);
+      put_text(x.name);
+      put_value(x.value);
       return *this;
     }
 
@@ -203,9 +248,71 @@ public:
 
     line_builder& operator<<(char x);
 
-    std::string get() const;
+    /// Returns the encoded message and leaves the builder in a valid but
+    /// unspecified state.
+    std::string get();
 
   private:
+    template <class T>
+    struct is_deferred {
+      static constexpr bool value = (std::is_arithmetic<T>::value
+                                     && !std::is_same<T, long double>::value)
+                                    || std::is_same<T, std::string>::value
+                                    || std::is_same<T, atom_value>::value;
+    };
+
+    template <class T>
+    void put(T x) {
+      auto first = reinterpret_cast<const char*>(&x);
+      str_.append(first, sizeof(T));
+    }
+
+    void put_text(string_view x);
+
+    void put_value(bool x) {
+      put(bool_type);
+      put(static_cast<uint8_t>(x));
+    }
+
+    template <class T>
+    detail::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>
+    put_value(T x) {
+      put(int_type);
+      put(static_cast<int64_t>(x));
+    }
+
+    template <class T>
+    detail::enable_if_t<std::is_integral<T>::value
+                        && !std::is_signed<T>::value>
+    put_value(T x) {
+      put(uint_type);
+      put(static_cast<uint64_t>(x));
+    }
+
+    template <class T>
+    detail::enable_if_t<std::is_floating_point<T>::value
+                        && is_deferred<T>::value>
+    put_value(T x) {
+      put(double_type);
+      put(static_cast<double>(x));
+    }
+
+    void put_value(const std::string& x) {
+      put(string_type);
+      put_text(x);
+    }
+
+    void put_value(atom_value x) {
+      put(atom_type);
+      put(static_cast<uint64_t>(x));
+    }
+
+    template <class T>
+    detail::enable_if_t<!is_deferred<T>::value> put_value(const T& x) {
+      put(text_type);
+      put_text(deep_to_string(x));
+    }
+
     std::string str_;
   };
 
@@ -215,7 +322,8 @@ public:
 
   // -- logging ----------------------------------------------------------------
 
-  /// Writes an entry to the event-queue of the logger.
+  /// Writes an entry to the event buffer of the calling thread. Drops the
+  /// event if the buffer is full.
   /// @thread-safe
   void log(event&& x);
 
@@ -253,6 +361,15 @@ public:
     return cfg_.console_verbosity;
   }
 
+  /// Returns the number of events the logger has written so far.
+  size_t emitted_events() const noexcept {
+    return emitted_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the number of events the logger dropped because the buffer of
+  /// the logging thread was full.
+  size_t dropped_events() const;
+
   // -- static utility functions -----------------------------------------------
 
   /// Renders the prefix (namespace and class) of a fully qualified function.
@@ -274,11 +391,22 @@ public:
   /// Skips path in `filename`.
   static string_view skip_path(string_view filename);
 
+  /// Renders a message encoded by `line_builder`. Returns `x` unmodified if
+  /// it is not a valid encoding, e.g., for events with plain text messages.
+  static std::string render_message(string_view x);
+
   // -- utility functions ------------------------------------------------------
 
   /// Renders `x` using the line format `lf` to `out`.
   void render(std::ostream& out, const line_format& lf, const event& x) const;
 
+  /// Renders `x` using the line format `lf` to `out`, computing the runtime
+  /// relative to `t0` and printing `thread_name` instead of `x.tid`. Allows
+  /// tools to format events offline, e.g., after reading a binary log.
+  static void render_offline(std::ostream& out, const line_format& lf,
+                             const event& x, timestamp t0,
+                             string_view thread_name);
+
   /// Returns a string representation of the joined groups of `x` if `x` is an
   /// actor with the `subscriber` mixin.
   template <class T>
@@ -312,6 +440,24 @@ public:
   static logger* current_logger();
 
 private:
+  // -- member types -----------------------------------------------------------
+
+  /// Buffers events of a single thread.
+  struct event_buffer {
+    /// Identifies the producer.
+    std::thread::id owner;
+
+    /// Counts events that did not fit into `events`.
+    std::atomic<size_t> dropped;
+
+    /// Stores events until the logger thread picks them up.
+    detail::spsc_ringbuffer<event, queue_size> events;
+
+    explicit event_buffer(std::thread::id tid) : owner(tid), dropped(0) {
+      // nop
+    }
+  };
+
   // -- constructors, destructors, and assignment operators --------------------
 
   logger(actor_system& sys);
@@ -334,6 +480,18 @@ private:
 
   // -- thread management ------------------------------------------------------
 
+  /// Returns the buffer of the calling thread.
+  event_buffer& local_buffer();
+
+  /// Returns the buffer of the calling thread, creating it if needed.
+  event_buffer& find_or_create_buffer();
+
+  /// Moves all buffered events to `out`.
+  void collect(std::vector<event>& out);
+
+  /// Returns whether all buffers are empty.
+  bool all_empty() const;
+
   void run();
 
   void start();
@@ -372,8 +530,32 @@ private:
   // Stream for file output.
   std::fstream file_;
 
-  // Filled with log events by other threads.
-  detail::ringbuffer<event, queue_size> queue_;
+  // Encodes events for `file_` if the logger writes binary output.
+  std::unique_ptr<detail::binary_log_writer> binary_file_;
+
+  // Uniquely identifies this logger for caching thread-local buffers.
+  uint64_t instance_id_;
+
+  // Guards `buffers_`.
+  mutable std::mutex buffers_mtx_;
+
+  // Filled with log events by other threads, one buffer per thread.
+  std::vector<std::unique_ptr<event_buffer>> buffers_;
+
+  // Counts all events written by the logger.
+  std::atomic<size_t> emitted_;
+
+  // Signals the logger thread that it should shutdown.
+  bool done_;
+
+  // Stores whether the logger thread waits for new events.
+  std::atomic<bool> sleeping_;
+
+  // Guards `done_` and allows the logger thread to wait for new events.
+  std::mutex wakeup_mtx_;
+
+  // Wakes up the logger thread.
+  std::condition_variable wakeup_cv_;
 
   // Executes `logger::run`.
   std::thread thread_;
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
 
 #include "caf/extend.hpp"
 #include "caf/message.hpp"
@@ -36,6 +37,7 @@
 #include "caf/meta/omittable_if_empty.hpp"
 
 #include "caf/detail/disposer.hpp"
+#include "caf/detail/memory_pool.hpp"
 #include "caf/detail/tuple_vals.hpp"
 #include "caf/detail/type_erased_tuple_view.hpp"
 
@@ -68,6 +70,16 @@ public:
     return mid.category() == message_id::urgent_message_category;
   }
 
+#ifdef CAF_ENABLE_MEMORY_POOL
+  static void* operator new(size_t size) {
+    return detail::memory_pool::allocate(size);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    detail::memory_pool::deallocate(ptr);
+  }
+#endif // CAF_ENABLE_MEMORY_POOL
+
   mailbox_element(mailbox_element&&) = delete;
   mailbox_element(const mailbox_element&) = delete;
   mailbox_element& operator=(mailbox_element&&) = delete;
@@ -144,6 +156,18 @@ public:
   void dispose() noexcept {
     this->deref();
   }
+
+#ifdef CAF_ENABLE_MEMORY_POOL
+  // Overrides the allocation functions of `mailbox_element`, because the
+  // content may require a stricter alignment than the pool provides.
+  static void* operator new(size_t size) {
+    return detail::memory_pool::allocate_for<mailbox_element_vals>(size);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    detail::memory_pool::deallocate_for<mailbox_element_vals>(ptr);
+  }
+#endif // CAF_ENABLE_MEMORY_POOL
 };
 
 /// Provides a view for treating arbitrary data as message element.
@@ -190,6 +214,13 @@ mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, message msg);
 
+/// Creates `n` mailbox elements that share `sender`, `id`, and `msg`. Draws
+/// the memory for all elements from the pool at once.
+/// @relates mailbox_element
+std::vector<mailbox_element_ptr>
+make_mailbox_elements(size_t n, const strong_actor_ptr& sender, message_id id,
+                      const message& msg);
+
 /// @relates mailbox_element
 template <class T, class... Ts>
 typename std::enable_if<
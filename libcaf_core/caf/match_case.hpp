@@ -21,6 +21,7 @@
 #include <tuple>
 #include <type_traits>
 
+#include "caf/atom.hpp"
 #include "caf/none.hpp"
 #include "caf/param.hpp"
 #include "caf/optional.hpp"
@@ -45,8 +46,15 @@ public:
     skip
   };
 
+  /// Denotes match cases that accept any first element.
+  static constexpr atom_value no_leading_atom = static_cast<atom_value>(0);
+
   match_case(uint32_t tt);
 
+  /// Constructs a match case for messages with type token `tt` that start
+  /// with the atom constant `leading_atom`.
+  match_case(uint32_t tt, atom_value leading_atom);
+
   match_case(match_case&&) = default;
   match_case(const match_case&) = default;
 
@@ -60,8 +68,15 @@ public:
     return token_;
   }
 
+  /// Returns the atom constant this match case expects as first element or
+  /// `no_leading_atom` if it accepts any first element.
+  inline atom_value leading_atom() const {
+    return leading_atom_;
+  }
+
 private:
   uint32_t token_;
+  atom_value leading_atom_;
 };
 
 template <bool IsVoid, class F>
@@ -143,7 +158,8 @@ public:
   trivial_match_case& operator=(const trivial_match_case&) = default;
 
   trivial_match_case(F f)
-      : match_case(make_type_token_from_list<pattern>()),
+      : match_case(make_type_token_from_list<pattern>(),
+                   detail::leading_atom_constant<pattern>::value),
         fun_(std::move(f)) {
     // nop
   }
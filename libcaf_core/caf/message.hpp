@@ -102,6 +102,19 @@ public:
 
   error save(serializer& sink) const override;
 
+  // -- compact serialization --------------------------------------------------
+
+  /// Serializes this message with the local type IDs of its elements instead
+  /// of their portable names. Only receivers that know the type IDs of this
+  /// node are able to read the result.
+  /// @experimental
+  error save_compact(serializer& sink) const;
+
+  /// Deserializes a message written by `save_compact` on another node, whereas
+  /// `ids[x]` denotes the local type ID for the remote type ID `x`.
+  /// @experimental
+  error load_compact(deserializer& source, const std::vector<uint16_t>& ids);
+
   // -- factories --------------------------------------------------------------
 
   /// Creates a new message by concatenating `xs...`.
@@ -31,6 +31,8 @@
 #include "caf/stream_slot.hpp"
 #include "caf/system_messages.hpp"
 
+#include "caf/detail/batch_buffer_pool.hpp"
+#include "caf/detail/shared_chunk_buffer.hpp"
 #include "caf/detail/type_traits.hpp"
 
 #include "caf/meta/type_name.hpp"
@@ -80,17 +82,19 @@ public:
     CAF_LOG_TRACE(CAF_ARG(force_underfull));
     CAF_ASSERT(desired_batch_size > 0);
     using type = detail::decay_t<decltype(*i)>;
-    // Ship full batches.
+    using pool = detail::batch_buffer_pool<type>;
+    // Ship full batches, reusing storage of batches processed on this thread.
     while (std::distance(i, e) >= desired_batch_size) {
-      std::vector<type> tmp{std::make_move_iterator(i),
-                            std::make_move_iterator(i + desired_batch_size)};
+      auto tmp = pool::take();
+      tmp.assign(std::make_move_iterator(i),
+                 std::make_move_iterator(i + desired_batch_size));
       emit_batch(self, desired_batch_size, make_message(std::move(tmp)));
       i += desired_batch_size;
     }
     // Ship underful batch only if `force_underful` is set.
     if (i != e && force_underfull) {
-      std::vector<type> tmp{std::make_move_iterator(i),
-                            std::make_move_iterator(e)};
+      auto tmp = pool::take();
+      tmp.assign(std::make_move_iterator(i), std::make_move_iterator(e));
       auto tmp_size = static_cast<int32_t>(tmp.size());
       emit_batch(self, tmp_size, make_message(std::move(tmp)));
       return e;
@@ -123,6 +127,30 @@ public:
     }
   }
 
+  /// Calls `emit_batch` for each chunk in the cache, whereas each chunk is of
+  /// size `desired_batch_size`. Does nothing for pending paths. Ships chunks
+  /// from `cache` without copying if they align with batch boundaries.
+  template <class T>
+  void emit_batches(local_actor* self, detail::shared_chunk_buffer<T>& cache,
+                    bool force_underfull) {
+    CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(open_credit)
+                  << CAF_ARG2("cached", cache.size())
+                  << CAF_ARG(force_underfull));
+    if (pending())
+      return;
+    CAF_ASSERT(open_credit >= 0);
+    CAF_ASSERT(desired_batch_size > 0);
+    CAF_ASSERT(cache.size() <= std::numeric_limits<int32_t>::max());
+    auto n = std::min(open_credit, static_cast<int32_t>(cache.size()));
+    // Ship full batches.
+    for (; n >= desired_batch_size; n -= desired_batch_size)
+      emit_batch(self, desired_batch_size,
+                 cache.take(static_cast<size_t>(desired_batch_size)));
+    // Ship underful batch only if `force_underful` is set.
+    if (n > 0 && force_underfull)
+      emit_batch(self, n, cache.take(static_cast<size_t>(n)));
+  }
+
   /// Sends a `downstream_msg::close` on this path.
   void emit_regular_shutdown(local_actor* self);
 
@@ -0,0 +1,246 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "caf/buffered_downstream_manager.hpp"
+#include "caf/outbound_path.hpp"
+
+#include "caf/detail/algorithms.hpp"
+#include "caf/detail/consistent_hash_ring.hpp"
+#include "caf/detail/unordered_flat_map.hpp"
+
+namespace caf {
+
+/// Routes each element to exactly one downstream path, selected by the hash of
+/// the element. Paths own the ranges of a consistent hash ring. Hence, elements
+/// with equal hash values always go to the same path, and adding or removing a
+/// path only moves the hash values owned by that path. This allows scaling a
+/// keyed aggregation across a pool of actors.
+template <class T, class Hash = std::hash<T>>
+class partitioned_downstream_manager : public buffered_downstream_manager<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Base type.
+  using super = buffered_downstream_manager<T>;
+
+  /// Type of `paths_`.
+  using typename super::map_type;
+
+  /// Unique pointer to an outbound path.
+  using typename super::unique_path_ptr;
+
+  /// Computes the hash value of an element.
+  using hash_type = Hash;
+
+  /// Assigns hash values to paths.
+  using ring_type = detail::consistent_hash_ring<stream_slot>;
+
+  /// Caches elements routed to a single path.
+  using cache_type = std::vector<T>;
+
+  /// Maps slot IDs to caches.
+  using cache_map_type = detail::unordered_flat_map<stream_slot, cache_type>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  partitioned_downstream_manager(stream_manager* parent,
+                                 hash_type hash = hash_type{})
+      : super(parent),
+        hash_(std::move(hash)) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t buffered() const noexcept override {
+    // Each element lives either in the central buffer or in a single cache.
+    auto result = this->buf_.size();
+    for (auto& kvp : caches_)
+      result += kvp.second.size();
+    return result;
+  }
+
+  size_t buffered(stream_slot slot) const noexcept override {
+    auto i = caches_.find(slot);
+    return this->buf_.size() + (i != caches_.end() ? i->second.size() : 0u);
+  }
+
+  int32_t max_capacity() const noexcept override {
+    // Each path only receives its share of the elements, i.e., the capacity
+    // adds up.
+    int64_t result = 0;
+    for (auto& kvp : this->paths_)
+      result += kvp.second->max_capacity;
+    if (result == 0 || result > std::numeric_limits<int32_t>::max())
+      return std::numeric_limits<int32_t>::max();
+    return static_cast<int32_t>(result);
+  }
+
+  /// Returns the function object for hashing outgoing data.
+  hash_type& hasher() {
+    return hash_;
+  }
+
+  /// Returns the function object for hashing outgoing data.
+  const hash_type& hasher() const {
+    return hash_;
+  }
+
+  /// Returns the caches for all paths.
+  const cache_map_type& caches() const {
+    return caches_;
+  }
+
+  /// Returns the hash ring for assigning elements to paths.
+  const ring_type& ring() const {
+    return ring_;
+  }
+
+  // -- overridden functions ---------------------------------------------------
+
+  bool insert_path(unique_path_ptr ptr) override {
+    CAF_LOG_TRACE(CAF_ARG(ptr));
+    // Make sure caches_ and paths_ are always equally sorted, otherwise we'll
+    // run into UB when calling `zip_foreach`.
+    CAF_ASSERT(caches_.size() == this->paths_.size());
+    auto slot = ptr->slots.sender;
+    if (!super::insert_path(std::move(ptr))) {
+      CAF_LOG_DEBUG("unable to insert path at slot" << slot);
+      return false;
+    }
+    if (!caches_.emplace(slot, cache_type{}).second) {
+      CAF_LOG_DEBUG("unable to add cache for slot" << slot);
+      super::remove_path(slot, none, true);
+      return false;
+    }
+    ring_.insert(slot, slot);
+    return true;
+  }
+
+  void emit_batches() override {
+    CAF_LOG_TRACE(CAF_ARG2("buffered", this->buffered())
+                  << CAF_ARG2("paths", this->paths_.size()));
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    CAF_LOG_TRACE(CAF_ARG2("buffered", this->buffered())
+                  << CAF_ARG2("paths", this->paths_.size()));
+    emit_batches_impl(true);
+  }
+
+protected:
+  void about_to_erase(outbound_path* ptr, bool silent,
+                      error* reason) override {
+    CAF_ASSERT(ptr != nullptr);
+    CAF_LOG_TRACE(CAF_ARG2("slot", ptr->slots.sender) << CAF_ARG(silent) <<
+                  CAF_ARG(reason));
+    auto slot = ptr->slots.sender;
+    ring_.erase(slot);
+    // Hand elements that didn't make it to the path back to the central
+    // buffer for routing them to the remaining paths.
+    auto i = caches_.find(slot);
+    if (i != caches_.end()) {
+      auto& xs = i->second;
+      this->buf_.insert(this->buf_.begin(), std::make_move_iterator(xs.begin()),
+                        std::make_move_iterator(xs.end()));
+      caches_.erase(i);
+    }
+    super::about_to_erase(ptr, silent, reason);
+  }
+
+private:
+  void emit_batches_impl(bool force_underfull) {
+    CAF_ASSERT(this->paths_.size() == caches_.size());
+    if (this->paths_.empty())
+      return;
+    route();
+    auto f = [&](typename map_type::value_type& x,
+                 typename cache_map_type::value_type& y) {
+      // Always force batches on closing paths.
+      x.second->emit_batches(this->self(), y.second,
+                             force_underfull || x.second->closing);
+    };
+    detail::zip_foreach(f, this->paths_.container(), caches_.container());
+  }
+
+  /// Moves elements from the central buffer to the caches of their paths in a
+  /// single pass. Elements for paths without open credit remain in the central
+  /// buffer. Since a path never regains credit during a pass, this preserves
+  /// the order of all elements per path.
+  void route() {
+    auto& buf = this->buf_;
+    auto out = buf.begin();
+    for (auto i = buf.begin(); i != buf.end(); ++i) {
+      auto cache = select(*i);
+      if (cache != nullptr) {
+        cache->emplace_back(std::move(*i));
+      } else {
+        if (out != i)
+          *out = std::move(*i);
+        ++out;
+      }
+    }
+    buf.erase(out, buf.end());
+  }
+
+  /// Returns the cache of the path for `x` or `nullptr` if the path has no
+  /// open credit left.
+  cache_type* select(const T& x) {
+    auto hash_value = static_cast<uint64_t>(hash_(x));
+    for (;;) {
+      auto ptr = ring_.find(hash_value);
+      if (ptr == nullptr)
+        return nullptr;
+      auto slot = *ptr;
+      auto i = this->paths_.find(slot);
+      CAF_ASSERT(i != this->paths_.end());
+      auto& path = *i->second;
+      if (path.closing) {
+        // Closing paths accept no new data. Hence, we can safely pass their
+        // share of hash values on to the remaining paths.
+        ring_.erase(slot);
+        continue;
+      }
+      auto& cache = caches_[slot];
+      if (cache.size() >= static_cast<size_t>(path.open_credit))
+        return nullptr;
+      return &cache;
+    }
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Computes hash values for outgoing data.
+  hash_type hash_;
+
+  /// Assigns hash values to paths.
+  ring_type ring_;
+
+  /// Caches elements for each path.
+  cache_map_type caches_;
+};
+
+} // namespace caf
@@ -0,0 +1,54 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "caf/detail/work_stealing_deque.hpp"
+#include "caf/policy/work_stealing.hpp"
+#include "caf/resumable.hpp"
+
+namespace caf {
+namespace policy {
+
+/// Implements scheduling of actors via work stealing, using a lock-free
+/// Chase-Lev deque as job queue for each worker. Workers push and pop jobs
+/// at the bottom of their own deque without locking while thieves steal from
+/// the top. Jobs enqueued from other threads go through a bounded inbox. In
+/// contrast to `work_stealing`, enqueueing a job does not allocate.
+/// @extends scheduler_policy
+class lock_free_work_stealing : public work_stealing {
+public:
+  ~lock_free_work_stealing() override;
+
+  // A lock-free queue implementation.
+  using queue_type = detail::work_stealing_deque<resumable>;
+
+  // Holds job job queue of a worker and a random number generator.
+  struct worker_data : worker_data_base {
+    explicit worker_data(scheduler::abstract_coordinator* p);
+    worker_data(const worker_data& other);
+
+    // Only the owning worker may call `prepend` and `take_head`. Other workers
+    // steal via `take_tail` and the central scheduling unit uses `append`.
+    queue_type queue;
+  };
+};
+
+} // namespace policy
+} // namespace caf
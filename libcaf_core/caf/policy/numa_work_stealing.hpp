@@ -0,0 +1,162 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "caf/detail/cpu_topology.hpp"
+#include "caf/policy/work_stealing.hpp"
+#include "caf/resumable.hpp"
+
+namespace caf {
+namespace policy {
+
+/// Implements scheduling of actors via work stealing while taking the CPU
+/// topology into account. Workers are pinned to CPUs and grouped by locality
+/// domain (NUMA node or L3 cache). Thieves prefer victims in their own domain
+/// and only cross domains after several consecutive misses. Jobs from outside
+/// the scheduler go to a worker in the domain of the calling thread.
+/// @extends scheduler_policy
+class numa_work_stealing : public work_stealing {
+public:
+  ~numa_work_stealing() override;
+
+  // Maps workers to CPUs and locality domains. Shared by all workers.
+  struct layout {
+    explicit layout(scheduler::abstract_coordinator* p);
+
+    // Spreads `num_workers` workers across the domains of `topo` in
+    // proportion to the number of CPUs in each domain.
+    layout(detail::cpu_topology topo, size_t num_workers);
+
+    // Returns the domain of the calling thread.
+    size_t current_domain() const;
+
+    // The topology of the machine.
+    detail::cpu_topology topology;
+    // Whether workers pin themselves to `cpu_of[worker_id]`.
+    bool pin_workers;
+    // Number of consecutive misses before stealing across domains.
+    size_t remote_steal_threshold;
+    // The CPU of each worker.
+    std::vector<int> cpu_of;
+    // The domain of each worker.
+    std::vector<size_t> domain_of;
+    // The worker IDs in each domain.
+    std::vector<std::vector<size_t>> workers;
+    // The potential victims of each worker, neighbors in the same domain
+    // first and all remaining workers afterwards.
+    std::vector<std::vector<size_t>> victims;
+    // The number of neighbors at the front of each list in `victims`.
+    std::vector<size_t> num_neighbors;
+    // Round-robin counters for each domain.
+    std::unique_ptr<std::atomic<size_t>[]> next_worker;
+    // Maps CPU IDs to domains.
+    std::vector<size_t> domain_of_cpu;
+  };
+
+  // Holds job job queue of a worker, a random number generator, and a
+  // pointer to the shared worker layout.
+  struct worker_data : work_stealing::worker_data {
+    explicit worker_data(scheduler::abstract_coordinator* p);
+    worker_data(const worker_data& other);
+
+    std::shared_ptr<layout> shared;
+    // Number of consecutive steal attempts in the local domain that failed.
+    size_t misses;
+  };
+
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    auto& l = *d(self).shared;
+    if (l.pin_workers)
+      detail::pin_this_thread(l.cpu_of[self->id()]);
+  }
+
+  // Goes on a raid in quest for a shiny new job, visiting neighbors first.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
+    auto p = self->parent();
+    if (p->num_workers() < 2)
+      return nullptr;
+    auto& data = d(self);
+    auto& l = *data.shared;
+    auto id = self->id();
+    auto& victims = l.victims[id];
+    auto num_neighbors = l.num_neighbors[id];
+    if (num_neighbors > 0) {
+      auto victim = random_victim(data, victims, 0, num_neighbors);
+      auto job = d(p->worker_by_id(victim)).queue.take_tail();
+      if (job != nullptr) {
+        data.misses = 0;
+        return job;
+      }
+    }
+    if (num_neighbors == victims.size()
+        || ++data.misses < l.remote_steal_threshold)
+      return nullptr;
+    data.misses = 0;
+    auto victim = random_victim(data, victims, num_neighbors, victims.size());
+    return d(p->worker_by_id(victim)).queue.take_tail();
+  }
+
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable* job) {
+    auto& l = *d(self->worker_by_id(0)).shared;
+    auto domain = l.current_domain();
+    auto& ws = l.workers[domain];
+    auto w = ws.empty()
+             ? self->worker_by_id(d(self).next_worker++ % self->num_workers())
+             : self->worker_by_id(ws[l.next_worker[domain]++ % ws.size()]);
+    w->external_enqueue(job);
+  }
+
+  template <class Coordinator, class Iterator>
+  void central_enqueue_all(Coordinator* self, Iterator first, Iterator last) {
+    auto& l = *d(self->worker_by_id(0)).shared;
+    auto domain = l.current_domain();
+    auto& ws = l.workers[domain];
+    if (ws.empty()) {
+      work_stealing::central_enqueue_all(self, first, last);
+      return;
+    }
+    auto& next = l.next_worker[domain];
+    enqueue_runs(first, last, ws.size(), [&] {
+      return self->worker_by_id(ws[next++ % ws.size()]);
+    });
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    return dequeue_impl(self, [=] { return try_steal(self); });
+  }
+
+private:
+  // Picks a random element in the range `[first, last)` of `candidates`.
+  static size_t random_victim(worker_data& data,
+                              const std::vector<size_t>& candidates,
+                              size_t first, size_t last);
+};
+
+} // namespace policy
+} // namespace caf
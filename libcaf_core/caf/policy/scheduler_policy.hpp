@@ -42,6 +42,10 @@ public:
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job);
 
+  /// Enqueues all jobs in `[first, last)` to the coordinator.
+  template <class Coordinator, class Iterator>
+  void central_enqueue_all(Coordinator* self, Iterator first, Iterator last);
+
   /// Enqueues a new job to the worker's queue from an
   /// external source, i.e., from any other thread.
   template <class Worker>
@@ -61,6 +65,11 @@ public:
   template <class Worker>
   resumable* dequeue(Worker* self);
 
+  /// Called once from the thread of a worker before it starts dequeueing
+  /// jobs. Allows policies to set thread-local state such as CPU affinity.
+  template <class Worker>
+  void init_worker_thread(Worker* self);
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker* self);
@@ -32,6 +32,13 @@ class unprofiled {
 public:
   virtual ~unprofiled();
 
+  /// Called once from the thread of a worker before it starts dequeueing
+  /// jobs. Allows policies to set thread-local state such as CPU affinity.
+  template <class Worker>
+  void init_worker_thread(Worker*) {
+    // nop
+  }
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker*) {
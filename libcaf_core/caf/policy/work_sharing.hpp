@@ -68,6 +68,18 @@ public:
     enqueue(self, job);
   }
 
+  template <class Coordinator, class Iterator>
+  void central_enqueue_all(Coordinator* self, Iterator first, Iterator last) {
+    queue_type l{first, last};
+    auto n = l.size();
+    std::unique_lock<std::mutex> guard(d(self).lock);
+    d(self).queue.splice(d(self).queue.end(), l);
+    if (n == 1)
+      d(self).cv.notify_one();
+    else
+      d(self).cv.notify_all();
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     enqueue(self->parent(), job);
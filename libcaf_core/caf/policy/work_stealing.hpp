@@ -18,17 +18,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
-#include <deque>
-#include <mutex>
+#include <iterator>
 #include <random>
 #include <thread>
 
 #include "caf/actor_system_config.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/parker.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
 #include "caf/timespan.hpp"
@@ -55,34 +56,56 @@ public:
 
   // what is needed to implement the waiting strategy.
   struct wait_strategy {
-    std::mutex lock;
-    std::condition_variable cv;
-    bool sleeping{false};
+    wait_strategy() : new_jobs(0) {
+      // nop
+    }
+
+    // puts the worker to sleep without requiring a mutex for wakeups
+    detail::parker parker;
+    // number of jobs added via internal_enqueue during the current resume
+    size_t new_jobs;
   };
 
-  // The coordinator has only a counter for round-robin enqueue to its workers.
+  // The coordinator has a counter for round-robin enqueue to its workers and
+  // keeps track of how many workers are currently parked. Together with the
+  // parker of each worker, this forms a lock-free registry of idle workers.
   struct coordinator_data {
     inline explicit coordinator_data(scheduler::abstract_coordinator*)
-        : next_worker(0) {
+        : next_worker(0),
+          parked_workers(0) {
       // nop
     }
 
     std::atomic<size_t> next_worker;
+    std::atomic<size_t> parked_workers;
   };
 
+  // Holds the state of a worker that does not depend on the queue type.
+  struct worker_data_base {
+    explicit worker_data_base(scheduler::abstract_coordinator* p);
+    worker_data_base(const worker_data_base& other);
+
+    // needed to generate pseudo random numbers
+    std::default_random_engine rengine;
+    std::uniform_int_distribution<size_t> uniform;
+    std::array<poll_strategy, 3> strategies;
+    // number of poll attempts for the aggressive and moderate strategy,
+    // adapted at runtime and bounded by `strategies[k].attempts`
+    std::array<size_t, 2> poll_budget;
+    wait_strategy waitdata;
+  };
+
+  // Lower bound for `poll_budget[k]`, relative to `strategies[k].attempts`.
+  static constexpr size_t min_poll_budget_divisor = 16;
+
   // Holds job job queue of a worker and a random number generator.
-  struct worker_data {
+  struct worker_data : worker_data_base {
     explicit worker_data(scheduler::abstract_coordinator* p);
     worker_data(const worker_data& other);
 
     // This queue is exposed to other workers that may attempt to steal jobs
     // from it and the central scheduling unit can push new jobs to the queue.
     queue_type queue;
-    // needed to generate pseudo random numbers
-    std::default_random_engine rengine;
-    std::uniform_int_distribution<size_t> uniform;
-    std::array<poll_strategy, 3> strategies;
-    wait_strategy waitdata;
   };
 
   // Goes on a raid in quest for a shiny new job.
@@ -107,22 +130,58 @@ public:
     w->external_enqueue(job);
   }
 
+  template <class Coordinator, class Iterator>
+  void central_enqueue_all(Coordinator* self, Iterator first, Iterator last) {
+    auto& next = d(self).next_worker;
+    auto n = self->num_workers();
+    enqueue_runs(first, last, n,
+                 [&] { return self->worker_by_id(next++ % n); });
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
-    auto& lock = d(self).waitdata.lock;
-    auto& cv = d(self).waitdata.cv;
-    { // guard scope
-      std::unique_lock<std::mutex> guard(lock);
-      // check if the worker is sleeping
-      if (d(self).waitdata.sleeping && !d(self).queue.empty() )
-        cv.notify_one();
-    }
+    // only performs a system call if the worker actually sleeps
+    d(self).waitdata.parker.unpark();
+  }
+
+  template <class Worker, class Iterator>
+  void external_enqueue_all(Worker* self, Iterator first, Iterator last) {
+    auto& q = d(self).queue;
+    for (; first != last; ++first)
+      q.append(*first);
+    // wake up the worker once for the entire batch
+    d(self).waitdata.parker.unpark();
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
     d(self).queue.prepend(job);
+    ++d(self).waitdata.new_jobs;
+  }
+
+  template <class Worker>
+  void after_resume(Worker* self, resumable*) {
+    // wake up at most one idle worker per resume if the job produced work
+    // that others could steal, instead of waking a worker per enqueue
+    auto& new_jobs = d(self).waitdata.new_jobs;
+    if (new_jobs > 0 && !d(self).queue.empty())
+      wake_idle_worker(self);
+    new_jobs = 0;
+  }
+
+  // Unparks one of the idle workers (if any), starting at the neighbor of
+  // `self`. Returns whether a worker was woken up.
+  template <class Worker>
+  bool wake_idle_worker(Worker* self) {
+    auto p = self->parent();
+    if (d(p).parked_workers.load(std::memory_order_relaxed) == 0)
+      return false;
+    auto n = p->num_workers();
+    for (size_t i = 1; i < n; ++i)
+      if (d(p->worker_by_id((self->id() + i) % n)).waitdata.parker.unpark())
+        return true;
+    return false;
   }
 
   template <class Worker>
@@ -134,70 +193,96 @@ public:
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
+    return dequeue_impl(self, [=] { return try_steal(self); });
+  }
+
+  template <class Worker, class UnaryFunction>
+  void foreach_resumable(Worker* self, UnaryFunction f) {
+    auto next = [&] { return d(self).queue.take_head(); };
+    for (auto job = next(); job != nullptr; job = next()) {
+      f(job);
+    }
+  }
+
+  template <class Coordinator, class UnaryFunction>
+  void foreach_central_resumable(Coordinator*, UnaryFunction) {
+    // nop
+  }
+
+protected:
+  // Splits `[first, last)` into at most `num_workers` contiguous runs and
+  // hands each run to the worker returned by `next_worker`. Each worker wakes
+  // up at most once per call.
+  template <class Iterator, class NextWorker>
+  static void enqueue_runs(Iterator first, Iterator last, size_t num_workers,
+                           NextWorker next_worker) {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    auto run_size = (n + num_workers - 1) / num_workers;
+    while (n > 0) {
+      auto k = std::min(n, run_size);
+      auto run_end = std::next(first, static_cast<ptrdiff_t>(k));
+      next_worker()->external_enqueue_all(first, run_end);
+      first = run_end;
+      n -= k;
+    }
+  }
+
+  // Implements `dequeue` on top of a custom steal function, which allows
+  // subtypes to change the victim selection without duplicating the polling.
+  template <class Worker, class StealFunction>
+  resumable* dequeue_impl(Worker* self, StealFunction steal) {
     // we wait for new jobs by polling our external queue: first, we
     // assume an active work load on the machine and perform aggresive
     // polling, then we relax our polling a bit and wait 50 us between
-    // dequeue attempts
+    // dequeue attempts; the number of attempts adapts to the load: finding
+    // work while polling increases the budget of the strategy, whereas
+    // having to park decreases the budget of both strategies
     auto& strategies = d(self).strategies;
+    auto& budget = d(self).poll_budget;
     resumable* job = nullptr;
     for (size_t k = 0; k < 2; ++k) {  // iterate over the first two strategies
-      for (size_t i = 0; i < strategies[k].attempts;
-           i += strategies[k].step_size) {
+      for (size_t i = 0; i < budget[k]; i += strategies[k].step_size) {
         job = d(self).queue.take_head();
-        if (job)
-          return job;
         // try to steal every X poll attempts
-        if ((i % strategies[k].steal_interval) == 0) {
-          job = try_steal(self);
-          if (job)
-            return job;
+        if (!job && (i % strategies[k].steal_interval) == 0)
+          job = steal();
+        if (job) {
+          budget[k] = std::min(budget[k] * 2, strategies[k].attempts);
+          return job;
         }
         if (strategies[k].sleep_duration.count() > 0)
           std::this_thread::sleep_for(strategies[k].sleep_duration);
       }
     }
+    for (size_t k = 0; k < 2; ++k)
+      budget[k] = std::max(budget[k] / 2, std::max(strategies[k].attempts
+                                                     / min_poll_budget_divisor,
+                                                   size_t{1}));
     // we assume pretty much nothing is going on so we can relax polling
-    // and falling to sleep on a condition variable whose timeout is the one
-    // of the relaxed polling strategy
+    // and fall asleep until either another thread enqueues a job for us or
+    // the timeout of the relaxed polling strategy expires; enqueueing a job
+    // never needs to acquire a lock, because the parker only requires a
+    // system call if this worker actually sleeps
     auto& relaxed = strategies[2];
-    auto& sleeping = d(self).waitdata.sleeping;
-    auto& lock = d(self).waitdata.lock;
-    auto& cv = d(self).waitdata.cv;
-    bool notimeout = true;
-    size_t i=1;
+    auto& parker = d(self).waitdata.parker;
+    auto& parked_workers = d(self->parent()).parked_workers;
+    size_t i = 1;
     do {
-      { // guard scope
-        std::unique_lock<std::mutex> guard(lock);
-        sleeping = true;
-        if (!cv.wait_for(guard, relaxed.sleep_duration,
-                         [&] { return !d(self).queue.empty(); }))
-          notimeout = false;
-        sleeping = false;
-      }
-      if (notimeout) {
-        job = d(self).queue.take_head();
-      } else {
-        notimeout = true;
-        if ((i % relaxed.steal_interval) == 0)
-          job = try_steal(self);
-      }
+      ++parked_workers;
+      parker.prepare_park();
+      // re-check the queue after announcing our intent to avoid lost wakeups
+      if (!d(self).queue.empty())
+        parker.cancel_park();
+      else
+        parker.park(relaxed.sleep_duration);
+      --parked_workers;
+      job = d(self).queue.take_head();
+      if (!job && (i % relaxed.steal_interval) == 0)
+        job = steal();
       ++i;
-    } while(job == nullptr);
+    } while (job == nullptr);
     return job;
   }
-
-  template <class Worker, class UnaryFunction>
-  void foreach_resumable(Worker* self, UnaryFunction f) {
-    auto next = [&] { return d(self).queue.take_head(); };
-    for (auto job = next(); job != nullptr; job = next()) {
-      f(job);
-    }
-  }
-
-  template <class Coordinator, class UnaryFunction>
-  void foreach_central_resumable(Coordinator*, UnaryFunction) {
-    // nop
-  }
 };
 
 } // namespace policy
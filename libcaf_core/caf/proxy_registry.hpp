@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <functional>
 #include <unordered_map>
 
@@ -29,10 +32,13 @@
 #include "caf/actor_proxy.hpp"
 #include "caf/exit_reason.hpp"
 
+#include "caf/detail/sharded.hpp"
+
 namespace caf {
 
 /// Groups a (distributed) set of actors and allows actors
-/// in the same namespace to exchange messages.
+/// in the same namespace to exchange messages. All member functions are
+/// thread-safe, which allows several registries to share the same proxies.
 class proxy_registry {
 public:
   /// Responsible for creating proxy actors.
@@ -94,6 +100,11 @@ public:
   /// Deletes all proxies.
   void clear();
 
+  /// Deletes all proxies and then makes this registry share all proxies with
+  /// `other`. Both registries still use their own backend for creating new
+  /// proxy instances.
+  void share(proxy_registry& other);
+
   /// Returns the hosting actor system.
   inline actor_system& system() {
     return system_;
@@ -104,16 +115,48 @@ public:
     return system_;
   }
 
-  inline size_t size() const {
-    return proxies_.size();
-  }
+  /// Returns the number of nodes with at least one proxy.
+  size_t size() const;
 
 private:
   void kill_proxy(strong_actor_ptr&, error);
 
+  // Stores the proxies of a single node.
+  using proxy_table = std::unordered_map<actor_id, strong_actor_ptr>;
+
+  using proxy_map_per_node = std::unordered_map<node_id, proxy_table>;
+
+  // Marks a proxy that a call to `get_or_put` currently creates. Concurrent
+  // calls for the same actor wait for the result instead of asking the
+  // backend again, because backends announce each proxy to the remote node.
+  struct pending_proxy {
+    node_id nid;
+    actor_id aid;
+    // Set when erasing all proxies of `nid` while creating the proxy.
+    bool discarded;
+  };
+
+  // State of a shard. Creating a proxy only holds the lock of its shard while
+  // adding or removing an entry in `pending`, never while calling the backend.
+  struct shard_state {
+    proxy_map_per_node proxies;
+    std::vector<pending_proxy> pending;
+  };
+
+  // Number of shards. All proxies of a node reside in the same shard.
+  static constexpr size_t num_shards = 32;
+
+  // Proxies of this registry, shared with all registries passed to `share`.
+  using storage = detail::sharded<shard_state, num_shards>;
+
+  using shard = storage::shard;
+
+  // Returns the shard responsible for all proxies of `nid`.
+  shard& shard_of(const node_id& nid) const;
+
   actor_system& system_;
   backend& backend_;
-  std::unordered_map<node_id, proxy_map> proxies_;
+  std::shared_ptr<storage> data_;
 };
 
 } // namespace caf
@@ -28,6 +28,7 @@
 #include <map>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "caf/actor_marker.hpp"
 #include "caf/broadcast_downstream_manager.hpp"
@@ -63,6 +64,7 @@
 #include "caf/policy/urgent_messages.hpp"
 
 #include "caf/detail/behavior_stack.hpp"
+#include "caf/detail/parallel_stage_driver.hpp"
 #include "caf/detail/stream_sink_driver_impl.hpp"
 #include "caf/detail/stream_sink_impl.hpp"
 #include "caf/detail/stream_source_driver_impl.hpp"
@@ -324,6 +326,36 @@ public:
     return pending_stream_managers_;
   }
 
+  /// Returns the maximum number of messages this actor handles per
+  /// activation or 0 if the actor uses the setting of the scheduler.
+  inline size_t max_throughput() const noexcept {
+    return max_throughput_;
+  }
+
+  /// Sets the maximum number of messages this actor handles per activation.
+  /// Passing 0 restores the setting of the scheduler.
+  inline void max_throughput(size_t x) noexcept {
+    max_throughput_ = x;
+  }
+
+  /// Returns the desired processing time per activation or 0 if the actor
+  /// does not adapt its throughput limit.
+  inline timespan throughput_budget() const noexcept {
+    return throughput_budget_;
+  }
+
+  /// Sets the desired processing time per activation. Passing 0 disables
+  /// adapting the throughput limit to the cost per message.
+  inline void throughput_budget(timespan x) noexcept {
+    throughput_budget_ = x;
+  }
+
+  /// Returns the moving average of the processing time per message. The actor
+  /// only measures this value while it has a throughput budget.
+  inline timespan message_cost() const noexcept {
+    return message_cost_;
+  }
+
   // -- event handlers ---------------------------------------------------------
 
   /// Sets a custom handler for unexpected messages.
@@ -543,13 +575,19 @@ public:
     return {slot, std::move(mgr)};
   }
 
+  /// Creates a new stream sink for `in`. The optional `credit` selects how
+  /// the sink computes credit for its source.
   template <class In, class Init, class Fun, class Finalize = unit_t,
             class Trait = stream_sink_trait_t<Fun>>
   make_sink_result<In> make_sink(const stream<In>& in, Init init, Fun fun,
-                                 Finalize fin = {}) {
+                                 Finalize fin = {},
+                                 credit_controller_factory credit = {}) {
     using driver = detail::stream_sink_driver_impl<In, Fun, Finalize>;
-    return make_sink<driver>(in, std::move(init), std::move(fun),
-                             std::move(fin));
+    auto mgr = detail::make_stream_sink<driver>(this, std::move(init),
+                                                std::move(fun), std::move(fin));
+    mgr->credit_policy(std::move(credit));
+    auto slot = mgr->add_inbound_path(in);
+    return {slot, std::move(mgr)};
   }
 
   template <class Driver, class In, class... Ts, class... Us>
@@ -562,13 +600,16 @@ public:
     return {in, out, std::move(mgr)};
   }
 
+  /// Creates a new stream stage for `in`. The optional `credit` selects how
+  /// the stage computes credit for its source.
   template <class In, class... Ts, class Init, class Fun,
             class Finalize = unit_t,
             class DownstreamManager = default_downstream_manager_t<Fun>,
             class Trait = stream_stage_trait_t<Fun>>
   make_stage_result_t<In, DownstreamManager, Ts...>
   make_stage(const stream<In>& in, std::tuple<Ts...> xs, Init init, Fun fun,
-             Finalize fin = {}, policy::arg<DownstreamManager> token = {}) {
+             Finalize fin = {}, policy::arg<DownstreamManager> token = {},
+             credit_controller_factory credit = {}) {
     CAF_IGNORE_UNUSED(token);
     CAF_ASSERT(current_mailbox_element() != nullptr);
     CAF_ASSERT(
@@ -589,8 +630,13 @@ public:
     using driver = detail::stream_stage_driver_impl<typename Trait::input,
                                                     DownstreamManager, Fun,
                                                     Finalize>;
-    return make_stage<driver>(in, std::move(xs), std::move(init),
-                              std::move(fun), std::move(fin));
+    using detail::make_stream_stage;
+    auto mgr = make_stream_stage<driver>(this, std::move(init), std::move(fun),
+                                         std::move(fin));
+    mgr->credit_policy(std::move(credit));
+    auto slot_in = mgr->add_inbound_path(in);
+    auto slot_out = mgr->add_outbound_path(std::move(xs));
+    return {slot_in, slot_out, std::move(mgr)};
   }
 
   template <class In, class Init, class Fun, class Finalize = unit_t,
@@ -598,9 +644,34 @@ public:
             class Trait = stream_stage_trait_t<Fun>>
   make_stage_result_t<In, DownstreamManager>
   make_stage(const stream<In>& in, Init init, Fun fun, Finalize fin = {},
-             policy::arg<DownstreamManager> token = {}) {
+             policy::arg<DownstreamManager> token = {},
+             credit_controller_factory credit = {}) {
     return make_stage(in, std::make_tuple(), std::move(init), std::move(fun),
-                      std::move(fin), token);
+                      std::move(fin), token, std::move(credit));
+  }
+
+  /// Creates a new stream stage for `in` that runs `fun` on `num_workers`
+  /// worker actors. The stage pushes results downstream in the order of its
+  /// input if `ordered` is `true` and as soon as a worker responds otherwise.
+  /// @pre `fun` is stateless, i.e., takes `unit_t&` as state
+  template <class In, class Fun,
+            class DownstreamManager = default_downstream_manager_t<Fun>,
+            class Trait = stream_stage_trait_t<Fun>>
+  make_stage_result_t<In, DownstreamManager>
+  make_parallel_stage(const stream<In>& in, size_t num_workers, Fun fun,
+                      bool ordered = true,
+                      policy::arg<DownstreamManager> token = {}) {
+    CAF_IGNORE_UNUSED(token);
+    CAF_ASSERT(current_mailbox_element() != nullptr);
+    CAF_ASSERT(
+      current_mailbox_element()->content().match_elements<open_stream_msg>());
+    static_assert(Trait::valid && std::is_same<typename Trait::input,
+                                               In>::value,
+                  "Expected signature `void (unit_t&, downstream<Out>&, In)` "
+                  "for consume function");
+    using driver = detail::parallel_stage_driver<In, DownstreamManager, Fun>;
+    return make_stage<driver>(in, std::make_tuple(), num_workers,
+                              std::move(fun), ordered);
   }
 
   /// Returns a stream manager (implementing a continuous stage) without in- or
@@ -668,6 +739,16 @@ public:
   /// Adds a callback for a multiplexed response.
   void add_multiplexed_response_handler(message_id response_id, behavior bhvr);
 
+  /// Requests a new timeout for `mid` and remembers to cancel it once the
+  /// response arrives.
+  void request_response_timeout(const duration& d, message_id mid) override;
+
+  /// Marks the pending request timeout for `response_id` (if any) as obsolete.
+  void drop_response_timeout(message_id response_id);
+
+  /// Cancels all obsolete request timeouts with a single clock operation.
+  void flush_response_timeouts();
+
   /// Returns the category of `x`.
   message_category categorize(mailbox_element& x);
 
@@ -870,6 +951,16 @@ public:
   /// this function again.
   actor_clock::time_point advance_streams(actor_clock::time_point now);
 
+  // -- throughput management --------------------------------------------------
+
+  /// Returns how many messages to handle in the next activation, given the
+  /// limit `scheduler_limit` of the scheduler.
+  size_t throughput_limit(size_t scheduler_limit) const noexcept;
+
+  /// Updates the moving average of the cost per message after handling `n`
+  /// messages in `elapsed` time.
+  void update_message_cost(timespan elapsed, size_t n) noexcept;
+
   // -- properties -------------------------------------------------------------
 
   /// Returns `true` if the actor has a behavior, awaits responses, or
@@ -901,7 +992,14 @@ protected:
   std::forward_list<pending_response> awaited_responses_;
 
   /// Stores callbacks for multiplexed responses.
-  detail::unordered_flat_map<message_id, behavior> multiplexed_responses_;
+  std::unordered_map<message_id, behavior> multiplexed_responses_;
+
+  /// Stores response IDs with a pending request timeout.
+  std::unordered_set<message_id> response_timeouts_;
+
+  /// Stores request timeouts that became obsolete during the current
+  /// activation. The actor cancels them in bulk before going to sleep.
+  std::vector<message_id> obsolete_response_timeouts_;
 
   /// Customization point for setting a default `message` callback.
   default_handler default_handler_;
@@ -934,6 +1032,15 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Overrides the throughput limit of the scheduler if non-zero.
+  size_t max_throughput_;
+
+  /// Desired processing time per activation if non-zero.
+  timespan throughput_budget_;
+
+  /// Moving average of the processing time per message.
+  timespan message_cost_;
+
 # ifndef CAF_NO_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
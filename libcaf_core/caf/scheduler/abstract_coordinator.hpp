@@ -21,6 +21,7 @@
 #include <chrono>
 #include <atomic>
 #include <cstddef>
+#include <vector>
 
 #include "caf/fwd.hpp"
 #include "caf/atom.hpp"
@@ -61,6 +62,10 @@ public:
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Puts all `jobs` into the queues of the workers at once. The default
+  /// implementation calls `enqueue` for each job.
+  virtual void enqueue_all(const std::vector<resumable*>& jobs);
+
   inline actor_system& system() {
     return system_;
   }
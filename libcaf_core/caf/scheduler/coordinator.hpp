@@ -25,8 +25,11 @@
 #include <memory>
 #include <condition_variable>
 
+#include "caf/actor_system_config.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/thread_safe_actor_clock.hpp"
+#include "caf/detail/timer_wheel_actor_clock.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
 #include "caf/scheduler/worker.hpp"
 
@@ -59,6 +62,13 @@ public:
     return new coordinator(sys);
   }
 
+  void init(actor_system_config& cfg) override {
+    namespace sr = defaults::scheduler;
+    super::init(cfg);
+    if (get_or(cfg, "scheduler.clock", sr::clock) == atom("wheel"))
+      wheel_.reset(new detail::timer_wheel_actor_clock);
+  }
+
 protected:
   void start() override {
     // Create initial state for all workers.
@@ -78,7 +88,10 @@ protected:
       CAF_SET_LOGGER_SYS(&system());
       detail::set_thread_name("caf.clock");
       system().thread_started();
-      clock_.run_dispatch_loop();
+      if (wheel_)
+        wheel_->run_dispatch_loop();
+      else
+        clock_.run_dispatch_loop();
       system().thread_terminates();
     }};
     // Run remaining startup code.
@@ -141,7 +154,10 @@ protected:
       policy_.foreach_resumable(w.get(), f);
     policy_.foreach_central_resumable(this, f);
     // stop timer thread
-    clock_.cancel_dispatch_loop();
+    if (wheel_)
+      wheel_->cancel_dispatch_loop();
+    else
+      clock_.cancel_dispatch_loop();
     timer_.join();
   }
 
@@ -149,7 +165,14 @@ protected:
     policy_.central_enqueue(this, ptr);
   }
 
-  detail::thread_safe_actor_clock& clock() noexcept override {
+  void enqueue_all(const std::vector<resumable*>& jobs) override {
+    if (!jobs.empty())
+      policy_.central_enqueue_all(this, jobs.begin(), jobs.end());
+  }
+
+  actor_clock& clock() noexcept override {
+    if (wheel_)
+      return *wheel_;
     return clock_;
   }
 
@@ -157,6 +180,9 @@ private:
   /// System-wide clock.
   detail::thread_safe_actor_clock clock_;
 
+  /// Replaces `clock_` if the user selects the timer wheel via config.
+  std::unique_ptr<detail::timer_wheel_actor_clock> wheel_;
+
   /// Set of workers.
   std::vector<std::unique_ptr<worker_type>> workers_;
 
@@ -72,6 +72,13 @@ public:
     policy_.external_enqueue(this, job);
   }
 
+  /// Enqueues all jobs in `[first, last)` to the worker's queue from an
+  /// external source, i.e., from any other thread.
+  template <class Iterator>
+  void external_enqueue_all(Iterator first, Iterator last) {
+    policy_.external_enqueue_all(this, first, last);
+  }
+
   /// Enqueues a new job to the worker's queue from an internal
   /// source, i.e., a job that is currently executed by this worker.
   /// @warning Must not be called from other threads.
@@ -109,6 +116,7 @@ public:
 private:
   void run() {
     CAF_SET_LOGGER_SYS(&system());
+    policy_.init_worker_thread(this);
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
@@ -31,6 +31,9 @@ public:
 
   /// Delegates the resumable to the scheduler of `system()`.
   void exec_later(resumable* ptr) override;
+
+  /// Delegates all resumables to the scheduler of `system()` at once.
+  void exec_later_all(const std::vector<resumable*>& ptrs) override;
 };
 
 } // namespace caf
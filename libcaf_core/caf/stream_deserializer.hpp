@@ -215,6 +215,58 @@ protected:
     return none;
   }
 
+  error apply_builtin_range(builtin type, size_t num, void* first) override {
+    CAF_ASSERT(first != nullptr);
+    switch (type) {
+      default: // i8_v or u8_v
+        CAF_ASSERT(type == i8_v || type == u8_v);
+        return apply_raw(num, first);
+      case i16_v:
+      case u16_v:
+        return apply_int_range(static_cast<uint16_t*>(first), num);
+      case i32_v:
+      case u32_v:
+        return apply_int_range(static_cast<uint32_t*>(first), num);
+      case i64_v:
+      case u64_v:
+        return apply_int_range(static_cast<uint64_t*>(first), num);
+      case float_v:
+        return apply_float_range(static_cast<float*>(first), num);
+      case double_v:
+        return apply_float_range(static_cast<double*>(first), num);
+    }
+  }
+
+  // Reads all integers with a single call to `sgetn` and converts them to
+  // host byte order in place afterwards.
+  template <class T>
+  error apply_int_range(T* xs, size_t num) {
+    auto e = apply_raw(num * sizeof(T), xs);
+    if (e)
+      return e;
+    for (size_t i = 0; i < num; ++i)
+      xs[i] = detail::from_network_order(xs[i]);
+    return none;
+  }
+
+  template <class T>
+  error apply_float_range(T* xs, size_t num) {
+    using packed_type = typename detail::ieee_754_trait<T>::packed_type;
+    const size_t chunk_size = 128;
+    packed_type buf[chunk_size];
+    while (num > 0) {
+      auto n = num < chunk_size ? num : chunk_size;
+      auto e = apply_raw(n * sizeof(packed_type), buf);
+      if (e)
+        return e;
+      for (size_t i = 0; i < n; ++i)
+        xs[i] = detail::unpack754(detail::from_network_order(buf[i]));
+      xs += n;
+      num -= n;
+    }
+    return none;
+  }
+
 private:
   Streambuf streambuf_;
 };
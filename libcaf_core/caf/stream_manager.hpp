@@ -25,6 +25,7 @@
 
 #include "caf/actor.hpp"
 #include "caf/actor_cast.hpp"
+#include "caf/credit_controller.hpp"
 #include "caf/downstream_manager.hpp"
 #include "caf/downstream_msg.hpp"
 #include "caf/fwd.hpp"
@@ -175,6 +176,17 @@ public:
   /// Returns the inbound paths at slot `x`.
   inbound_path* get_inbound_path(stream_slot x) const noexcept;
 
+  /// Returns the factory for credit controllers of new inbound paths.
+  inline const credit_controller_factory& credit_policy() const noexcept {
+    return credit_policy_;
+  }
+
+  /// Sets the factory for credit controllers of inbound paths added after
+  /// this call. An empty factory selects the default controller.
+  inline void credit_policy(credit_controller_factory f) {
+    credit_policy_ = std::move(f);
+  }
+
   /// Queries whether all inbound paths are up-to-date and have non-zero
   /// credit. A sink is idle if this function returns `true`.
   bool inbound_paths_idle() const noexcept;
@@ -312,6 +324,9 @@ protected:
   /// Stores individual flags, for continuous streaming or when shutting down.
   int flags_;
 
+  /// Creates credit controllers for new inbound paths.
+  credit_controller_factory credit_policy_;
+
 private:
   void setf(int flag) noexcept {
     auto x = flags_;
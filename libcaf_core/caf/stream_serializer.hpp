@@ -187,6 +187,65 @@ protected:
     return apply_raw(sizeof(T), &y);
   }
 
+  error apply_builtin_range(builtin type, size_t num, void* first) override {
+    CAF_ASSERT(first != nullptr);
+    switch (type) {
+      default: // i8_v or u8_v
+        CAF_ASSERT(type == i8_v || type == u8_v);
+        return apply_raw(num, first);
+      case i16_v:
+      case u16_v:
+        return apply_int_range(static_cast<uint16_t*>(first), num);
+      case i32_v:
+      case u32_v:
+        return apply_int_range(static_cast<uint32_t*>(first), num);
+      case i64_v:
+      case u64_v:
+        return apply_int_range(static_cast<uint64_t*>(first), num);
+      case float_v:
+        return apply_float_range(static_cast<float*>(first), num);
+      case double_v:
+        return apply_float_range(static_cast<double*>(first), num);
+    }
+  }
+
+  // Converts `xs` to network byte order in chunks on the stack and writes
+  // each chunk with a single call to `sputn`.
+  template <class T>
+  error apply_int_range(const T* xs, size_t num) {
+    const size_t chunk_size = 128;
+    T buf[chunk_size];
+    while (num > 0) {
+      auto n = num < chunk_size ? num : chunk_size;
+      for (size_t i = 0; i < n; ++i)
+        buf[i] = detail::to_network_order(xs[i]);
+      auto e = apply_raw(n * sizeof(T), buf);
+      if (e)
+        return e;
+      xs += n;
+      num -= n;
+    }
+    return none;
+  }
+
+  template <class T>
+  error apply_float_range(const T* xs, size_t num) {
+    using packed_type = typename detail::ieee_754_trait<T>::packed_type;
+    const size_t chunk_size = 128;
+    packed_type buf[chunk_size];
+    while (num > 0) {
+      auto n = num < chunk_size ? num : chunk_size;
+      for (size_t i = 0; i < n; ++i)
+        buf[i] = detail::to_network_order(detail::pack754(xs[i]));
+      auto e = apply_raw(n * sizeof(packed_type), buf);
+      if (e)
+        return e;
+      xs += n;
+      num -= n;
+    }
+    return none;
+  }
+
 private:
   Streambuf streambuf_;
 };
@@ -61,6 +61,13 @@ public:
   /// Processes a single batch.
   virtual void process(std::vector<input_type>& batch) = 0;
 
+  /// Processes a single batch that other receivers share, e.g., after a local
+  /// broadcast. The default implementation calls `process` on a copy.
+  virtual void process_shared(const std::vector<input_type>& batch) {
+    auto xs = batch;
+    process(xs);
+  }
+
   /// Can mark the sink as congested, e.g., when writing into a buffer that
   /// fills up faster than it is drained.
   virtual bool congested() const noexcept {
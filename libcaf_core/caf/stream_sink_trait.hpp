@@ -36,6 +36,12 @@ struct stream_sink_trait_invoke_one {
     for (auto& x : xs)
       f(st, std::move(x));
   }
+
+  template <class F, class State, class In>
+  static void invoke(F& f, State& st, const std::vector<In>& xs) {
+    for (auto& x : xs)
+      f(st, x);
+  }
 };
 
 struct stream_sink_trait_invoke_all {
@@ -43,6 +49,20 @@ struct stream_sink_trait_invoke_all {
   static void invoke(F& f, State& st, std::vector<In>& xs) {
     f(st, xs);
   }
+
+  // Functions taking a mutable vector require a copy of shared batches.
+  template <class F, class State, class In>
+  static void invoke(F& f, State& st, const std::vector<In>& xs) {
+    auto ys = xs;
+    f(st, ys);
+  }
+};
+
+struct stream_sink_trait_invoke_all_const {
+  template <class F, class State, class In>
+  static void invoke(F& f, State& st, const std::vector<In>& xs) {
+    f(st, xs);
+  }
 };
 
 } // namespace detail
@@ -87,7 +107,7 @@ template <class State, class In>
 struct stream_sink_trait<void(State&, const std::vector<In>&)>
     : stream_sink_trait_base<State, In> {
   /// Defines a helper for dispatching to the processing function object.
-  using process = detail::stream_sink_trait_invoke_all;
+  using process = detail::stream_sink_trait_invoke_all_const;
 };
 
 // -- convenience alias --------------------------------------------------------
@@ -67,6 +67,14 @@ public:
   virtual void process(downstream<output_type>& out,
                        std::vector<input_type>& batch) = 0;
 
+  /// Processes a single batch that other receivers share, e.g., after a local
+  /// broadcast. The default implementation calls `process` on a copy.
+  virtual void process_shared(downstream<output_type>& out,
+                              const std::vector<input_type>& batch) {
+    auto xs = batch;
+    process(out, xs);
+  }
+
   /// Cleans up any state.
   virtual void finalize(const error&) {
     // nop
@@ -86,6 +94,13 @@ public:
     return desired;
   }
 
+  /// Returns whether the driver finished all work on received batches. The
+  /// stage cannot shut down before its driver is done. The default
+  /// implementation always returns `true`.
+  virtual bool done() const noexcept {
+    return true;
+  }
+
 protected:
   DownstreamManager& out_;
 };
@@ -37,6 +37,13 @@ struct stream_stage_trait_invoke_one {
     for (auto& x : xs)
       f(st, out, std::move(x));
   }
+
+  template <class F, class State, class Out, class In>
+  static void invoke(F& f, State& st, downstream<Out>& out,
+                     const std::vector<In>& xs) {
+    for (auto& x : xs)
+      f(st, out, x);
+  }
 };
 
 struct stream_stage_trait_invoke_all {
@@ -45,6 +52,22 @@ struct stream_stage_trait_invoke_all {
                      std::vector<In>& xs) {
     f(st, out, xs);
   }
+
+  // Functions taking a mutable vector require a copy of shared batches.
+  template <class F, class State, class Out, class In>
+  static void invoke(F& f, State& st, downstream<Out>& out,
+                     const std::vector<In>& xs) {
+    auto ys = xs;
+    f(st, out, ys);
+  }
+};
+
+struct stream_stage_trait_invoke_all_const {
+  template <class F, class State, class Out, class In>
+  static void invoke(F& f, State& st, downstream<Out>& out,
+                     const std::vector<In>& xs) {
+    f(st, out, xs);
+  }
 };
 
 } // namespace detail
@@ -77,6 +100,16 @@ struct stream_stage_trait<void (State&, downstream<Out>&, std::vector<In>&)> {
   using process = detail::stream_stage_trait_invoke_all;
 };
 
+template <class State, class In, class Out>
+struct stream_stage_trait<void (State&, downstream<Out>&,
+                                const std::vector<In>&)> {
+  static constexpr bool valid = true;
+  using state = State;
+  using input = In;
+  using output = Out;
+  using process = detail::stream_stage_trait_invoke_all_const;
+};
+
 // -- convenience alias --------------------------------------------------------
 
 /// Convenience alias for extracting the function signature from `Process` and
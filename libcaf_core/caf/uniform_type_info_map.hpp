@@ -20,8 +20,10 @@
 
 #include <set>
 #include <map>
+#include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 #include <typeinfo>
 #include <stdexcept>
 #include <typeindex>
@@ -38,6 +40,7 @@
 #include "caf/type_erased_value.hpp"
 
 #include "caf/type_nr.hpp"
+#include "caf/detail/message_data.hpp"
 #include "caf/detail/type_list.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 
@@ -67,6 +70,8 @@ public:
 
   using error_renderers = std::unordered_map<atom_value, error_renderer>;
 
+  using message_factory = std::function<detail::message_data::cow_ptr ()>;
+
   type_erased_value_ptr make_value(uint16_t nr) const;
 
   type_erased_value_ptr make_value(const std::string& x) const;
@@ -84,6 +89,37 @@ public:
     return portable_name(x.first, x.second);
   }
 
+  /// Returns the local type ID for given type information or 0 if no mapping
+  /// was found. Builtin types use their type number as ID. Custom types
+  /// follow in the order of their portable names.
+  uint16_t type_id(uint16_t nr, const std::type_info* ti) const;
+
+  /// Returns the local type ID for given type information or 0 if no mapping
+  /// was found.
+  inline uint16_t
+  type_id(const std::pair<uint16_t, const std::type_info*>& x) const {
+    return type_id(x.first, x.second);
+  }
+
+  /// Returns the local type ID for the portable name `x` or 0 if no mapping
+  /// was found.
+  uint16_t type_id(const std::string& x) const;
+
+  /// Returns the portable names of all types ordered by their type ID, i.e.,
+  /// the first element is the name of the type with ID 1.
+  inline const std::vector<std::string>& type_names() const {
+    return type_names_;
+  }
+
+  /// Returns the factory for messages with the type names `x` or `nullptr` if
+  /// no factory was registered. The type names use the format
+  /// `@<>+name1+name2+...`.
+  const message_factory* find_message_factory(const std::string& x) const;
+
+  /// Returns the factory for messages with the local type IDs `x` or
+  /// `nullptr` if no factory was registered.
+  const message_factory* find_message_factory(const std::u16string& x) const;
+
   /// Returns the enclosing actor system.
   inline actor_system& system() const {
     return system_;
@@ -92,6 +128,14 @@ public:
 private:
   uniform_type_info_map(actor_system& sys);
 
+  // Assigns type IDs to custom types. Called by the actor system as soon as
+  // its config is available.
+  void init_type_ids();
+
+  // Indexes the message factories of the config by type names and type IDs.
+  // Requires a previous call to `init_type_ids`.
+  void init_message_factories();
+
   actor_system& system_;
 
   // message types
@@ -101,6 +145,16 @@ private:
 
   // message type names
   std::array<std::string, type_nrs - 1> builtin_names_;
+
+  // type IDs
+  std::vector<value_factory> custom_;
+  std::unordered_map<std::type_index, uint16_t> custom_ids_;
+  std::unordered_map<std::string, uint16_t> ids_by_name_;
+  std::vector<std::string> type_names_;
+
+  // message factories
+  std::unordered_map<std::string, message_factory> message_factories_by_name_;
+  std::unordered_map<std::u16string, message_factory> message_factories_by_id_;
 };
 
 } // namespace caf
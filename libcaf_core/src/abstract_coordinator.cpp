@@ -237,6 +237,11 @@ const actor_system_config& abstract_coordinator::config() const {
   return system_.config();
 }
 
+void abstract_coordinator::enqueue_all(const std::vector<resumable*>& jobs) {
+  for (auto job : jobs)
+    enqueue(job);
+}
+
 bool abstract_coordinator::detaches_utility_actors() const {
   return true;
 }
@@ -18,6 +18,8 @@
 
 #include "caf/actor_clock.hpp"
 
+#include "caf/message_id.hpp"
+
 namespace caf {
 
 // -- constructors, destructors, and assignment operators ----------------------
@@ -38,4 +40,12 @@ actor_clock::difference(atom_value, long, time_point t0,
   return t1 - t0;
 }
 
+// -- modifiers ----------------------------------------------------------------
+
+void actor_clock::cancel_request_timeouts(abstract_actor* self,
+                                          const std::vector<message_id>& ids) {
+  for (auto id : ids)
+    cancel_request_timeout(self, id);
+}
+
 } // namespace caf
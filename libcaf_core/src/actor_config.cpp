@@ -25,7 +25,9 @@ namespace caf {
 actor_config::actor_config(execution_unit* ptr)
   : host(ptr),
     flags(abstract_channel::is_abstract_actor_flag),
-    groups(nullptr) {
+    groups(nullptr),
+    max_throughput(0),
+    throughput_budget(0) {
   // nop
 }
 
@@ -20,6 +20,7 @@
 
 #include <mutex>
 #include <limits>
+#include <algorithm>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
@@ -55,9 +56,10 @@ actor_registry::actor_registry(actor_system& sys) : running_(0), system_(sys) {
 }
 
 strong_actor_ptr actor_registry::get_impl(actor_id key) const {
-  shared_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end())
+  auto& s = shard_of(key);
+  shared_guard guard(s.mtx);
+  auto i = s.data.find(key);
+  if (i != s.data.end())
     return i->second;
   CAF_LOG_DEBUG("key invalid, assume actor no longer exists:" << CAF_ARG(key));
   return nullptr;
@@ -68,11 +70,47 @@ void actor_registry::put_impl(actor_id key, strong_actor_ptr val) {
   if (!val)
     return;
   { // lifetime scope of guard
-    exclusive_guard guard(instances_mtx_);
-    if (!entries_.emplace(key, val).second)
+    auto& s = shard_of(key);
+    exclusive_guard guard(s.mtx);
+    if (!s.data.emplace(key, val).second)
       return;
   }
   // attach functor without lock
+  attach_erase_functor(key, val);
+}
+
+void actor_registry::put_all_impl(std::vector<strong_actor_ptr> xs) {
+  CAF_LOG_TRACE(CAF_ARG2("num-actors", xs.size()));
+  auto valid = [](const strong_actor_ptr& x) { return x != nullptr; };
+  xs.erase(std::partition(xs.begin(), xs.end(), valid), xs.end());
+  // Group actors by shard to acquire each lock only once.
+  auto shard_id = [](const strong_actor_ptr& x) {
+    return shards::index_of(x->id());
+  };
+  std::sort(xs.begin(), xs.end(),
+            [&](const strong_actor_ptr& x, const strong_actor_ptr& y) {
+              return shard_id(x) < shard_id(y);
+            });
+  std::vector<strong_actor_ptr> added;
+  added.reserve(xs.size());
+  auto i = xs.begin();
+  while (i != xs.end()) {
+    auto& s = shards_[shard_id(*i)];
+    exclusive_guard guard{s.mtx};
+    do {
+      auto key = (*i)->id();
+      if (s.data.emplace(key, *i).second)
+        added.emplace_back(std::move(*i));
+      ++i;
+    } while (i != xs.end() && &shard_of((*i)->id()) == &s);
+  }
+  // attach functors without lock
+  for (auto& x : added)
+    attach_erase_functor(x->id(), x);
+}
+
+void actor_registry::attach_erase_functor(actor_id key,
+                                          const strong_actor_ptr& val) {
   CAF_LOG_DEBUG("added actor:" << CAF_ARG(key));
   actor_registry* reg = this;
   val->get()->attach_functor([key, reg]() {
@@ -87,11 +125,12 @@ void actor_registry::erase(actor_id key) {
   // that in turn calls this function and we can end up in a deadlock.
   strong_actor_ptr ref;
   { // Lifetime scope of guard.
-    exclusive_guard guard{instances_mtx_};
-    auto i = entries_.find(key);
-    if (i != entries_.end()) {
+    auto& s = shard_of(key);
+    exclusive_guard guard{s.mtx};
+    auto i = s.data.find(key);
+    if (i != s.data.end()) {
       ref.swap(i->second);
-      entries_.erase(i);
+      s.data.erase(i);
     }
   }
 }
@@ -29,6 +29,8 @@
 
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
+#include "caf/policy/lock_free_work_stealing.hpp"
+#include "caf/policy/numa_work_stealing.hpp"
 
 #include "caf/scheduler/coordinator.hpp"
 #include "caf/scheduler/test_coordinator.hpp"
@@ -225,6 +227,8 @@ actor_system::actor_system(actor_system_config& cfg)
       cfg_(cfg),
       logger_dtor_done_(false) {
   CAF_SET_LOGGER_SYS(this);
+  types_.init_type_ids();
+  types_.init_message_factories();
   for (auto& hook : cfg.thread_hooks_)
     hook->init(*this);
   for (auto& f : cfg.module_factories) {
@@ -235,25 +239,39 @@ actor_system::actor_system(actor_system_config& cfg)
   using namespace scheduler;
   using policy::work_sharing;
   using policy::work_stealing;
+  using policy::lock_free_work_stealing;
+  using policy::numa_work_stealing;
   using share = coordinator<work_sharing>;
   using steal = coordinator<work_stealing>;
+  using lf_steal = coordinator<lock_free_work_stealing>;
+  using numa_steal = coordinator<numa_work_stealing>;
   using profiled_share = profiled_coordinator<policy::profiled<work_sharing>>;
   using profiled_steal = profiled_coordinator<policy::profiled<work_stealing>>;
+  using profiled_lf_steal
+    = profiled_coordinator<policy::profiled<lock_free_work_stealing>>;
+  using profiled_numa_steal
+    = profiled_coordinator<policy::profiled<numa_work_stealing>>;
   // set scheduler only if not explicitly loaded by user
   if (!sched) {
     enum sched_conf {
-      stealing          = 0x0001,
-      sharing           = 0x0002,
-      testing           = 0x0003,
-      profiled          = 0x0100,
-      profiled_stealing = 0x0101,
-      profiled_sharing  = 0x0102
+      stealing               = 0x0001,
+      sharing                = 0x0002,
+      testing                = 0x0003,
+      lf_stealing            = 0x0004,
+      numa_stealing          = 0x0005,
+      profiled               = 0x0100,
+      profiled_stealing      = 0x0101,
+      profiled_sharing       = 0x0102,
+      profiled_lf_stealing   = 0x0104,
+      profiled_numa_stealing = 0x0105
     };
     sched_conf sc = stealing;
     namespace sr = defaults::scheduler;
     auto sr_policy = get_or(cfg, "scheduler.policy", sr::policy);
     if (sr_policy == atom("sharing"))
       sc = sharing;
+    else if (sr_policy == atom("numa-steal"))
+      sc = numa_stealing;
     else if (sr_policy == atom("testing"))
       sc = testing;
     else if (sr_policy != atom("stealing"))
@@ -261,6 +279,17 @@ actor_system::actor_system(actor_system_config& cfg)
                 << " is an unrecognized scheduler pollicy, "
                    "falling back to 'stealing' (i.e. work-stealing)"
                 << std::endl;
+    if (sc == stealing) {
+      namespace ws = defaults::work_stealing;
+      auto queue_type = get_or(cfg, "work-stealing.queue-type", ws::queue_type);
+      if (queue_type == atom("lock-free"))
+        sc = lf_stealing;
+      else if (queue_type != atom("locking"))
+        std::cerr << "[WARNING] " << deep_to_string(queue_type)
+                  << " is an unrecognized work-stealing queue type, "
+                     "falling back to 'locking'"
+                  << std::endl;
+    }
     if (get_or(cfg, "scheduler.enable-profiling", false))
       sc = static_cast<sched_conf>(sc | profiled);
     switch (sc) {
@@ -270,12 +299,24 @@ actor_system::actor_system(actor_system_config& cfg)
       case sharing:
         sched.reset(new share(*this));
         break;
+      case lf_stealing:
+        sched.reset(new lf_steal(*this));
+        break;
+      case numa_stealing:
+        sched.reset(new numa_steal(*this));
+        break;
       case profiled_stealing:
         sched.reset(new profiled_steal(*this));
         break;
       case profiled_sharing:
         sched.reset(new profiled_share(*this));
         break;
+      case profiled_lf_stealing:
+        sched.reset(new profiled_lf_steal(*this));
+        break;
+      case profiled_numa_stealing:
+        sched.reset(new profiled_numa_steal(*this));
+        break;
       case testing:
         sched.reset(new test_coordinator(*this));
     }
@@ -371,6 +412,10 @@ std::string actor_system::render(const error& x) const {
   return to_string(x);
 }
 
+detail::memory_pool::statistics actor_system::allocation_stats() const {
+  return detail::memory_pool::stats();
+}
+
 group_manager& actor_system::groups() {
   return groups_;
 }
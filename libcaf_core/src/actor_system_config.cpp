@@ -76,13 +76,16 @@ actor_system_config::actor_system_config()
     .add<timespan>(stream_credit_round_interval, "credit-round-interval",
                    "time between emitting credit");
   opt_group{custom_options_, "scheduler"}
-    .add<atom_value>("policy", "'stealing' (default) or 'sharing'")
+    .add<atom_value>("policy",
+                     "'stealing' (default), 'numa-steal', or 'sharing'")
+    .add<atom_value>("clock", "'default' or 'wheel' (hierarchical timer wheel)")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput", "nr. of messages actors can consume per run")
     .add<bool>("enable-profiling", "enables profiler output")
     .add<timespan>("profiling-resolution", "data collection rate")
     .add<string>("profiling-output-file", "output file for the profiler");
   opt_group(custom_options_, "work-stealing")
+    .add<atom_value>("queue-type", "'locking' (default) or 'lock-free'")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
                  "frequency of aggressive steal attempts")
@@ -94,11 +97,16 @@ actor_system_config::actor_system_config()
     .add<size_t>("relaxed-steal-interval",
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+                   "sleep duration between relaxed steal attempts")
+    .add<bool>("pin-workers", "pins workers to CPUs ('numa-steal' only)")
+    .add<size_t>("remote-steal-threshold",
+                 "nr. of local steal misses before stealing from other "
+                 "NUMA nodes ('numa-steal' only)");
   opt_group{custom_options_, "logger"}
     .add<atom_value>("verbosity", "default verbosity for file and console")
     .add<string>("file-name", "filesystem path of the log file")
     .add<string>("file-format", "line format for individual log file entires")
+    .add<atom_value>("file-encoding", "log file encoding: text or binary")
     .add<atom_value>("file-verbosity", "file output verbosity")
     .add<atom_value>("console", "std::clog output: none, colored, or uncolored")
     .add<string>("console-format", "line format for printed log entires")
@@ -106,9 +114,12 @@ actor_system_config::actor_system_config()
     .add<std::vector<atom_value>>("component-blacklist",
                                   "excluded components for logging")
     .add<bool>("inline-output", "disable logger thread (for testing only!)");
+  opt_group{custom_options_, "groups"}
+    .add<size_t>("relay-fan-out",
+                 "nr. of nodes a node relays remote group messages to (0: off)");
   opt_group{custom_options_, "middleman"}
     .add<atom_value>("network-backend",
-                     "either 'default' or 'asio' (if available)")
+                     "either 'default' or 'uring' (if available)")
     .add<std::vector<string>>("app-identifiers",
                               "valid application identifiers of this node")
     .add<string>("app-identifier", "DEPRECATED: use app-identifiers instead")
@@ -126,7 +137,11 @@ actor_system_config::actor_system_config()
     .add<size_t>("max-pending-messages",
                  "maximum for reordering of UDP receive buffers (default: 10)")
     .add<bool>("disable-tcp", "disables communication via TCP")
-    .add<bool>("enable-udp", "enable communication via UDP");
+    .add<bool>("enable-udp", "enable communication via UDP")
+    .add<bool>("compact-type-ids",
+               "exchange type IDs at handshake to shrink BASP messages")
+    .add<size_t>("multiplexer-threads",
+                 "number of I/O threads for BASP connections (default: 1)");
   opt_group(custom_options_, "opencl")
     .add<std::vector<size_t>>("device-ids", "whitelist for OpenCL devices");
   opt_group(custom_options_, "openssl")
@@ -17,6 +17,8 @@
  ******************************************************************************/
 
 #include <utility>
+#include <iterator>
+#include <algorithm>
 
 #include "caf/detail/behavior_impl.hpp"
 
@@ -75,8 +77,17 @@ public:
   }
 };
 
+/// Minimum number of match cases for building a dispatch index.
+constexpr ptrdiff_t min_indexed_cases = 8;
+
 } // namespace <anonymous>
 
+bool behavior_impl::dispatch_key_less(const dispatch_entry& x,
+                                      const dispatch_entry& y) {
+  return x.type_token != y.type_token ? x.type_token < y.type_token
+                                      : x.leading_atom < y.leading_atom;
+}
+
 behavior_impl::~behavior_impl() {
   // nop
 }
@@ -97,16 +108,44 @@ behavior_impl::invoke_empty(detail::invoke_result_visitor& f) {
 match_case::result behavior_impl::invoke(detail::invoke_result_visitor& f,
                                          type_erased_tuple& xs) {
   auto msg_token = xs.type_token();
-  for (auto i = begin_; i != end_; ++i)
-    if (i->type_token == msg_token)
-      switch (i->ptr->invoke(f, xs)) {
-        case match_case::no_match:
-          break;
-        case match_case::match:
-          return match_case::match;
-        case match_case::skip:
-          return match_case::skip;
-      };
+  if (dispatch_index_.empty()) {
+    for (auto i = begin_; i != end_; ++i)
+      if (i->type_token == msg_token)
+        switch (i->ptr->invoke(f, xs)) {
+          case match_case::no_match:
+            break;
+          case match_case::match:
+            return match_case::match;
+          case match_case::skip:
+            return match_case::skip;
+        };
+    return match_case::no_match;
+  }
+  // Candidates are all cases for the type token that either accept any first
+  // element or expect the atom at the first position of `xs`.
+  auto candidates = [&](atom_value x) {
+    dispatch_entry key{msg_token, x, nullptr};
+    return std::equal_range(dispatch_index_.begin(), dispatch_index_.end(),
+                            key, dispatch_key_less);
+  };
+  auto any = candidates(match_case::no_leading_atom);
+  auto fixed = std::make_pair(dispatch_index_.end(), dispatch_index_.end());
+  if (!xs.empty() && xs.match_element<atom_value>(0)) {
+    auto x = xs.get_as<atom_value>(0);
+    if (x != match_case::no_leading_atom)
+      fixed = candidates(x);
+  }
+  // Merge both ranges by position to preserve first-match semantics.
+  auto i = any.first;
+  auto j = fixed.first;
+  while (i != any.second || j != fixed.second) {
+    auto& next = j == fixed.second || (i != any.second && i->ptr < j->ptr)
+                 ? *i++
+                 : *j++;
+    auto res = next.ptr->ptr->invoke(f, xs);
+    if (res != match_case::no_match)
+      return res;
+  }
   return match_case::no_match;
 }
 
@@ -136,6 +175,19 @@ match_case::result behavior_impl::invoke(detail::invoke_result_visitor& f,
   return invoke_empty(f);
 }
 
+void behavior_impl::build_dispatch_index() {
+  dispatch_index_.clear();
+  if (std::distance(begin_, end_) < min_indexed_cases)
+    return;
+  dispatch_index_.reserve(static_cast<size_t>(std::distance(begin_, end_)));
+  for (auto i = begin_; i != end_; ++i)
+    dispatch_index_.emplace_back(
+      dispatch_entry{i->type_token, i->ptr->leading_atom(), i});
+  // A stable sort keeps cases with equal keys in their original order.
+  std::stable_sort(dispatch_index_.begin(), dispatch_index_.end(),
+                   dispatch_key_less);
+}
+
 void behavior_impl::handle_timeout() {
   // nop
 }
@@ -0,0 +1,205 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/binary_log.hpp"
+
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <type_traits>
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+constexpr char magic[] = {'C', 'A', 'F', 'B', 'L', 'O', 'G', '\1'};
+
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+} // namespace <anonymous>
+
+// -- binary_log_writer --------------------------------------------------------
+
+size_t binary_log_writer::location_hash::
+operator()(const location_key& x) const noexcept {
+  auto h = std::hash<const char*>{}(x.fun);
+  h ^= std::hash<const char*>{}(x.file) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h ^ (x.line * 31);
+}
+
+binary_log_writer::binary_log_writer(std::ostream& out) : out_(out) {
+  // nop
+}
+
+void binary_log_writer::write_header(timestamp t0) {
+  buf_.insert(buf_.end(), std::begin(magic), std::end(magic));
+  append(byte_order_mark);
+  append(t0.time_since_epoch().count());
+  flush();
+}
+
+void binary_log_writer::write(const logger::event& x) {
+  auto loc = location_id(x);
+  auto tid = thread_id(x.tid);
+  append(binary_log_record::event);
+  append(x.tstamp.time_since_epoch().count());
+  append(tid);
+  append(x.aid);
+  append(static_cast<uint64_t>(x.category_name));
+  append(static_cast<uint8_t>(x.level));
+  append(loc);
+  append(string_view{x.message});
+  flush();
+}
+
+uint32_t binary_log_writer::location_id(const logger::event& x) {
+  location_key key{x.file_name.data(), x.pretty_fun.data(), x.line_number};
+  auto i = locations_.find(key);
+  if (i != locations_.end())
+    return i->second;
+  auto id = static_cast<uint32_t>(locations_.size());
+  locations_.emplace(key, id);
+  append(binary_log_record::location);
+  append(id);
+  append(static_cast<uint32_t>(x.line_number));
+  append(x.file_name);
+  append(x.pretty_fun);
+  append(x.simple_fun);
+  return id;
+}
+
+uint32_t binary_log_writer::thread_id(std::thread::id x) {
+  auto i = threads_.find(x);
+  if (i != threads_.end())
+    return i->second;
+  auto id = static_cast<uint32_t>(threads_.size());
+  threads_.emplace(x, id);
+  std::ostringstream name;
+  name << x;
+  append(binary_log_record::thread);
+  append(id);
+  append(string_view{name.str()});
+  return id;
+}
+
+template <class T>
+void binary_log_writer::append(T x) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "can only append trivially copyable types");
+  auto first = reinterpret_cast<const char*>(&x);
+  buf_.insert(buf_.end(), first, first + sizeof(T));
+}
+
+void binary_log_writer::append(string_view x) {
+  append(static_cast<uint32_t>(x.size()));
+  buf_.insert(buf_.end(), x.begin(), x.end());
+}
+
+void binary_log_writer::flush() {
+  out_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+  buf_.clear();
+}
+
+// -- binary_log_reader --------------------------------------------------------
+
+binary_log_reader::binary_log_reader(std::istream& in) : in_(in) {
+  // nop
+}
+
+bool binary_log_reader::read_header() {
+  char buf[sizeof(magic)];
+  if (!in_.read(buf, sizeof(buf)) || memcmp(buf, magic, sizeof(magic)) != 0)
+    return false;
+  uint32_t bom;
+  timestamp::rep t0;
+  if (!consume(bom) || bom != byte_order_mark || !consume(t0))
+    return false;
+  t0_ = timestamp{timespan{t0}};
+  return true;
+}
+
+bool binary_log_reader::read(logger::event& x, std::string& thread_name) {
+  binary_log_record type;
+  while (consume(type)) {
+    switch (type) {
+      case binary_log_record::location: {
+        uint32_t id;
+        location loc;
+        if (!consume(id) || id != locations_.size() || !consume(loc.line)
+            || !consume(loc.file) || !consume(loc.pretty_fun)
+            || !consume(loc.simple_fun))
+          return false;
+        locations_.emplace_back(std::move(loc));
+        break;
+      }
+      case binary_log_record::thread: {
+        uint32_t id;
+        std::string name;
+        if (!consume(id) || id != threads_.size() || !consume(name))
+          return false;
+        threads_.emplace_back(std::move(name));
+        break;
+      }
+      case binary_log_record::event: {
+        timestamp::rep ts;
+        uint32_t tid;
+        uint64_t component;
+        uint8_t level;
+        uint32_t loc;
+        if (!consume(ts) || !consume(tid) || tid >= threads_.size()
+            || !consume(x.aid) || !consume(component) || !consume(level)
+            || !consume(loc) || loc >= locations_.size()
+            || !consume(x.message))
+          return false;
+        auto& l = locations_[loc];
+        x.level = level;
+        x.line_number = l.line;
+        x.category_name = static_cast<atom_value>(component);
+        x.pretty_fun = l.pretty_fun;
+        x.simple_fun = l.simple_fun;
+        x.file_name = l.file;
+        x.tid = std::thread::id{};
+        x.tstamp = timestamp{timespan{ts}};
+        thread_name = threads_[tid];
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+template <class T>
+bool binary_log_reader::consume(T& x) {
+  return static_cast<bool>(in_.read(reinterpret_cast<char*>(&x), sizeof(T)));
+}
+
+bool binary_log_reader::consume(std::string& x) {
+  uint32_t size;
+  if (!consume(size))
+    return false;
+  x.resize(size);
+  return size == 0 || static_cast<bool>(in_.read(&x[0], size));
+}
+
+} // namespace detail
+} // namespace caf
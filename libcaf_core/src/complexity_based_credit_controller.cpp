@@ -0,0 +1,69 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/complexity_based_credit_controller.hpp"
+
+#include <limits>
+
+#include "caf/detail/scope_guard.hpp"
+
+namespace caf {
+namespace detail {
+
+complexity_based_credit_controller::complexity_based_credit_controller(
+  actor_clock& clock)
+    : super(clock) {
+  // nop
+}
+
+complexity_based_credit_controller::~complexity_based_credit_controller() {
+  // nop
+}
+
+void complexity_based_credit_controller::before_processing(
+  downstream_msg::batch&) {
+  t0_ = clock().now();
+}
+
+void complexity_based_credit_controller::after_processing(
+  downstream_msg::batch& x) {
+  auto t1 = clock().now();
+  auto dt = clock().difference(atom("batch"), x.xs_size, t0_, t1);
+  stats_.store({x.xs_size, dt});
+}
+
+credit_controller::assignment
+complexity_based_credit_controller::compute_initial() {
+  return {inbound_path::initial_credit, inbound_path::initial_credit};
+}
+
+credit_controller::assignment
+complexity_based_credit_controller::compute(const cycle_info& x) {
+  auto guard = make_scope_guard([&] { stats_.reset(); });
+  auto y = stats_.calculate(x.cycle, x.desired_batch_complexity);
+  // Hand out enough credit to fill our queue for 2 cycles.
+  static constexpr auto upper_bound = std::numeric_limits<int32_t>::max() / 2;
+  auto credit = y.max_throughput > upper_bound
+                ? std::numeric_limits<int32_t>::max()
+                : y.max_throughput * 2;
+  return {credit, y.items_per_batch};
+}
+
+} // namespace detail
+} // namespace caf
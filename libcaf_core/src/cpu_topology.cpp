@@ -0,0 +1,221 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifdef CAF_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif // CAF_LINUX
+
+#include "caf/string_algorithms.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+#ifdef CAF_LINUX
+
+bool read_first_line(const std::string& path, std::string& result) {
+  std::ifstream in{path};
+  return static_cast<bool>(std::getline(in, result));
+}
+
+// Returns the CPUs this process may run on.
+std::vector<int> allowed_cpus() {
+  std::vector<int> result;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    return result;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &set))
+      result.push_back(cpu);
+  return result;
+}
+
+// Groups `cpus` by the sets found at `path_of(cpu)`, which must point to a
+// sysfs file containing a CPU list.
+template <class F>
+std::vector<std::vector<int>> group_cpus(const std::vector<int>& cpus,
+                                         F path_of) {
+  std::vector<std::vector<int>> result;
+  std::vector<int> unassigned = cpus;
+  std::string line;
+  while (!unassigned.empty()) {
+    if (!read_first_line(path_of(unassigned.front()), line))
+      return {};
+    auto members = parse_cpu_list(line);
+    std::vector<int> domain;
+    for (auto cpu : members) {
+      auto i = std::find(unassigned.begin(), unassigned.end(), cpu);
+      if (i != unassigned.end()) {
+        domain.push_back(cpu);
+        unassigned.erase(i);
+      }
+    }
+    // A sibling list that doesn't contain the CPU itself is corrupted.
+    if (domain.empty())
+      return {};
+    result.emplace_back(std::move(domain));
+  }
+  return result;
+}
+
+std::vector<std::vector<int>> numa_domains(const std::vector<int>& cpus) {
+  std::vector<std::vector<int>> result;
+  std::string line;
+  // Node IDs may have gaps, e.g., after taking nodes offline. The sysfs lists
+  // the IDs of all online nodes in the same format as CPU lists.
+  if (!read_first_line("/sys/devices/system/node/online", line))
+    return result;
+  for (auto node : parse_cpu_list(line)) {
+    auto path = "/sys/devices/system/node/node" + std::to_string(node)
+                + "/cpulist";
+    std::string cpus_line;
+    if (!read_first_line(path, cpus_line))
+      continue;
+    std::vector<int> domain;
+    for (auto cpu : parse_cpu_list(cpus_line))
+      if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end())
+        domain.push_back(cpu);
+    if (!domain.empty())
+      result.emplace_back(std::move(domain));
+  }
+  return result;
+}
+
+std::vector<std::vector<int>> l3_domains(const std::vector<int>& cpus) {
+  return group_cpus(cpus, [](int cpu) {
+    return "/sys/devices/system/cpu/cpu" + std::to_string(cpu)
+           + "/cache/index3/shared_cpu_list";
+  });
+}
+
+#endif // CAF_LINUX
+
+} // namespace <anonymous>
+
+size_t cpu_topology::domain_of(int cpu) const {
+  for (size_t i = 0; i < domains.size(); ++i) {
+    auto& xs = domains[i];
+    if (std::find(xs.begin(), xs.end(), cpu) != xs.end())
+      return i;
+  }
+  return 0;
+}
+
+size_t cpu_topology::num_cpus() const {
+  size_t result = 0;
+  for (auto& xs : domains)
+    result += xs.size();
+  return result;
+}
+
+cpu_topology cpu_topology::detect() {
+  cpu_topology result;
+#ifdef CAF_LINUX
+  auto cpus = allowed_cpus();
+  if (!cpus.empty()) {
+    result.domains = numa_domains(cpus);
+    if (result.domains.size() < 2) {
+      auto l3 = l3_domains(cpus);
+      if (!l3.empty())
+        result.domains = std::move(l3);
+    }
+    // Fall back to a single domain if sysfs was incomplete.
+    if (result.num_cpus() != cpus.size())
+      result.domains.assign(1, std::move(cpus));
+    return result;
+  }
+#endif // CAF_LINUX
+  std::vector<int> all_cpus;
+  auto n = std::max(std::thread::hardware_concurrency(), 1u);
+  for (unsigned i = 0; i < n; ++i)
+    all_cpus.push_back(static_cast<int>(i));
+  result.domains.emplace_back(std::move(all_cpus));
+  return result;
+}
+
+std::vector<int> parse_cpu_list(string_view str) {
+  std::vector<int> result;
+  std::vector<std::string> ranges;
+  split(ranges, str, ',', token_compress_on);
+  auto parse_int = [](const std::string& x, int& dst) {
+    if (x.empty() || !std::all_of(x.begin(), x.end(), ::isdigit))
+      return false;
+    dst = std::atoi(x.c_str());
+    return true;
+  };
+  for (auto& range : ranges) {
+    std::vector<std::string> bounds;
+    split(bounds, range, '-');
+    int first = 0;
+    int last = 0;
+    if (bounds.size() == 1) {
+      if (!parse_int(bounds[0], first))
+        return {};
+      last = first;
+    } else if (bounds.size() == 2) {
+      if (!parse_int(bounds[0], first) || !parse_int(bounds[1], last)
+          || last < first)
+        return {};
+    } else {
+      return {};
+    }
+    for (auto cpu = first; cpu <= last; ++cpu)
+      result.push_back(cpu);
+  }
+  return result;
+}
+
+bool pin_this_thread(int cpu) {
+#ifdef CAF_LINUX
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else // CAF_LINUX
+  CAF_IGNORE_UNUSED(cpu);
+  return false;
+#endif // CAF_LINUX
+}
+
+int current_cpu() {
+#ifdef CAF_LINUX
+  return sched_getcpu();
+#else // CAF_LINUX
+  return -1;
+#endif // CAF_LINUX
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,61 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/credit_controller.hpp"
+
+#include "caf/inbound_path.hpp"
+#include "caf/scheduled_actor.hpp"
+
+#include "caf/detail/complexity_based_credit_controller.hpp"
+#include "caf/detail/fixed_credit_controller.hpp"
+#include "caf/detail/latency_aware_credit_controller.hpp"
+
+namespace caf {
+
+credit_controller::credit_controller(actor_clock& clock) : clock_(clock) {
+  // nop
+}
+
+credit_controller::~credit_controller() {
+  // nop
+}
+
+credit_controller_factory complexity_based_credit() {
+  return [](inbound_path* path) {
+    using impl = detail::complexity_based_credit_controller;
+    return credit_controller_ptr{new impl(path->mgr->self()->clock())};
+  };
+}
+
+credit_controller_factory latency_aware_credit() {
+  return [](inbound_path* path) {
+    using impl = detail::latency_aware_credit_controller;
+    return credit_controller_ptr{new impl(path->mgr->self()->clock())};
+  };
+}
+
+credit_controller_factory fixed_credit(int32_t credit, int32_t batch_size) {
+  return [=](inbound_path* path) {
+    using impl = detail::fixed_credit_controller;
+    return credit_controller_ptr{
+      new impl(path->mgr->self()->clock(), credit, batch_size)};
+  };
+}
+
+} // namespace caf
@@ -53,6 +53,7 @@ const timespan credit_round_interval = ms(10);
 namespace scheduler {
 
 const atom_value policy = atom("stealing");
+const atom_value clock = atom("default");
 string_view profiling_output_file = "";
 const size_t max_threads = std::max(std::thread::hardware_concurrency(), 4u);
 const size_t max_throughput = std::numeric_limits<size_t>::max();
@@ -62,6 +63,7 @@ const timespan profiling_resolution = ms(100);
 
 namespace work_stealing {
 
+const atom_value queue_type = atom("locking");
 const size_t aggressive_poll_attempts = 100;
 const size_t aggressive_steal_interval = 10;
 const size_t moderate_poll_attempts = 500;
@@ -69,6 +71,8 @@ const size_t moderate_steal_interval = 5;
 const timespan moderate_sleep_duration = us(50);
 const size_t relaxed_steal_interval = 1;
 const timespan relaxed_sleep_duration = ms(10);
+const bool pin_workers = true;
+const size_t remote_steal_threshold = 4;
 
 } // namespace work_stealing
 
@@ -78,12 +82,19 @@ string_view component_filter = "";
 const atom_value console = atom("none");
 string_view console_format = "%m";
 const atom_value console_verbosity = atom("trace");
+const atom_value file_encoding = atom("text");
 string_view file_format = "%r %c %p %a %t %C %M %F:%L %m%n";
 string_view file_name = "actor_log_[PID]_[TIMESTAMP]_[NODE].log";
 const atom_value file_verbosity = atom("trace");
 
 } // namespace logger
 
+namespace groups {
+
+const size_t relay_fan_out = 0;
+
+} // namespace groups
+
 namespace middleman {
 
 std::vector<std::string> app_identifiers{"generic-caf-app"};
@@ -92,6 +103,8 @@ const size_t max_consecutive_reads = 50;
 const size_t heartbeat_interval = 0;
 const size_t cached_udp_buffers = 10;
 const size_t max_pending_msgs = 10;
+const bool compact_type_ids = false;
+const size_t multiplexer_threads = 1;
 
 } // namespace middleman
 
@@ -30,4 +30,9 @@ execution_unit::~execution_unit() {
   // nop
 }
 
+void execution_unit::exec_later_all(const std::vector<resumable*>& ptrs) {
+  for (auto ptr : ptrs)
+    exec_later(ptr);
+}
+
 } // namespace caf
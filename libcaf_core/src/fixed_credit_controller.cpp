@@ -0,0 +1,58 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/fixed_credit_controller.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+fixed_credit_controller::fixed_credit_controller(actor_clock& clock,
+                                                 int32_t credit,
+                                                 int32_t batch_size)
+    : super(clock),
+      value_{credit, batch_size} {
+  CAF_ASSERT(credit > 0);
+  CAF_ASSERT(batch_size > 0);
+}
+
+fixed_credit_controller::~fixed_credit_controller() {
+  // nop
+}
+
+void fixed_credit_controller::before_processing(downstream_msg::batch&) {
+  // nop
+}
+
+void fixed_credit_controller::after_processing(downstream_msg::batch&) {
+  // nop
+}
+
+credit_controller::assignment fixed_credit_controller::compute_initial() {
+  return value_;
+}
+
+credit_controller::assignment
+fixed_credit_controller::compute(const cycle_info&) {
+  return value_;
+}
+
+} // namespace detail
+} // namespace caf
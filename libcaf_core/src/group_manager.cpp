@@ -31,6 +31,9 @@
 #include "caf/deserializer.hpp"
 #include "caf/event_based_actor.hpp"
 
+#include "caf/detail/batched_execution_unit.hpp"
+#include "caf/detail/relay_tree.hpp"
+
 #include "caf/group_manager.hpp"
 
 namespace caf {
@@ -42,6 +45,9 @@ using shared_guard = shared_lock<detail::shared_spinlock>;
 using upgrade_guard = upgrade_lock<detail::shared_spinlock>;
 using upgrade_to_unique_guard = upgrade_to_unique_lock<detail::shared_spinlock>;
 
+/// Tells a proxy broker to forward group messages to the given proxy brokers.
+using relay_atom = atom_constant<atom("relay")>;
+
 class local_broker;
 class local_group_module;
 
@@ -64,9 +70,18 @@ public:
   void send_all_subscribers(const strong_actor_ptr& sender, const message& msg,
                             execution_unit* host) {
     CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(msg));
-    shared_guard guard(mtx_);
-    for (auto& s : subscribers_)
-      s->enqueue(sender, make_message_id(), msg, host);
+    // Collect all subscribers that become ready and schedule them at once
+    // instead of waking up a worker per subscriber.
+    detail::batched_execution_unit ctx{&system(), host};
+    { // Lifetime scope of guard.
+      shared_guard guard(mtx_);
+      auto xs = make_mailbox_elements(subscribers_.size(), sender,
+                                      make_message_id(), msg);
+      auto i = xs.begin();
+      for (auto& s : subscribers_)
+        s->enqueue(std::move(*i++), &ctx);
+    }
+    ctx.flush();
   }
 
   void enqueue(strong_actor_ptr sender, message_id, message msg,
@@ -160,6 +175,9 @@ public:
 
   behavior make_behavior() override {
     CAF_LOG_TRACE("");
+    acquaintances_ = relay_tree{get_or(system().config(),
+                                       "groups.relay-fan-out",
+                                       defaults::groups::relay_fan_out)};
     // instead of dropping "unexpected" messages,
     // we simply forward them to our acquaintances
     auto fwd = [=](scheduled_actor*, message_view& x) -> result<message> {
@@ -169,27 +187,42 @@ public:
     set_default_handler(fwd);
     set_down_handler([=](down_msg& dm) {
       CAF_LOG_TRACE(CAF_ARG(dm));
-      auto first = acquaintances_.begin();
-      auto last = acquaintances_.end();
-      auto i = std::find_if(first, last, [&](const actor& a) {
+      auto& xs = acquaintances_.peers();
+      auto i = std::find_if(xs.begin(), xs.end(), [&](const actor& a) {
         return a == dm.source;
       });
-      if (i != last)
-        acquaintances_.erase(i);
+      if (i != xs.end()) {
+        acquaintances_.remove(actor{*i});
+        sync_acquaintances();
+      }
     });
     // return behavior
     return {
       [=](join_atom, const actor& other) {
         CAF_LOG_TRACE(CAF_ARG(other));
-        if (acquaintances_.insert(other).second) {
-          monitor(other);
+        if (acquaintances_.contains(other))
+          return;
+        // Each node receives only one copy of each message. Hence, a new
+        // proxy broker replaces any previous one from the same node.
+        auto& xs = acquaintances_.peers();
+        auto i = std::find_if(xs.begin(), xs.end(), [&](const actor& a) {
+          return a.node() == other.node();
+        });
+        if (i != xs.end()) {
+          auto previous = *i;
+          acquaintances_.remove(previous);
+          demonitor(previous);
         }
+        acquaintances_.add(other);
+        monitor(other);
+        sync_acquaintances();
       },
       [=](leave_atom, const actor& other) {
         CAF_LOG_TRACE(CAF_ARG(other));
-        acquaintances_.erase(other);
-        if (acquaintances_.erase(other) > 0)
+        if (acquaintances_.remove(other)) {
           demonitor(other);
+          sync_acquaintances();
+        }
       },
       [=](forward_atom, const message& what) {
         CAF_LOG_TRACE(CAF_ARG(what));
@@ -202,17 +235,27 @@ public:
   }
 
 private:
+  using relay_tree = detail::relay_tree<actor>;
+
   void send_to_acquaintances(const message& what) {
-    // send to all remote subscribers
+    // send to all remote subscribers, which relay to the remaining ones
     auto src = current_element_->sender;
-    CAF_LOG_DEBUG(CAF_ARG(acquaintances_.size())
+    CAF_LOG_DEBUG(CAF_ARG2("acquaintances", acquaintances_.size())
                   << CAF_ARG(src) << CAF_ARG(what));
-    for (auto& acquaintance : acquaintances_)
+    acquaintances_.for_each_root([&](const actor& acquaintance) {
       acquaintance->enqueue(src, make_message_id(), what, context());
+    });
+  }
+
+  // Tells each acquaintance with changed children where to relay messages.
+  void sync_acquaintances() {
+    acquaintances_.sync([&](const actor& x, const std::vector<actor>& xs) {
+      send(x, relay_atom::value, xs);
+    });
   }
 
   local_group_ptr group_;
-  std::set<actor> acquaintances_;
+  relay_tree acquaintances_;
 };
 
 // Send a join message to the original group if a proxy
@@ -234,11 +277,13 @@ public:
   behavior make_behavior() override;
 
   void on_exit() override {
+    children_.clear();
     group_.reset();
   }
 
 private:
   local_group_proxy_ptr group_;
+  std::vector<actor> children_;
 };
 
 class local_group_proxy : public local_group {
@@ -315,15 +360,23 @@ behavior proxy_broker::make_behavior() {
   // instead of dropping "unexpected" messages,
   // we simply forward them to our acquaintances
   auto fwd = [=](local_actor*, message_view& x) -> result<message> {
-    group_->send_all_subscribers(current_element_->sender,
-                                 x.move_content_to_message(), context());
+    auto& src = current_element_->sender;
+    auto msg = x.move_content_to_message();
+    group_->send_all_subscribers(src, msg, context());
+    // relay to other nodes as instructed by the origin broker
+    for (auto& child : children_)
+      child->enqueue(src, make_message_id(), msg, context());
     return message{};
   };
   set_default_handler(fwd);
-  // return dummy behavior
   return {
-    [] {
-      // nop
+    [=](relay_atom, std::vector<actor>& xs) -> result<message> {
+      CAF_LOG_TRACE(CAF_ARG(xs));
+      if (current_element_->sender
+          != actor_cast<strong_actor_ptr>(group_->broker()))
+        return fwd(this, *current_element_);
+      children_.swap(xs);
+      return message{};
     }
   };
 }
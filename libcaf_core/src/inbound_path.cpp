@@ -23,6 +23,8 @@
 #include "caf/no_stages.hpp"
 #include "caf/scheduled_actor.hpp"
 
+#include "caf/detail/complexity_based_credit_controller.hpp"
+
 namespace caf {
 
 inbound_path::stats_t::stats_t() : num_elements(0), processing_time(0) {
@@ -76,6 +78,11 @@ inbound_path::inbound_path(stream_manager_ptr mgr_ptr, stream_slots id,
       last_acked_batch_id(0),
       last_batch_id(0) {
   CAF_IGNORE_UNUSED(in_type);
+  auto& factory = mgr->credit_policy();
+  if (factory)
+    controller_ = factory(this);
+  else
+    controller_.reset(new detail::complexity_based_credit_controller(clock()));
   mgr->register_input_path(this);
   CAF_STREAM_LOG_DEBUG(mgr->self()->name()
                        << "opens input stream with element type"
@@ -89,10 +96,8 @@ inbound_path::~inbound_path() {
 
 void inbound_path::handle(downstream_msg::batch& x) {
   CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(x));
-  auto& clk = clock();
   auto batch_size = x.xs_size;
   last_batch_id = x.id;
-  auto t0 = clk.now();
   CAF_STREAM_LOG_DEBUG(mgr->self()->name() << "handles batch of size"
                        << batch_size << "on slot" << slots.receiver << "with"
                        << assigned_credit << "assigned credit");
@@ -103,24 +108,25 @@ void inbound_path::handle(downstream_msg::batch& x) {
     CAF_STREAM_LOG_DEBUG_IF(next_credit_decision.time_since_epoch().count() > 0,
                             mgr->self()->name() << "ran out of credit at slot"
                             << slots.receiver << "with approx."
-                            << (next_credit_decision - t0)
+                            << (next_credit_decision - clock().now())
                             << "until next cycle");
   } else {
     assigned_credit -= batch_size;
     CAF_ASSERT(assigned_credit >= 0);
   }
+  controller_->before_processing(x);
   mgr->handle(this, x);
-  auto t1 = clk.now();
-  auto dt = clk.difference(atom("batch"), batch_size, t0, t1);
-  stats.store({batch_size, dt});
+  controller_->after_processing(x);
   mgr->push();
 }
 
 void inbound_path::emit_ack_open(local_actor* self, actor_addr rebind_from) {
   CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(rebind_from));
   // Update state.
-  assigned_credit = mgr->acquire_credit(this, initial_credit);
+  auto initial = controller_->compute_initial();
+  assigned_credit = mgr->acquire_credit(this, initial.credit);
   CAF_ASSERT(assigned_credit >= 0);
+  desired_batch_size = initial.batch_size;
   // Make sure we receive errors from this point on.
   stream_aborter::add(hdl, self->address(), slots.receiver,
                       stream_aborter::source_aborter);
@@ -139,15 +145,13 @@ void inbound_path::emit_ack_batch(local_actor* self, int32_t queued_items,
   CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(queued_items)
                 << CAF_ARG(max_downstream_capacity) << CAF_ARG(cycle)
                 << CAF_ARG(complexity));
-  CAF_IGNORE_UNUSED(queued_items);
   // Update timestamps.
   last_credit_decision = now;
   next_credit_decision = now + cycle;
-  // Hand out enough credit to fill our queue for 2 cycles but never exceed
-  // the downstream capacity.
-  auto x = stats.calculate(cycle, complexity);
-  auto stats_guard = detail::make_scope_guard([&] { stats.reset(); });
-  auto max_capacity = std::min(x.max_throughput * 2, max_downstream_capacity);
+  // Ask the controller for credit but never exceed the downstream capacity.
+  auto x = controller_->compute({cycle, complexity, queued_items,
+                                 assigned_credit});
+  auto max_capacity = std::min(x.credit, max_downstream_capacity);
   CAF_ASSERT(max_capacity > 0);
   // Protect against overflow on `assigned_credit`.
   auto max_new_credit = std::numeric_limits<int32_t>::max() - assigned_credit;
@@ -159,9 +163,7 @@ void inbound_path::emit_ack_batch(local_actor* self, int32_t queued_items,
   credit = std::min(mgr->acquire_credit(this, credit), max_new_credit);
   CAF_STREAM_LOG_DEBUG(mgr->self()->name() << "grants" << credit
                        << "new credit at slot" << slots.receiver
-                       << "after receiving" << stats.num_elements
-                       << "elements that took" << stats.processing_time
-                       << CAF_ARG2("max_throughput", x.max_throughput)
+                       << CAF_ARG2("controller_credit", x.credit)
                        << CAF_ARG(max_downstream_capacity)
                        << CAF_ARG(assigned_credit));
   if (credit == 0 && up_to_date())
@@ -171,7 +173,7 @@ void inbound_path::emit_ack_batch(local_actor* self, int32_t queued_items,
                 << CAF_ARG(desired_batch_size));
   assigned_credit += credit;
   CAF_ASSERT(assigned_credit >= 0);
-  desired_batch_size = static_cast<int32_t>(x.items_per_batch);
+  desired_batch_size = x.batch_size;
   unsafe_send_as(self, hdl,
                  make<upstream_msg::ack_batch>(slots.invert(), self->address(),
                                                static_cast<int32_t>(credit),
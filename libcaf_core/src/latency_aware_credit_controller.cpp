@@ -0,0 +1,86 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/latency_aware_credit_controller.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "caf/detail/scope_guard.hpp"
+
+namespace caf {
+namespace detail {
+
+latency_aware_credit_controller::latency_aware_credit_controller(
+  actor_clock& clock)
+    : super(clock),
+      rtt_(0),
+      measuring_(false) {
+  // nop
+}
+
+latency_aware_credit_controller::~latency_aware_credit_controller() {
+  // nop
+}
+
+void latency_aware_credit_controller::before_processing(
+  downstream_msg::batch& x) {
+  super::before_processing(x);
+  if (measuring_) {
+    measuring_ = false;
+    auto sample = std::chrono::duration_cast<timespan>(t0_ - grant_time_);
+    // Exponentially weighted moving average with a smoothing factor of 1/8.
+    if (rtt_.count() == 0)
+      rtt_ = sample;
+    else
+      rtt_ += (sample - rtt_) / 8;
+  }
+}
+
+credit_controller::assignment
+latency_aware_credit_controller::compute_initial() {
+  grant_time_ = clock().now();
+  measuring_ = true;
+  return super::compute_initial();
+}
+
+credit_controller::assignment
+latency_aware_credit_controller::compute(const cycle_info& x) {
+  auto guard = make_scope_guard([&] { stats_.reset(); });
+  // The next batch after granting credit to a stalled source arrives one
+  // round trip later.
+  if (x.assigned_credit == 0) {
+    grant_time_ = clock().now();
+    measuring_ = true;
+  }
+  // Fill our queue for 2 cycles plus the time our credit travels to the
+  // source and its batches travel back.
+  auto y = stats_.calculate(x.cycle * 2 + rtt_, x.desired_batch_complexity);
+  // Items beyond one cycle of work only add latency. Withholding credit for
+  // them lets the mailbox drain before the source sends more.
+  auto per_cycle = stats_.calculate(x.cycle, x.desired_batch_complexity);
+  auto excess = x.queued_items - per_cycle.max_throughput;
+  auto credit = y.max_throughput;
+  if (excess > 0)
+    credit = std::max(credit - excess, 1);
+  return {credit, y.items_per_batch};
+}
+
+} // namespace detail
+} // namespace caf
@@ -33,6 +33,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/binary_log.hpp"
 #include "caf/detail/get_process_id.hpp"
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/set_thread_name.hpp"
@@ -188,6 +189,9 @@ string_view reduce_symbol(std::ostream& out, string_view symbol) {
   return symbol;
 }
 
+// Source for `logger::instance_id_`.
+std::atomic<uint64_t> next_instance_id{1};
+
 #if CAF_LOG_LEVEL >= 0
 
 #if defined(CAF_NO_THREAD_LOCAL)
@@ -250,7 +254,8 @@ logger::config::config()
       file_verbosity(CAF_LOG_LEVEL),
       console_verbosity(CAF_LOG_LEVEL),
       inline_output(false),
-      console_coloring(false) {
+      console_coloring(false),
+      binary_file(false) {
   // nop
 }
 
@@ -281,32 +286,32 @@ operator<<(const local_actor* self) {
 }
 
 logger::line_builder& logger::line_builder::operator<<(const std::string& str) {
-  return *this << str.c_str();
+  return *this << string_view{str};
 }
 
 logger::line_builder& logger::line_builder::operator<<(string_view str) {
-  if (!str_.empty() && str_.back() != ' ')
-    str_ += " ";
-  str_.insert(str_.end(), str.begin(), str.end());
+  put(text_element);
+  put_text(str);
   return *this;
 }
 
 logger::line_builder& logger::line_builder::operator<<(const char* str) {
-  if (!str_.empty() && str_.back() != ' ')
-    str_ += " ";
-  str_ += str;
-  return *this;
+  return *this << string_view{str, strlen(str)};
 }
 
 logger::line_builder& logger::line_builder::operator<<(char x) {
-  const char buf[] = {x, '\0'};
-  return *this << buf;
+  return *this << string_view{&x, 1};
 }
 
-std::string logger::line_builder::get() const {
+std::string logger::line_builder::get() {
   return std::move(str_);
 }
 
+void logger::line_builder::put_text(string_view x) {
+  put(static_cast<uint32_t>(x.size()));
+  str_.append(x.data(), x.size());
+}
+
 // returns the actor ID for the current thread
 actor_id logger::thread_local_aid() {
   shared_lock<detail::shared_spinlock> guard{aids_lock_};
@@ -334,10 +339,31 @@ actor_id logger::thread_local_aid(actor_id aid) {
 }
 
 void logger::log(event&& x) {
-  if (cfg_.inline_output)
+  if (cfg_.inline_output) {
     handle_event(x);
-  else
-    queue_.push_back(std::move(x));
+    emitted_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto& buf = local_buffer();
+  if (!buf.events.try_push(std::move(x))) {
+    buf.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Pairs with the fence in `run`: either we see the logger thread sleeping
+  // or the logger thread sees our event.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed)) {
+    std::unique_lock<std::mutex> guard{wakeup_mtx_};
+    wakeup_cv_.notify_one();
+  }
+}
+
+size_t logger::dropped_events() const {
+  std::unique_lock<std::mutex> guard{buffers_mtx_};
+  size_t result = 0;
+  for (auto& buf : buffers_)
+    result += buf->dropped.load(std::memory_order_relaxed);
+  return result;
 }
 
 void logger::set_current_actor_system(actor_system* x) {
@@ -358,7 +384,12 @@ bool logger::accepts(unsigned level, atom_value cname) {
                       [=](atom_value name) { return name == cname; });
 }
 
-logger::logger(actor_system& sys) : system_(sys) {
+logger::logger(actor_system& sys)
+    : system_(sys),
+      instance_id_(next_instance_id++),
+      emitted_(0),
+      done_(false),
+      sleeping_(false) {
   // nop
 }
 
@@ -393,6 +424,9 @@ void logger::init(actor_system_config& cfg) {
   console_format_ = parse_format(get_or(cfg,"logger.console-format",
                                         lg::console_format));
   // Set flags.
+  auto enc_atm = get_or(cfg, "logger.file-encoding", lg::file_encoding);
+  if (to_lowercase(enc_atm) == atom("binary"))
+    cfg_.binary_file = true;
   if (get_or(cfg, "logger.inline-output", false))
     cfg_.inline_output = true;
   auto con_atm = get_or(cfg, "logger.console", lg::console);
@@ -470,28 +504,48 @@ void logger::render_date(std::ostream& out, timestamp x) {
   out << deep_to_string(x);
 }
 
-void logger::render(std::ostream& out, const line_format& lf,
-                    const event& x) const {
-  for (auto& f : lf)
-    switch (f.kind) {
-      case category_field: out << to_string(x.category_name); break;
-      case class_name_field: render_fun_prefix(out, x); break;
-      case date_field: render_date(out, x.tstamp); break;
-      case file_field: out << x.file_name; break;
-      case line_field: out << x.line_number; break;
-      case message_field: out << x.message; break;
-      case method_field: render_fun_name(out, x); break;
-      case newline_field: out << std::endl; break;
-      case priority_field: out << log_level_name[x.level]; break;
-      case runtime_field: render_time_diff(out, t0_, x.tstamp); break;
-      case thread_field: out << x.tid; break;
-      case actor_field: out << "actor" << x.aid; break;
-      case percent_sign_field: out << '%'; break;
-      case plain_text_field: out << f.text; break;
+namespace {
+
+template <class ThreadPrinter>
+void render_impl(std::ostream& out, const logger::line_format& lf,
+                 const logger::event& x, timestamp t0, ThreadPrinter f) {
+  for (auto& fld : lf)
+    switch (fld.kind) {
+      case logger::category_field: out << to_string(x.category_name); break;
+      case logger::class_name_field: logger::render_fun_prefix(out, x); break;
+      case logger::date_field: logger::render_date(out, x.tstamp); break;
+      case logger::file_field: out << x.file_name; break;
+      case logger::line_field: out << x.line_number; break;
+      case logger::message_field:
+        out << logger::render_message(x.message);
+        break;
+      case logger::method_field: logger::render_fun_name(out, x); break;
+      case logger::newline_field: out << std::endl; break;
+      case logger::priority_field: out << log_level_name[x.level]; break;
+      case logger::runtime_field:
+        logger::render_time_diff(out, t0, x.tstamp);
+        break;
+      case logger::thread_field: f(out); break;
+      case logger::actor_field: out << "actor" << x.aid; break;
+      case logger::percent_sign_field: out << '%'; break;
+      case logger::plain_text_field: out << fld.text; break;
       default: ; // nop
     }
 }
 
+} // namespace <anonymous>
+
+void logger::render(std::ostream& out, const line_format& lf,
+                    const event& x) const {
+  render_impl(out, lf, x, t0_, [&](std::ostream& os) { os << x.tid; });
+}
+
+void logger::render_offline(std::ostream& out, const line_format& lf,
+                            const event& x, timestamp t0,
+                            string_view thread_name) {
+  render_impl(out, lf, x, t0, [&](std::ostream& os) { os << thread_name; });
+}
+
 logger::line_format logger::parse_format(const std::string& format_str) {
   std::vector<field> res;
   auto plain_text_first = format_str.begin();
@@ -544,31 +598,239 @@ string_view logger::skip_path(string_view path) {
   return path;
 }
 
+namespace {
+
+// Decodes messages of `logger::line_builder`.
+class message_reader {
+public:
+  explicit message_reader(string_view x) : x_(x), pos_(0) {
+    // nop
+  }
+
+  bool at_end() const noexcept {
+    return pos_ == x_.size();
+  }
+
+  template <class T>
+  bool read(T& x) {
+    if (x_.size() - pos_ < sizeof(T))
+      return false;
+    memcpy(&x, x_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool read(string_view& x) {
+    uint32_t size;
+    if (!read(size) || x_.size() - pos_ < size)
+      return false;
+    x = string_view{x_.data() + pos_, size};
+    pos_ += size;
+    return true;
+  }
+
+  // Renders the next value to `out`, using the same output as
+  // `deep_to_string` for the original value.
+  bool read_value(std::string& out) {
+    using lb = logger::line_builder;
+    uint8_t type;
+    if (!read(type))
+      return false;
+    switch (type) {
+      case lb::bool_type: {
+        uint8_t x;
+        if (!read(x))
+          return false;
+        out += deep_to_string(x != 0);
+        return true;
+      }
+      case lb::int_type:
+        return read_and_render<int64_t>(out);
+      case lb::uint_type:
+        return read_and_render<uint64_t>(out);
+      case lb::double_type:
+        return read_and_render<double>(out);
+      case lb::string_type: {
+        string_view x;
+        if (!read(x))
+          return false;
+        out += deep_to_string(std::string{x.begin(), x.end()});
+        return true;
+      }
+      case lb::atom_type: {
+        uint64_t x;
+        if (!read(x))
+          return false;
+        out += deep_to_string(static_cast<atom_value>(x));
+        return true;
+      }
+      case lb::text_type: {
+        string_view x;
+        if (!read(x))
+          return false;
+        out.insert(out.end(), x.begin(), x.end());
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+private:
+  template <class T>
+  bool read_and_render(std::string& out) {
+    T x;
+    if (!read(x))
+      return false;
+    out += deep_to_string(x);
+    return true;
+  }
+
+  string_view x_;
+  size_t pos_;
+};
+
+} // namespace <anonymous>
+
+std::string logger::render_message(string_view x) {
+  std::string result;
+  message_reader reader{x};
+  auto fallback = [&] {
+    return std::string{x.begin(), x.end()};
+  };
+  while (!reader.at_end()) {
+    uint8_t type;
+    string_view str;
+    reader.read(type);
+    switch (type) {
+      case line_builder::text_element:
+        if (!reader.read(str))
+          return fallback();
+        if (!result.empty() && result.back() != ' ')
+          result += ' ';
+        result.insert(result.end(), str.begin(), str.end());
+        break;
+      case line_builder::value_element:
+        if (!result.empty())
+          result += ' ';
+        if (!reader.read_value(result))
+          return fallback();
+        break;
+      case line_builder::arg_element:
+        if (!result.empty())
+          result += ' ';
+        if (!reader.read(str))
+          return fallback();
+        result.insert(result.end(), str.begin(), str.end());
+        result += " = ";
+        if (!reader.read_value(result))
+          return fallback();
+        break;
+      default:
+        return fallback();
+    }
+  }
+  return result;
+}
+
+logger::event_buffer& logger::local_buffer() {
+#ifdef CAF_NO_THREAD_LOCAL
+  return find_or_create_buffer();
+#else // CAF_NO_THREAD_LOCAL
+  // Caches the buffer for the last logger used by this thread.
+  struct cache_entry {
+    uint64_t owner;
+    event_buffer* buf;
+  };
+  static thread_local cache_entry cache{0, nullptr};
+  if (cache.owner != instance_id_) {
+    cache.buf = &find_or_create_buffer();
+    cache.owner = instance_id_;
+  }
+  return *cache.buf;
+#endif // CAF_NO_THREAD_LOCAL
+}
+
+logger::event_buffer& logger::find_or_create_buffer() {
+  auto tid = std::this_thread::get_id();
+  std::unique_lock<std::mutex> guard{buffers_mtx_};
+  // Thread IDs of terminated threads may get reused. This is safe, because
+  // each buffer still has at most one producer at a time.
+  auto pred = [&](const std::unique_ptr<event_buffer>& x) {
+    return x->owner == tid;
+  };
+  auto i = std::find_if(buffers_.begin(), buffers_.end(), pred);
+  if (i != buffers_.end())
+    return **i;
+  buffers_.emplace_back(new event_buffer(tid));
+  return *buffers_.back();
+}
+
+void logger::collect(std::vector<event>& out) {
+  std::unique_lock<std::mutex> guard{buffers_mtx_};
+  for (auto& buf : buffers_)
+    buf->events.consume([&](event& x) { out.emplace_back(std::move(x)); });
+}
+
+bool logger::all_empty() const {
+  std::unique_lock<std::mutex> guard{buffers_mtx_};
+  return std::all_of(buffers_.begin(), buffers_.end(),
+                     [](const std::unique_ptr<event_buffer>& x) {
+                       return x->events.empty();
+                     });
+}
+
 void logger::run() {
-  // Bail out without printing anything if the first event we receive is the
-  // shutdown (empty) event.
-  queue_.wait_nonempty();
-  if (queue_.front().message.empty())
-    return;
-  log_first_line();
-  // Loop until receiving an empty message.
-  for (;;) {
-    // Handle current head of the queue.
-    auto& e = queue_.front();
-    if (e.message.empty()) {
-      log_last_line();
-      return;
+  std::vector<event> events;
+  auto by_timestamp = [](const event& x, const event& y) {
+    return x.tstamp < y.tstamp;
+  };
+  // Print the first line only after receiving the first event.
+  bool first = true;
+  // Emits all events currently stored in the buffers of all threads and
+  // returns whether there was at least one event.
+  auto drain = [&] {
+    collect(events);
+    if (events.empty())
+      return false;
+    // Restore the order between threads.
+    std::stable_sort(events.begin(), events.end(), by_timestamp);
+    if (first) {
+      log_first_line();
+      first = false;
     }
-    handle_event(e);
-    // Prepare next iteration.
-    queue_.pop_front();
-    queue_.wait_nonempty();
+    for (auto& e : events)
+      handle_event(e);
+    emitted_.fetch_add(events.size(), std::memory_order_relaxed);
+    events.clear();
+    return true;
+  };
+  for (;;) {
+    if (drain())
+      continue;
+    std::unique_lock<std::mutex> guard{wakeup_mtx_};
+    if (done_)
+      break;
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (all_empty())
+      wakeup_cv_.wait(guard);
+    sleeping_.store(false, std::memory_order_relaxed);
   }
+  // Producers may have logged events after our last call to `collect` but
+  // before `stop` has set `done_`.
+  drain();
+  if (!first)
+    log_last_line();
 }
 
 void logger::handle_file_event(const event& x) {
   // Print to file if available.
-  if (file_ && x.level <= file_verbosity())
+  if (!file_ || x.level > file_verbosity())
+    return;
+  if (binary_file_)
+    binary_file_->write(x);
+  else
     render(file_, file_format_, x);
 }
 
@@ -620,9 +882,14 @@ void logger::log_first_line() {
     return msg;
   };
   namespace lg = defaults::logger;
-  e.message = make_message("logger.file-verbosity", lg::file_verbosity);
+  auto encode = [](const std::string& str) {
+    return (line_builder{} << str).get();
+  };
+  e.message = encode(make_message("logger.file-verbosity",
+                                   lg::file_verbosity));
   handle_file_event(e);
-  e.message = make_message("logger.console-verbosity", lg::console_verbosity);
+  e.message = encode(make_message("logger.console-verbosity",
+                                  lg::console_verbosity));
   handle_console_event(e);
 }
 
@@ -663,11 +930,20 @@ void logger::start() {
       auto nid = to_string(system_.node());
       f.replace(i, i + sizeof(node) - 1, nid);
     }
-    file_.open(f, std::ios::out | std::ios::app);
+    if (cfg_.binary_file) {
+      // Binary logs start with a header, hence we cannot append to a file.
+      file_.open(f, std::ios::out | std::ios::trunc | std::ios::binary);
+    } else {
+      file_.open(f, std::ios::out | std::ios::app);
+    }
     if (!file_) {
       std::cerr << "unable to open log file " << f << std::endl;
       return;
     }
+    if (cfg_.binary_file) {
+      binary_file_.reset(new detail::binary_log_writer(file_));
+      binary_file_->write_header(t0_);
+    }
   }
   if (cfg_.inline_output)
     log_first_line();
@@ -687,8 +963,11 @@ void logger::stop() {
   }
   if (!thread_.joinable())
     return;
-  // A default-constructed event causes the logger to shutdown.
-  queue_.push_back(event{});
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{wakeup_mtx_};
+    done_ = true;
+    wakeup_cv_.notify_one();
+  }
   thread_.join();
 }
 
@@ -18,6 +18,8 @@
 
 #include "caf/mailbox_element.hpp"
 
+#include <new>
+
 #include "caf/message_builder.hpp"
 #include "caf/type_nr.hpp"
 
@@ -96,4 +98,34 @@ make_mailbox_element(strong_actor_ptr sender, message_id id,
   return mailbox_element_ptr{ptr};
 }
 
+std::vector<mailbox_element_ptr>
+make_mailbox_elements(size_t n, const strong_actor_ptr& sender, message_id id,
+                      const message& msg) {
+  std::vector<mailbox_element_ptr> result;
+  result.reserve(n);
+  auto make = [&](void* ptr) {
+    auto x = sender;
+    mailbox_element::forwarding_stack stages;
+    auto y = msg;
+    auto z = ::new (ptr) mailbox_element_wrapper(std::move(x), id,
+                                                 std::move(stages),
+                                                 std::move(y));
+    result.emplace_back(z);
+  };
+#ifdef CAF_ENABLE_MEMORY_POOL
+  static_assert(alignof(mailbox_element_wrapper)
+                  <= detail::memory_pool::alignment,
+                "the memory pool cannot align mailbox elements");
+  std::vector<void*> blocks(n);
+  detail::memory_pool::allocate(sizeof(mailbox_element_wrapper), n,
+                                blocks.data());
+  for (auto ptr : blocks)
+    make(ptr);
+#else
+  for (size_t i = 0; i < n; ++i)
+    make(::operator new(sizeof(mailbox_element_wrapper)));
+#endif
+  return result;
+}
+
 } // namespace caf
@@ -24,7 +24,15 @@ match_case::~match_case() {
   // nop
 }
 
-match_case::match_case(uint32_t tt) : token_(tt) {
+constexpr atom_value match_case::no_leading_atom;
+
+match_case::match_case(uint32_t tt) : match_case(tt, no_leading_atom) {
+  // nop
+}
+
+match_case::match_case(uint32_t tt, atom_value leading_atom)
+    : token_(tt),
+      leading_atom_(leading_atom) {
   // nop
 }
 
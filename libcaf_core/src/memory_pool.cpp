@@ -0,0 +1,418 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/memory_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace caf {
+namespace detail {
+
+constexpr size_t memory_pool::batch_size;
+
+constexpr size_t memory_pool::max_block_size;
+
+constexpr size_t memory_pool::alignment;
+
+#ifdef CAF_ENABLE_MEMORY_POOL
+
+namespace {
+
+// -- constants ----------------------------------------------------------------
+
+// Reserves space for the block header while keeping the payload aligned.
+// Chunks come from `malloc` and all strides are multiples of `header_size`.
+constexpr size_t header_size = 16;
+
+static_assert(header_size % memory_pool::alignment == 0,
+              "header_size breaks the alignment of blocks");
+
+// Size classes range from 32 bytes to `max_block_size`.
+constexpr size_t min_block_size = 32;
+
+constexpr size_t num_size_classes = 6;
+
+static_assert((min_block_size << (num_size_classes - 1))
+                == memory_pool::max_block_size,
+              "size classes do not match max_block_size");
+
+// Number of bytes the pool reserves from the heap at once.
+constexpr size_t chunk_size = 64 * 1024;
+
+// Number of pending batches a thread keeps for other threads.
+constexpr size_t num_pending_batches = 8;
+
+// -- data structures ----------------------------------------------------------
+
+struct cache;
+
+// Precedes each block. Blocks with `owner == nullptr` come from `malloc`.
+struct header {
+  cache* owner;
+  size_t size_class;
+};
+
+static_assert(sizeof(header) <= header_size, "header_size too small");
+
+// A counter that is only written by a single thread but read by any thread.
+class counter {
+public:
+  counter() : value_(0) {
+    // nop
+  }
+
+  void inc(uint64_t n = 1) {
+    value_.store(value_.load(std::memory_order_relaxed) + n,
+                 std::memory_order_relaxed);
+  }
+
+  uint64_t get() const {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> value_;
+};
+
+// Collects blocks of another thread before handing them back in one step.
+struct pending_batch {
+  cache* owner = nullptr;
+  header* head = nullptr;
+  header* tail = nullptr;
+  size_t size = 0;
+};
+
+// Thread-local state of the pool. Caches are never destroyed, because other
+// threads may still return blocks after the owning thread terminated.
+// Instead, terminated threads leave an orphaned cache that the next thread
+// using the pool adopts.
+struct cache {
+  cache() : remote(nullptr) {
+    free_lists.fill(nullptr);
+  }
+
+  // Available blocks for each size class, accessed only by the owner.
+  std::array<header*, num_size_classes> free_lists;
+
+  // Blocks returned by other threads.
+  std::atomic<header*> remote;
+
+  // Batches for other threads, accessed only by the owner.
+  std::array<pending_batch, num_pending_batches> pending;
+
+  // Statistics.
+  counter allocations;
+  counter deallocations;
+  counter remote_deallocations;
+  counter returned_batches;
+  counter heap_allocations;
+  counter reserved_bytes;
+};
+
+// Keeps track of all caches.
+struct registry {
+  std::mutex mtx;
+  std::vector<cache*> all;
+  std::vector<cache*> orphans;
+};
+
+registry& get_registry() {
+  // Intentionally leaked to allow threads to use the pool during static
+  // destruction.
+  static auto instance = new registry;
+  return *instance;
+}
+
+// -- utility functions --------------------------------------------------------
+
+size_t size_class_of(size_t size) {
+  size_t result = 0;
+  for (auto x = min_block_size; x < size; x <<= 1)
+    ++result;
+  return result;
+}
+
+size_t block_size_of(size_t size_class) {
+  return min_block_size << size_class;
+}
+
+header* header_of(void* ptr) {
+  return reinterpret_cast<header*>(static_cast<char*>(ptr) - header_size);
+}
+
+void* payload_of(header* ptr) {
+  return reinterpret_cast<char*>(ptr) + header_size;
+}
+
+// Free blocks store the pointer to their successor in their payload.
+header*& next_of(header* ptr) {
+  return *reinterpret_cast<header**>(payload_of(ptr));
+}
+
+void* heap_allocate(size_t size) {
+  auto ptr = static_cast<header*>(malloc(size + header_size));
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  ptr->owner = nullptr;
+  ptr->size_class = 0;
+  return payload_of(ptr);
+}
+
+void push_remote(cache* owner, header* head, header* tail) {
+  auto top = owner->remote.load(std::memory_order_relaxed);
+  do {
+    next_of(tail) = top;
+  } while (!owner->remote.compare_exchange_weak(top, head,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+void flush(cache* self, pending_batch& batch) {
+  if (batch.size > 0) {
+    push_remote(batch.owner, batch.head, batch.tail);
+    self->returned_batches.inc();
+  }
+  batch = pending_batch{};
+}
+
+// Moves all blocks returned by other threads into the free lists.
+void reclaim_remote(cache* self) {
+  auto ptr = self->remote.exchange(nullptr, std::memory_order_acquire);
+  while (ptr != nullptr) {
+    auto next = next_of(ptr);
+    auto& free_list = self->free_lists[ptr->size_class];
+    next_of(ptr) = free_list;
+    free_list = ptr;
+    ptr = next;
+  }
+}
+
+// Carves a new chunk of heap memory into blocks of the given size class.
+void refill(cache* self, size_t size_class) {
+  auto stride = block_size_of(size_class) + header_size;
+  auto chunk = static_cast<char*>(malloc(chunk_size));
+  if (chunk == nullptr)
+    throw std::bad_alloc();
+  self->reserved_bytes.inc(chunk_size);
+  auto& free_list = self->free_lists[size_class];
+  for (size_t offset = 0; offset + stride <= chunk_size; offset += stride) {
+    auto ptr = reinterpret_cast<header*>(chunk + offset);
+    ptr->owner = self;
+    ptr->size_class = size_class;
+    next_of(ptr) = free_list;
+    free_list = ptr;
+  }
+}
+
+cache* acquire_cache() {
+  auto& reg = get_registry();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  if (!reg.orphans.empty()) {
+    auto result = reg.orphans.back();
+    reg.orphans.pop_back();
+    return result;
+  }
+  auto result = new cache;
+  reg.all.emplace_back(result);
+  return result;
+}
+
+void release_cache(cache* ptr) {
+  for (auto& batch : ptr->pending)
+    flush(ptr, batch);
+  auto& reg = get_registry();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  reg.orphans.emplace_back(ptr);
+}
+
+// -- thread-local state -------------------------------------------------------
+
+// Both variables are trivially destructible and remain valid while other
+// thread-local objects get destroyed.
+thread_local cache* tl_cache;
+
+thread_local bool tl_cache_released;
+
+// Releases the cache of a thread when it terminates.
+struct cache_guard {
+  ~cache_guard() {
+    if (tl_cache != nullptr) {
+      release_cache(tl_cache);
+      tl_cache = nullptr;
+    }
+    tl_cache_released = true;
+  }
+};
+
+thread_local cache_guard tl_cache_guard;
+
+// Returns the cache of the calling thread or `nullptr` if the thread is
+// shutting down.
+cache* local_cache() {
+  if (tl_cache == nullptr && !tl_cache_released) {
+    // Touching the guard makes sure its destructor runs at thread exit.
+    static_cast<void>(&tl_cache_guard);
+    tl_cache = acquire_cache();
+  }
+  return tl_cache;
+}
+
+} // namespace <anonymous>
+
+void* memory_pool::allocate(size_t size) {
+  auto self = local_cache();
+  if (self == nullptr)
+    return heap_allocate(size);
+  self->allocations.inc();
+  if (size > max_block_size) {
+    self->heap_allocations.inc();
+    return heap_allocate(size);
+  }
+  auto size_class = size_class_of(size);
+  auto& free_list = self->free_lists[size_class];
+  if (free_list == nullptr) {
+    reclaim_remote(self);
+    if (free_list == nullptr)
+      refill(self, size_class);
+  }
+  auto result = free_list;
+  free_list = next_of(result);
+  return payload_of(result);
+}
+
+void memory_pool::allocate(size_t size, size_t n, void** out) {
+  auto self = local_cache();
+  if (self == nullptr) {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = heap_allocate(size);
+    return;
+  }
+  self->allocations.inc(n);
+  if (size > max_block_size) {
+    self->heap_allocations.inc(n);
+    for (size_t i = 0; i < n; ++i)
+      out[i] = heap_allocate(size);
+    return;
+  }
+  auto size_class = size_class_of(size);
+  auto& free_list = self->free_lists[size_class];
+  for (size_t i = 0; i < n; ++i) {
+    if (free_list == nullptr) {
+      reclaim_remote(self);
+      if (free_list == nullptr)
+        refill(self, size_class);
+    }
+    out[i] = payload_of(free_list);
+    free_list = next_of(free_list);
+  }
+}
+
+void memory_pool::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  auto hdr = header_of(ptr);
+  auto self = local_cache();
+  if (self != nullptr)
+    self->deallocations.inc();
+  if (hdr->owner == nullptr) {
+    free(hdr);
+    return;
+  }
+  if (hdr->owner == self) {
+    auto& free_list = self->free_lists[hdr->size_class];
+    next_of(hdr) = free_list;
+    free_list = hdr;
+    return;
+  }
+  if (self == nullptr) {
+    push_remote(hdr->owner, hdr, hdr);
+    return;
+  }
+  self->remote_deallocations.inc();
+  auto key = reinterpret_cast<uintptr_t>(hdr->owner) / sizeof(cache);
+  auto& batch = self->pending[key % num_pending_batches];
+  if (batch.owner != hdr->owner) {
+    flush(self, batch);
+    batch.owner = hdr->owner;
+    batch.tail = hdr;
+  }
+  next_of(hdr) = batch.head;
+  batch.head = hdr;
+  if (++batch.size == batch_size)
+    flush(self, batch);
+}
+
+memory_pool::statistics memory_pool::stats() {
+  statistics result{0, 0, 0, 0, 0, 0, 0};
+  auto& reg = get_registry();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  for (auto ptr : reg.all) {
+    result.allocations += ptr->allocations.get();
+    result.deallocations += ptr->deallocations.get();
+    result.remote_deallocations += ptr->remote_deallocations.get();
+    result.returned_batches += ptr->returned_batches.get();
+    result.heap_allocations += ptr->heap_allocations.get();
+    result.reserved_bytes += ptr->reserved_bytes.get();
+  }
+  result.caches = reg.all.size();
+  return result;
+}
+
+void memory_pool::flush_thread_cache() {
+  auto self = local_cache();
+  if (self != nullptr)
+    for (auto& batch : self->pending)
+      flush(self, batch);
+}
+
+#else // CAF_ENABLE_MEMORY_POOL
+
+void* memory_pool::allocate(size_t size) {
+  auto result = malloc(size);
+  if (result == nullptr)
+    throw std::bad_alloc();
+  return result;
+}
+
+void memory_pool::allocate(size_t size, size_t n, void** out) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = allocate(size);
+}
+
+void memory_pool::deallocate(void* ptr) noexcept {
+  free(ptr);
+}
+
+memory_pool::statistics memory_pool::stats() {
+  return {0, 0, 0, 0, 0, 0, 0};
+}
+
+void memory_pool::flush_thread_cache() {
+  // nop
+}
+
+#endif // CAF_ENABLE_MEMORY_POOL
+
+} // namespace detail
+} // namespace caf
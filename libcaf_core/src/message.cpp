@@ -19,7 +19,7 @@
 #include "caf/message.hpp"
 
 #include <iostream>
-#include <utility>
+#include <string>
 #include <utility>
 
 #include "caf/serializer.hpp"
@@ -35,6 +35,36 @@
 
 namespace caf {
 
+namespace {
+
+// Writes type IDs below 128 as a single byte and all others as two bytes.
+error save_type_id(serializer& sink, uint16_t x) {
+  if (x < 0x80) {
+    auto byte = static_cast<uint8_t>(x);
+    return sink(byte);
+  }
+  auto hi = static_cast<uint8_t>(0x80 | (x >> 8));
+  auto lo = static_cast<uint8_t>(x & 0xFF);
+  return sink(hi, lo);
+}
+
+error load_type_id(deserializer& source, uint16_t& x) {
+  uint8_t hi;
+  if (auto err = source(hi))
+    return err;
+  if ((hi & 0x80) == 0) {
+    x = hi;
+    return none;
+  }
+  uint8_t lo;
+  if (auto err = source(lo))
+    return err;
+  x = static_cast<uint16_t>(((hi & 0x7F) << 8) | lo);
+  return none;
+}
+
+} // namespace <anonymous>
+
 message::message(none_t) noexcept {
   // nop
 }
@@ -123,12 +153,28 @@ error message::load(deserializer& source) {
   }
   if (tname.compare(0, 4, "@<>+") != 0)
     return sec::unknown_type;
+  auto& types = source.context()->system().types();
+  // construct all elements in a single block if possible
+  auto factory = types.find_message_factory(tname);
+  if (factory != nullptr) {
+    auto ptr = (*factory)();
+    for (size_t i = 0; i < ptr->size(); ++i) {
+      err = ptr.unshared().load(i, source);
+      if (err)
+        return err;
+    }
+    err = source.end_object();
+    if (err)
+      return err;
+    message result{std::move(ptr)};
+    swap(result);
+    return none;
+  }
   // iterate over concatenated type names
   auto eos = tname.end();
   auto next = [&](std::string::iterator iter) {
     return std::find(iter, eos, '+');
   };
-  auto& types = source.context()->system().types();
   auto dmd = make_counted<detail::dynamic_message_data>();
   std::string tmp;
   std::string::iterator i = next(tname.begin());
@@ -196,6 +242,79 @@ error message::save(serializer& sink) const {
                      [&] { return sink.end_object(); });
 }
 
+// -- compact serialization ----------------------------------------------------
+
+error message::save_compact(serializer& sink) const {
+  if (sink.context() == nullptr)
+    return sec::no_context;
+  auto n = size();
+  if (auto err = sink.begin_sequence(n))
+    return err;
+  auto& types = sink.context()->system().types();
+  for (size_t i = 0; i < n; ++i) {
+    auto rtti = cvals()->type(i);
+    auto id = types.type_id(rtti);
+    if (id == 0)
+      return make_error(sec::unknown_type, rtti.second != nullptr
+                                           ? rtti.second->name()
+                                           : "-not-available-");
+    if (auto err = save_type_id(sink, id))
+      return err;
+  }
+  for (size_t i = 0; i < n; ++i)
+    if (auto err = cvals()->save(i, sink))
+      return err;
+  return sink.end_sequence();
+}
+
+error message::load_compact(deserializer& source,
+                            const std::vector<uint16_t>& ids) {
+  if (source.context() == nullptr)
+    return sec::no_context;
+  size_t n;
+  if (auto err = source.begin_sequence(n))
+    return err;
+  if (n == 0) {
+    vals_.reset();
+    return source.end_sequence();
+  }
+  // translate the type IDs of the sender to local type IDs
+  std::u16string local_ids;
+  for (size_t i = 0; i < n; ++i) {
+    uint16_t remote_id;
+    if (auto err = load_type_id(source, remote_id))
+      return err;
+    auto id = remote_id < ids.size() ? ids[remote_id] : uint16_t{0};
+    if (id == 0)
+      return make_error(sec::unknown_type, remote_id);
+    local_ids += static_cast<char16_t>(id);
+  }
+  // construct all elements in a single block if possible
+  auto& types = source.context()->system().types();
+  data_ptr ptr;
+  auto factory = types.find_message_factory(local_ids);
+  if (factory != nullptr) {
+    ptr = (*factory)();
+  } else {
+    auto dmd = make_counted<detail::dynamic_message_data>();
+    for (auto id : local_ids) {
+      auto x = types.make_value(static_cast<uint16_t>(id));
+      if (!x)
+        return make_error(sec::unknown_type, static_cast<uint16_t>(id));
+      dmd->append(std::move(x));
+    }
+    ptr = data_ptr{std::move(dmd)};
+  }
+  for (size_t i = 0; i < n; ++i)
+    if (auto err = ptr.unshared().load(i, source))
+      return err;
+  if (auto err = source.end_sequence())
+    return err;
+  message result{std::move(ptr)};
+  swap(result);
+  return none;
+}
+
 // -- factories ----------------------------------------------------------------
 
 message message::copy(const type_erased_tuple& xs) {
@@ -0,0 +1,148 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/policy/numa_work_stealing.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/config_value.hpp"
+#include "caf/defaults.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+#define CONFIG(str_name, var_name)                                             \
+  get_or(p->config(), "work-stealing." str_name,                               \
+         defaults::work_stealing::var_name)
+
+namespace caf {
+namespace policy {
+
+numa_work_stealing::~numa_work_stealing() {
+  // nop
+}
+
+numa_work_stealing::layout::layout(scheduler::abstract_coordinator* p)
+    : layout(detail::cpu_topology::detect(), p->num_workers()) {
+  pin_workers = CONFIG("pin-workers", pin_workers);
+  remote_steal_threshold = CONFIG("remote-steal-threshold",
+                                  remote_steal_threshold);
+  // Pinning more than one worker to the same CPU does more harm than good.
+  if (p->num_workers() > topology.num_cpus())
+    pin_workers = false;
+}
+
+numa_work_stealing::layout::layout(detail::cpu_topology topo,
+                                   size_t num_workers)
+    : topology(std::move(topo)),
+      pin_workers(false),
+      remote_steal_threshold(defaults::work_stealing::remote_steal_threshold),
+      workers(topology.domains.size()),
+      next_worker(new std::atomic<size_t>[topology.domains.size()]) {
+  auto& domains = topology.domains;
+  // Give each domain a share of the workers that matches its share of the
+  // CPUs. The largest remainder method distributes the workers left over
+  // after rounding down, preferring domains that lost the most by rounding.
+  auto num_cpus = topology.num_cpus();
+  std::vector<size_t> quota(domains.size());
+  std::vector<size_t> remainder(domains.size());
+  size_t assigned = 0;
+  for (size_t i = 0; i < domains.size(); ++i) {
+    quota[i] = num_workers * domains[i].size() / num_cpus;
+    remainder[i] = num_workers * domains[i].size() % num_cpus;
+    assigned += quota[i];
+  }
+  std::vector<size_t> order(domains.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+    return remainder[x] > remainder[y];
+  });
+  for (size_t i = 0; assigned < num_workers; ++i, ++assigned)
+    ++quota[order[i]];
+  // Assign workers round-robin, skipping domains that reached their quota.
+  // Hence, consecutive worker IDs still alternate between domains.
+  std::vector<size_t> next_cpu(domains.size(), 0);
+  size_t domain = 0;
+  for (size_t i = 0; i < num_workers; ++i) {
+    while (workers[domain].size() == quota[domain])
+      domain = (domain + 1) % domains.size();
+    auto& cpus = domains[domain];
+    cpu_of.emplace_back(cpus[next_cpu[domain]++ % cpus.size()]);
+    domain_of.emplace_back(domain);
+    workers[domain].emplace_back(i);
+    domain = (domain + 1) % domains.size();
+  }
+  for (size_t i = 0; i < domains.size(); ++i)
+    next_worker[i] = 0;
+  // Order the victims of each worker by locality.
+  for (size_t i = 0; i < num_workers; ++i) {
+    std::vector<size_t> xs;
+    for (auto j : workers[domain_of[i]])
+      if (j != i)
+        xs.emplace_back(j);
+    num_neighbors.emplace_back(xs.size());
+    for (size_t j = 0; j < num_workers; ++j)
+      if (domain_of[j] != domain_of[i])
+        xs.emplace_back(j);
+    victims.emplace_back(std::move(xs));
+  }
+  // Build a lookup table for mapping CPUs to domains.
+  for (size_t i = 0; i < domains.size(); ++i) {
+    for (auto cpu : domains[i]) {
+      auto index = static_cast<size_t>(cpu);
+      if (index >= domain_of_cpu.size())
+        domain_of_cpu.resize(index + 1, 0);
+      domain_of_cpu[index] = i;
+    }
+  }
+}
+
+size_t numa_work_stealing::layout::current_domain() const {
+  auto cpu = detail::current_cpu();
+  if (cpu < 0 || static_cast<size_t>(cpu) >= domain_of_cpu.size())
+    return 0;
+  return domain_of_cpu[static_cast<size_t>(cpu)];
+}
+
+numa_work_stealing::worker_data::worker_data(
+  scheduler::abstract_coordinator* p)
+    : work_stealing::worker_data(p),
+      shared(std::make_shared<layout>(p)),
+      misses(0) {
+  // nop
+}
+
+numa_work_stealing::worker_data::worker_data(const worker_data& other)
+    : work_stealing::worker_data(other),
+      shared(other.shared),
+      misses(0) {
+  // nop
+}
+
+size_t numa_work_stealing::random_victim(worker_data& data,
+                                         const std::vector<size_t>& candidates,
+                                         size_t first, size_t last) {
+  CAF_ASSERT(first < last && last <= candidates.size());
+  std::uniform_int_distribution<size_t> ud(first, last - 1);
+  return candidates[ud(data.rengine)];
+}
+
+} // namespace policy
+} // namespace caf
@@ -0,0 +1,98 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/detail/parker.hpp"
+
+#include <chrono>
+
+#ifdef CAF_LINUX
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // CAF_LINUX
+
+namespace caf {
+namespace detail {
+
+constexpr int parker::running;
+
+constexpr int parker::parked;
+
+constexpr int parker::notified;
+
+parker::parker() : state_(running) {
+  // nop
+}
+
+#ifdef CAF_LINUX
+
+namespace {
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int),
+              "futex requires std::atomic<int> to have the size of an int");
+
+int* futex_addr(std::atomic<int>& x) {
+  return reinterpret_cast<int*>(&x);
+}
+
+} // namespace <anonymous>
+
+bool parker::park(timespan timeout) {
+  auto ns = timeout.count();
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000);
+  // The kernel only blocks if the state still equals `parked`, i.e., we cannot
+  // miss a wakeup between `prepare_park` and the system call. Spurious wakeups
+  // and signals are treated like timeouts.
+  syscall(SYS_futex, futex_addr(state_), FUTEX_WAIT_PRIVATE, parked, &ts,
+          nullptr, 0);
+  return state_.exchange(running, std::memory_order_acquire) == notified;
+}
+
+void parker::wake() {
+  syscall(SYS_futex, futex_addr(state_), FUTEX_WAKE_PRIVATE, 1, nullptr,
+          nullptr, 0);
+}
+
+#else // CAF_LINUX
+
+bool parker::park(timespan timeout) {
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.wait_for(guard, timeout, [&] {
+      return state_.load(std::memory_order_relaxed) != parked;
+    });
+  }
+  return state_.exchange(running, std::memory_order_acquire) == notified;
+}
+
+void parker::wake() {
+  // Acquiring the mutex prevents the notification from happening between
+  // the predicate check and the wait in `park`.
+  std::unique_lock<std::mutex> guard{mtx_};
+  cv_.notify_one();
+}
+
+#endif // CAF_LINUX
+
+} // namespace detail
+} // namespace caf
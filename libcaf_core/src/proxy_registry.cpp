@@ -16,6 +16,7 @@
  * http://www.boost.org/LICENSE_1_0.txt.                                      *
  ******************************************************************************/
 
+#include <thread>
 #include <utility>
 #include <algorithm>
 
@@ -26,89 +27,212 @@
 #include "caf/deserializer.hpp"
 #include "caf/proxy_registry.hpp"
 
+#include "caf/locks.hpp"
 #include "caf/logger.hpp"
 #include "caf/actor_registry.hpp"
 
 namespace caf {
 
+namespace {
+
+using exclusive_guard = unique_lock<detail::shared_spinlock>;
+using shared_guard = shared_lock<detail::shared_spinlock>;
+
+} // namespace <anonymous>
+
 proxy_registry::backend::~backend() {
   // nop
 }
 
 proxy_registry::proxy_registry(actor_system& sys, backend& be)
     : system_(sys),
-      backend_(be) {
+      backend_(be),
+      data_(std::make_shared<storage>()) {
   // nop
 }
 
 proxy_registry::~proxy_registry() {
-  clear();
+  // Registries sharing our proxies still need them.
+  if (data_.unique())
+    clear();
+}
+
+auto proxy_registry::shard_of(const node_id& nid) const -> shard& {
+  // Mix high bits into the lower bits, because node IDs hash to the XOR of
+  // host ID bytes and process ID.
+  auto h = std::hash<node_id>{}(nid);
+  h ^= h >> 17;
+  h ^= h >> 7;
+  return (*data_)[h];
 }
 
 size_t proxy_registry::count_proxies(const node_id& node) {
-  auto i = proxies_.find(node);
-  return (i != proxies_.end()) ? i->second.size() : 0;
+  auto& s = shard_of(node);
+  shared_guard guard{s.mtx};
+  auto& proxies = s.data.proxies;
+  auto i = proxies.find(node);
+  return (i != proxies.end()) ? i->second.size() : 0;
 }
 
 strong_actor_ptr proxy_registry::get(const node_id& node, actor_id aid) {
-  auto& submap = proxies_[node];
-  auto i = submap.find(aid);
-  if (i != submap.end())
-    return i->second;
+  auto& s = shard_of(node);
+  shared_guard guard{s.mtx};
+  auto& proxies = s.data.proxies;
+  auto i = proxies.find(node);
+  if (i == proxies.end())
+    return nullptr;
+  auto j = i->second.find(aid);
+  if (j != i->second.end())
+    return j->second;
   return nullptr;
 }
 
 strong_actor_ptr proxy_registry::get_or_put(const node_id& nid, actor_id aid) {
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid));
-  auto& result = proxies_[nid][aid];
-  if (!result)
-    result = backend_.make_proxy(nid, aid);
+  // Fast path: most lookups hit an existing proxy.
+  auto result = get(nid, aid);
+  if (result)
+    return result;
+  auto& s = shard_of(nid);
+  auto& pending = s.data.pending;
+  auto is_key = [&](const pending_proxy& x) {
+    return x.aid == aid && x.nid == nid;
+  };
+  // Either find the proxy or claim its creation. Threads that find a pending
+  // entry for the same actor spin until the creator has added the proxy.
+  // Creating proxies for other actors, even in the same shard, never waits on
+  // the backend.
+  for (;;) {
+    { // Lifetime scope of guard.
+      exclusive_guard guard{s.mtx};
+      auto& proxies = s.data.proxies;
+      auto i = proxies.find(nid);
+      if (i != proxies.end()) {
+        auto j = i->second.find(aid);
+        if (j != i->second.end())
+          return j->second;
+      }
+      if (std::none_of(pending.begin(), pending.end(), is_key)) {
+        pending.emplace_back(pending_proxy{nid, aid, false});
+        break;
+      }
+    }
+    std::this_thread::yield();
+  }
+  result = backend_.make_proxy(nid, aid);
+  auto discarded = false;
+  { // Lifetime scope of guard.
+    exclusive_guard guard{s.mtx};
+    auto i = std::find_if(pending.begin(), pending.end(), is_key);
+    CAF_ASSERT(i != pending.end());
+    discarded = i->discarded;
+    pending.erase(i);
+    if (result && !discarded)
+      s.data.proxies[nid].emplace(aid, result);
+  }
+  // Calling `erase(nid)` or `clear` while the backend created the proxy
+  // removes the node before we had a chance to add the proxy.
+  if (discarded)
+    kill_proxy(result, exit_reason::remote_link_unreachable);
   return result;
 }
 
 std::vector<strong_actor_ptr> proxy_registry::get_all(const node_id& node) {
   std::vector<strong_actor_ptr> result;
-  auto i = proxies_.find(node);
-  if (i != proxies_.end())
+  auto& s = shard_of(node);
+  shared_guard guard{s.mtx};
+  auto& proxies = s.data.proxies;
+  auto i = proxies.find(node);
+  if (i != proxies.end()) {
+    result.reserve(i->second.size());
     for (auto& kvp : i->second)
       result.push_back(kvp.second);
+  }
   return result;
 }
 
 bool proxy_registry::empty() const {
-  return proxies_.empty();
+  for (auto& s : *data_) {
+    shared_guard guard{s.mtx};
+    if (!s.data.proxies.empty())
+      return false;
+  }
+  return true;
+}
+
+size_t proxy_registry::size() const {
+  size_t result = 0;
+  for (auto& s : *data_) {
+    shared_guard guard{s.mtx};
+    result += s.data.proxies.size();
+  }
+  return result;
 }
 
 void proxy_registry::erase(const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(nid));
-  auto i = proxies_.find(nid);
-  if (i == proxies_.end())
-    return;
-  for (auto& kvp : i->second)
+  // Move the submap out of the critical section before killing any proxy.
+  proxy_table submap;
+  { // Lifetime scope of guard.
+    auto& s = shard_of(nid);
+    exclusive_guard guard{s.mtx};
+    // Pending calls to `get_or_put` must not add proxies for `nid` after we
+    // have erased all of its proxies.
+    for (auto& x : s.data.pending)
+      if (x.nid == nid)
+        x.discarded = true;
+    auto& proxies = s.data.proxies;
+    auto i = proxies.find(nid);
+    if (i == proxies.end())
+      return;
+    submap.swap(i->second);
+    proxies.erase(i);
+  }
+  for (auto& kvp : submap)
     kill_proxy(kvp.second, exit_reason::remote_link_unreachable);
-  proxies_.erase(i);
 }
 
 void proxy_registry::erase(const node_id& nid, actor_id aid, error rsn) {
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid));
-  auto i = proxies_.find(nid);
-  if (i != proxies_.end()) {
+  strong_actor_ptr ptr;
+  { // Lifetime scope of guard.
+    auto& s = shard_of(nid);
+    exclusive_guard guard{s.mtx};
+    auto& proxies = s.data.proxies;
+    auto i = proxies.find(nid);
+    if (i == proxies.end())
+      return;
     auto& submap = i->second;
     auto j = submap.find(aid);
     if (j == submap.end())
       return;
-    kill_proxy(j->second, std::move(rsn));
+    ptr.swap(j->second);
     submap.erase(j);
     if (submap.empty())
-      proxies_.erase(i);
+      proxies.erase(i);
   }
+  kill_proxy(ptr, std::move(rsn));
 }
 
 void proxy_registry::clear() {
-  for (auto& kvp : proxies_)
-    for (auto& sub_kvp : kvp.second)
-      kill_proxy(sub_kvp.second, exit_reason::remote_link_unreachable);
-  proxies_.clear();
+  for (auto& s : *data_) {
+    proxy_map_per_node tmp;
+    { // Lifetime scope of guard.
+      exclusive_guard guard{s.mtx};
+      for (auto& x : s.data.pending)
+        x.discarded = true;
+      tmp.swap(s.data.proxies);
+    }
+    for (auto& kvp : tmp)
+      for (auto& sub_kvp : kvp.second)
+        kill_proxy(sub_kvp.second, exit_reason::remote_link_unreachable);
+  }
+}
+
+void proxy_registry::share(proxy_registry& other) {
+  CAF_ASSERT(&other != this);
+  clear();
+  data_ = other.data_;
 }
 
 void proxy_registry::kill_proxy(strong_actor_ptr& ptr, error rsn) {
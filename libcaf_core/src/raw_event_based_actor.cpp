@@ -44,14 +44,17 @@ invoke_message_result raw_event_based_actor::consume(mailbox_element& x) {
       pr.second(msg);
     }
     awaited_responses_.pop_front();
+    drop_response_timeout(x.mid);
     return im_success;
   }
   // handle multiplexed responses
   if (x.mid.is_response()) {
     auto mrh = multiplexed_responses_.find(x.mid);
     // neither awaited nor multiplexed, probably an expired timeout
-    if (mrh == multiplexed_responses_.end())
+    if (mrh == multiplexed_responses_.end()) {
+      drop_response_timeout(x.mid);
       return im_dropped;
+    }
     if (!mrh->second(x.content())) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
@@ -59,6 +62,7 @@ invoke_message_result raw_event_based_actor::consume(mailbox_element& x) {
       mrh->second(msg);
     }
     multiplexed_responses_.erase(mrh);
+    drop_response_timeout(x.mid);
     return im_success;
   }
   auto& content = x.content();
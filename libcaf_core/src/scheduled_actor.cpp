@@ -120,7 +120,10 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
       error_handler_(default_error_handler),
       down_handler_(default_down_handler),
       exit_handler_(default_exit_handler),
-      private_thread_(nullptr)
+      private_thread_(nullptr),
+      max_throughput_(cfg.max_throughput),
+      throughput_budget_(cfg.throughput_budget),
+      message_cost_(0)
 # ifndef CAF_NO_EXCEPTIONS
       , exception_handler_(default_exception_handler)
 # endif // CAF_NO_EXCEPTIONS
@@ -226,6 +229,8 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   // Clear state for open requests.
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  response_timeouts_.clear();
+  obsolete_response_timeouts_.clear();
   // Clear state for open streams.
   for (auto& kvp : stream_managers_)
     kvp.second->stop(fail_state);
@@ -373,8 +378,23 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
   if (!activate(ctx))
     return resumable::done;
   size_t handled_msgs = 0;
+  auto limit = throughput_limit(max_throughput);
+  // Measures the cost per message if the actor has a throughput budget.
+  auto measure = throughput_budget_.count() > 0;
+  auto t0 = measure ? clock().now() : actor_clock::time_point{};
+  auto measure_message_cost = [&] {
+    if (measure && handled_msgs > 0) {
+      using std::chrono::duration_cast;
+      update_message_cost(duration_cast<timespan>(clock().now() - t0),
+                          handled_msgs);
+      measure = false;
+    }
+  };
   actor_clock::time_point tout{actor_clock::duration_type{0}};
   auto reset_timeouts_if_needed = [&] {
+    measure_message_cost();
+    // Cancel request timeouts for all responses we have received.
+    flush_response_timeouts();
     // Set a new receive timeout if we called our behavior at least once.
     if (handled_msgs > 0)
       set_receive_timeout();
@@ -386,10 +406,10 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
       set_stream_timeout(tout);
     }
   };
-  mailbox_visitor f{this, handled_msgs, max_throughput};
+  mailbox_visitor f{this, handled_msgs, limit};
   mailbox_element_ptr ptr;
   // Timeout for calling `advance_streams`.
-  while (handled_msgs < max_throughput) {
+  while (handled_msgs < limit) {
     CAF_LOG_DEBUG("start new DRR round");
     // TODO: maybe replace '3' with configurable / adaptive value?
     // Dispatch on the different message categories in our mailbox.
@@ -436,6 +456,8 @@ void scheduled_actor::quit(error x) {
   bhvr_stack_.clear();
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  response_timeouts_.clear();
+  obsolete_response_timeouts_.clear();
   // Ignore future exit, down and error messages.
   set_exit_handler(silently_ignore<exit_msg>);
   set_down_handler(silently_ignore<down_msg>);
@@ -539,6 +561,26 @@ void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
   multiplexed_responses_.emplace(response_id, std::move(bhvr));
 }
 
+void scheduled_actor::request_response_timeout(const duration& d,
+                                               message_id mid) {
+  if (!d.valid())
+    return;
+  local_actor::request_response_timeout(d, mid);
+  response_timeouts_.emplace(mid.response_id());
+}
+
+void scheduled_actor::drop_response_timeout(message_id response_id) {
+  if (response_timeouts_.erase(response_id) > 0)
+    obsolete_response_timeouts_.emplace_back(response_id);
+}
+
+void scheduled_actor::flush_response_timeouts() {
+  if (obsolete_response_timeouts_.empty())
+    return;
+  clock().cancel_request_timeouts(this, obsolete_response_timeouts_);
+  obsolete_response_timeouts_.clear();
+}
+
 scheduled_actor::message_category
 scheduled_actor::categorize(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
@@ -644,6 +686,7 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
       return im_skipped;
     auto f = std::move(pr.second);
     awaited_responses_.pop_front();
+    drop_response_timeout(x.mid);
     if (!invoke(this, f, x)) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
@@ -657,10 +700,13 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
     auto invoke = select_invoke_fun();
     auto mrh = multiplexed_responses_.find(x.mid);
     // neither awaited nor multiplexed, probably an expired timeout
-    if (mrh == multiplexed_responses_.end())
+    if (mrh == multiplexed_responses_.end()) {
+      drop_response_timeout(x.mid);
       return im_dropped;
+    }
     auto bhvr = std::move(mrh->second);
     multiplexed_responses_.erase(mrh);
+    drop_response_timeout(x.mid);
     if (!invoke(this, bhvr, x)) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
@@ -1161,4 +1207,27 @@ scheduled_actor::advance_streams(actor_clock::time_point now) {
                                           credit_round_ticks_});
 }
 
+size_t scheduled_actor::throughput_limit(size_t scheduler_limit) const
+noexcept {
+  auto result = max_throughput_ > 0 ? max_throughput_ : scheduler_limit;
+  if (throughput_budget_.count() > 0 && message_cost_.count() > 0) {
+    // Handle as many messages as fit into the budget, but at least one.
+    auto n = static_cast<size_t>(throughput_budget_.count()
+                                 / message_cost_.count());
+    result = std::min(result, std::max(n, size_t{1}));
+  }
+  return result;
+}
+
+void scheduled_actor::update_message_cost(timespan elapsed, size_t n) noexcept {
+  CAF_ASSERT(n > 0);
+  auto cost = elapsed / static_cast<timespan::rep>(n);
+  // Exponentially weighted moving average with a smoothing factor of 1/8.
+  if (message_cost_.count() == 0)
+    message_cost_ = cost;
+  else
+    message_cost_ += (cost - message_cost_) / 8;
+  CAF_LOG_DEBUG(CAF_ARG(cost) << CAF_ARG(message_cost_));
+}
+
 } // namespace caf
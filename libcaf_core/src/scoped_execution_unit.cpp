@@ -32,4 +32,9 @@ void scoped_execution_unit::exec_later(resumable* ptr) {
   system().scheduler().enqueue(ptr);
 }
 
+void scoped_execution_unit::exec_later_all(
+  const std::vector<resumable*>& ptrs) {
+  system().scheduler().enqueue_all(ptrs);
+}
+
 } // namespace caf
@@ -18,6 +18,8 @@
 
 #include "caf/detail/simple_actor_clock.hpp"
 
+#include <algorithm>
+
 #include "caf/actor_cast.hpp"
 #include "caf/sec.hpp"
 #include "caf/system_messages.hpp"
@@ -125,6 +127,27 @@ void simple_actor_clock::cancel_request_timeout(abstract_actor* self,
   cancel(self, pred);
 }
 
+void simple_actor_clock::cancel_request_timeouts(
+  abstract_actor* self, const std::vector<message_id>& ids) {
+  if (ids.size() < 2) {
+    actor_clock::cancel_request_timeouts(self, ids);
+    return;
+  }
+  // Visit all timeouts of `self` only once instead of once per ID.
+  auto xs = ids;
+  std::sort(xs.begin(), xs.end());
+  auto range = actor_lookup_.equal_range(self);
+  for (auto i = range.first; i != range.second;) {
+    auto ptr = get_if<request_timeout>(&i->second->second);
+    if (ptr != nullptr && std::binary_search(xs.begin(), xs.end(), ptr->id)) {
+      schedule_.erase(i->second);
+      i = actor_lookup_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
 void simple_actor_clock::cancel_timeouts(abstract_actor* self) {
   auto range = actor_lookup_.equal_range(self);
   if (range.first == range.second)
@@ -70,6 +70,15 @@ void thread_safe_actor_clock::cancel_request_timeout(abstract_actor* self,
   }
 }
 
+void thread_safe_actor_clock::cancel_request_timeouts(
+  abstract_actor* self, const std::vector<message_id>& ids) {
+  guard_type guard{mx_};
+  if (!done_) {
+    super::cancel_request_timeouts(self, ids);
+    cv_.notify_all();
+  }
+}
+
 void thread_safe_actor_clock::cancel_timeouts(abstract_actor* self) {
   guard_type guard{mx_};
   if (!done_) {
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_wheel.hpp"
+
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+void init_sentinel(timer_wheel::node& x) {
+  x.prev = &x;
+  x.next = &x;
+}
+
+} // namespace <anonymous>
+
+constexpr size_t timer_wheel::slot_bits;
+
+constexpr size_t timer_wheel::num_slots;
+
+constexpr size_t timer_wheel::num_levels;
+
+constexpr timer_wheel::tick_type timer_wheel::infinite;
+
+timer_wheel::timer_wheel() : now_(0), size_(0) {
+  for (auto& level : slots_)
+    for (auto& x : level)
+      init_sentinel(x);
+  init_sentinel(overflow_);
+  init_sentinel(expired_);
+}
+
+timer_wheel::tick_type timer_wheel::next_tick() const noexcept {
+  if (size_ == 0)
+    return infinite;
+  if (!empty(expired_))
+    return now_;
+  auto result = infinite;
+  // Timers in the first level expire within the next round.
+  for (tick_type d = 1; d < num_slots; ++d) {
+    if (!empty(slots_[0][(now_ + d) & (num_slots - 1)])) {
+      result = now_ + d;
+      break;
+    }
+  }
+  // Timers in higher levels move down at the start of their slot.
+  for (size_t level = 1; level < num_levels; ++level) {
+    auto shift = level * slot_bits;
+    auto pos = now_ >> shift;
+    for (tick_type d = 1; d <= num_slots; ++d) {
+      if (!empty(slots_[level][(pos + d) & (num_slots - 1)])) {
+        result = std::min(result, (pos + d) << shift);
+        break;
+      }
+    }
+  }
+  if (!empty(overflow_)) {
+    auto shift = num_levels * slot_bits;
+    result = std::min(result, ((now_ >> shift) + 1) << shift);
+  }
+  return result;
+}
+
+void timer_wheel::insert(node* x, tick_type t) {
+  CAF_ASSERT(!x->linked());
+  x->expiry = t;
+  ++size_;
+  if (t <= now_) {
+    push_back(expired_, x);
+    return;
+  }
+  auto delta = t - now_;
+  for (size_t level = 0; level < num_levels; ++level) {
+    if (delta <= level_mask(level + 1)) {
+      push_back(slot(level, t), x);
+      return;
+    }
+  }
+  push_back(overflow_, x);
+}
+
+void timer_wheel::erase(node* x) {
+  CAF_ASSERT(x->linked());
+  unlink(x);
+  --size_;
+}
+
+void timer_wheel::push_back(node& list, node* x) noexcept {
+  x->prev = list.prev;
+  x->next = &list;
+  list.prev->next = x;
+  list.prev = x;
+}
+
+void timer_wheel::unlink(node* x) noexcept {
+  x->prev->next = x->next;
+  x->next->prev = x->prev;
+  x->prev = nullptr;
+  x->next = nullptr;
+}
+
+void timer_wheel::cascade(node& list) {
+  if (empty(list))
+    return;
+  // Detach all timers first, because they may end up in the same list again.
+  node tmp;
+  tmp.next = list.next;
+  tmp.prev = list.prev;
+  tmp.next->prev = &tmp;
+  tmp.prev->next = &tmp;
+  init_sentinel(list);
+  while (!empty(tmp)) {
+    auto x = tmp.next;
+    unlink(x);
+    --size_;
+    insert(x, x->expiry);
+  }
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,396 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_wheel_actor_clock.hpp"
+
+#include <functional>
+#include <iterator>
+#include <limits>
+
+#include "caf/actor_cast.hpp"
+#include "caf/sec.hpp"
+#include "caf/system_messages.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+using guard_type = std::unique_lock<std::mutex>;
+
+constexpr auto no_wakeup =
+  std::numeric_limits<actor_clock::time_point::rep>::max();
+
+struct dispatcher {
+  void operator()(simple_actor_clock::ordinary_timeout& x) {
+    CAF_ASSERT(x.self != nullptr);
+    x.self->get()->eq_impl(make_message_id(), x.self, nullptr,
+                           timeout_msg{x.type, x.id});
+  }
+
+  void operator()(simple_actor_clock::multi_timeout& x) {
+    CAF_ASSERT(x.self != nullptr);
+    x.self->get()->eq_impl(make_message_id(), x.self, nullptr,
+                           timeout_msg{x.type, x.id});
+  }
+
+  void operator()(simple_actor_clock::request_timeout& x) {
+    CAF_ASSERT(x.self != nullptr);
+    x.self->get()->eq_impl(x.id, x.self, nullptr, sec::request_timeout);
+  }
+
+  void operator()(simple_actor_clock::actor_msg& x) {
+    x.receiver->enqueue(std::move(x.content), nullptr);
+  }
+
+  void operator()(simple_actor_clock::group_msg& x) {
+    x.target->eq_impl(make_message_id(), std::move(x.sender), nullptr,
+                      std::move(x.content));
+  }
+};
+
+} // namespace <anonymous>
+
+constexpr size_t timer_wheel_actor_clock::num_stripes;
+
+size_t timer_wheel_actor_clock::key_hash::
+operator()(const key_type& x) const noexcept {
+  auto h = std::hash<uint64_t>{}(x.value);
+  h ^= std::hash<abstract_actor*>{}(x.self) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return x.request ? ~h : h;
+}
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+timer_wheel_actor_clock::timer_wheel_actor_clock()
+    : origin_(now()),
+      clear_(false),
+      done_(false),
+      wakeup_(no_wakeup),
+      pending_(false) {
+  // nop
+}
+
+timer_wheel_actor_clock::~timer_wheel_actor_clock() {
+  erase_all();
+}
+
+// -- overridden member functions ----------------------------------------------
+
+void timer_wheel_actor_clock::set_ordinary_timeout(time_point t,
+                                                   abstract_actor* self,
+                                                   atom_value type,
+                                                   uint64_t id) {
+  auto sptr = actor_cast<strong_actor_ptr>(self);
+  key_type key{self, static_cast<uint64_t>(type), false};
+  set_timeout(t, self,
+              simple_actor_clock::ordinary_timeout{std::move(sptr), type, id},
+              true, key);
+}
+
+void timer_wheel_actor_clock::set_multi_timeout(time_point t,
+                                                abstract_actor* self,
+                                                atom_value type, uint64_t id) {
+  auto sptr = actor_cast<strong_actor_ptr>(self);
+  key_type key{self, 0, false};
+  set_timeout(t, self,
+              simple_actor_clock::multi_timeout{std::move(sptr), type, id},
+              false, key);
+}
+
+void timer_wheel_actor_clock::set_request_timeout(time_point t,
+                                                  abstract_actor* self,
+                                                  message_id id) {
+  auto sptr = actor_cast<strong_actor_ptr>(self);
+  key_type key{self, id.integer_value(), true};
+  set_timeout(t, self,
+              simple_actor_clock::request_timeout{std::move(sptr), id}, true,
+              key);
+}
+
+void timer_wheel_actor_clock::cancel_ordinary_timeout(abstract_actor* self,
+                                                      atom_value type) {
+  key_type key{self, static_cast<uint64_t>(type), false};
+  push(self, command{cancel_key, key, nullptr}, time_point::max());
+}
+
+void timer_wheel_actor_clock::cancel_request_timeout(abstract_actor* self,
+                                                     message_id id) {
+  key_type key{self, id.integer_value(), true};
+  push(self, command{cancel_key, key, nullptr}, time_point::max());
+}
+
+void timer_wheel_actor_clock::cancel_request_timeouts(
+  abstract_actor* self, const std::vector<message_id>& ids) {
+  if (done_ || ids.empty())
+    return;
+  // Acquire the lock only once for all IDs. Cancelling never requires waking
+  // up the dispatch loop.
+  auto& s = stripe_of(self);
+  guard_type guard{s.mtx};
+  for (auto id : ids) {
+    key_type key{self, id.integer_value(), true};
+    s.buf.emplace_back(command{cancel_key, key, nullptr});
+  }
+}
+
+void timer_wheel_actor_clock::cancel_timeouts(abstract_actor* self) {
+  key_type key{self, 0, false};
+  push(self, command{cancel_self, key, nullptr}, time_point::max());
+}
+
+void timer_wheel_actor_clock::schedule_message(time_point t,
+                                               strong_actor_ptr receiver,
+                                               mailbox_element_ptr content) {
+  auto ptr = receiver.get();
+  schedule(ptr, t, simple_actor_clock::actor_msg{std::move(receiver),
+                                                 std::move(content)});
+}
+
+void timer_wheel_actor_clock::schedule_message(time_point t, group target,
+                                               strong_actor_ptr sender,
+                                               message content) {
+  auto ptr = target.get();
+  schedule(ptr, t, simple_actor_clock::group_msg{std::move(target),
+                                                 std::move(sender),
+                                                 std::move(content)});
+}
+
+void timer_wheel_actor_clock::cancel_all() {
+  for (auto& x : stripes_)
+    x.mtx.lock();
+  for (auto& x : stripes_)
+    x.buf.clear();
+  clear_ = true;
+  for (auto& x : stripes_)
+    x.mtx.unlock();
+  guard_type guard{mtx_};
+  pending_ = true;
+  cv_.notify_all();
+}
+
+// -- dispatching --------------------------------------------------------------
+
+void timer_wheel_actor_clock::run_dispatch_loop() {
+  std::vector<entry_ptr> fired;
+  while (!done_) {
+    drain();
+    auto t = now();
+    auto tick = t > origin_
+                  ? static_cast<timer_wheel::tick_type>(
+                      std::chrono::duration_cast<tick_duration>(t - origin_)
+                        .count())
+                  : timer_wheel::tick_type{0};
+    wheel_.advance(tick, [&](timer_wheel::node* x) {
+      fired.emplace_back(static_cast<entry*>(x));
+    });
+    dispatcher f;
+    for (auto& x : fired) {
+      forget(x.get());
+      visit(f, x->value);
+    }
+    fired.clear();
+    // Sleep until the next tick that has work to do or until new commands
+    // require an earlier wakeup.
+    auto next = wheel_.next_tick();
+    guard_type guard{mtx_};
+    if (next == timer_wheel::infinite) {
+      wakeup_ = no_wakeup;
+      while (!pending_ && !done_)
+        cv_.wait(guard);
+    } else {
+      auto tout = origin_ + tick_duration{next};
+      wakeup_ = tout.time_since_epoch().count();
+      while (!pending_ && !done_)
+        if (cv_.wait_until(guard, tout) == std::cv_status::timeout)
+          break;
+    }
+    pending_ = false;
+    wakeup_ = no_wakeup;
+  }
+  for (auto& x : stripes_) {
+    guard_type guard{x.mtx};
+    x.buf.clear();
+  }
+  erase_all();
+}
+
+void timer_wheel_actor_clock::cancel_dispatch_loop() {
+  guard_type guard{mtx_};
+  done_ = true;
+  cv_.notify_all();
+}
+
+// -- utility functions --------------------------------------------------------
+
+timer_wheel::tick_type
+timer_wheel_actor_clock::to_tick(time_point t) const noexcept {
+  if (t <= origin_)
+    return 0;
+  auto d = t - origin_;
+  auto n = std::chrono::duration_cast<tick_duration>(d);
+  // Round up to never dispatch a timeout early.
+  if (n < d)
+    ++n;
+  return static_cast<timer_wheel::tick_type>(n.count());
+}
+
+timer_wheel_actor_clock::stripe&
+timer_wheel_actor_clock::stripe_of(const void* ptr) noexcept {
+  auto x = reinterpret_cast<uintptr_t>(ptr);
+  // Skip the low bits, since all allocations are aligned.
+  x = (x >> 4) ^ (x >> 12);
+  return stripes_[x % num_stripes];
+}
+
+void timer_wheel_actor_clock::push(const void* ptr, command x, time_point t) {
+  if (done_)
+    return;
+  auto& s = stripe_of(ptr);
+  { // Lifetime scope of guard.
+    guard_type guard{s.mtx};
+    s.buf.emplace_back(std::move(x));
+  }
+  if (t.time_since_epoch().count() < wakeup_) {
+    guard_type guard{mtx_};
+    pending_ = true;
+    cv_.notify_all();
+  }
+}
+
+void timer_wheel_actor_clock::set_timeout(time_point t, abstract_actor* self,
+                                          value_type x, bool keyed,
+                                          key_type key) {
+  entry_ptr ptr{new entry(t, std::move(x))};
+  ptr->self = self;
+  ptr->keyed = keyed;
+  ptr->key = key;
+  push(self, command{add_entry, key, std::move(ptr)}, t);
+}
+
+void timer_wheel_actor_clock::schedule(const void* ptr, time_point t,
+                                       value_type x) {
+  entry_ptr eptr{new entry(t, std::move(x))};
+  eptr->key = key_type{nullptr, 0, false};
+  push(ptr, command{add_entry, eptr->key, std::move(eptr)}, t);
+}
+
+void timer_wheel_actor_clock::drain() {
+  // Locking all stripes at once orders `cancel_all` with all other commands.
+  for (auto& x : stripes_)
+    x.mtx.lock();
+  if (clear_) {
+    clear_ = false;
+    erase_all();
+  }
+  for (auto& x : stripes_) {
+    commands_.insert(commands_.end(), std::make_move_iterator(x.buf.begin()),
+                     std::make_move_iterator(x.buf.end()));
+    x.buf.clear();
+  }
+  for (auto& x : stripes_)
+    x.mtx.unlock();
+  for (auto& x : commands_)
+    apply(x);
+  commands_.clear();
+}
+
+void timer_wheel_actor_clock::apply(command& x) {
+  switch (x.type) {
+    case add_entry: {
+      auto ptr = x.ptr.release();
+      if (ptr->keyed) {
+        // Setting a timeout again overrides the previous one.
+        auto i = keyed_.find(ptr->key);
+        if (i != keyed_.end()) {
+          auto old = i->second;
+          i->second = ptr;
+          old->keyed = false;
+          erase(old);
+        } else {
+          keyed_.emplace(ptr->key, ptr);
+        }
+      }
+      if (ptr->self != nullptr) {
+        auto& head = by_self_[ptr->self];
+        ptr->next_of_self = head;
+        if (head != nullptr)
+          head->prev_of_self = ptr;
+        head = ptr;
+      }
+      wheel_.insert(ptr, to_tick(ptr->due));
+      break;
+    }
+    case cancel_key: {
+      auto i = keyed_.find(x.key);
+      if (i != keyed_.end())
+        erase(i->second);
+      break;
+    }
+    case cancel_self: {
+      auto i = by_self_.find(x.key.self);
+      if (i == by_self_.end())
+        break;
+      auto ptr = i->second;
+      by_self_.erase(i);
+      while (ptr != nullptr) {
+        auto next = ptr->next_of_self;
+        ptr->self = nullptr;
+        erase(ptr);
+        ptr = next;
+      }
+      break;
+    }
+  }
+}
+
+void timer_wheel_actor_clock::forget(entry* ptr) {
+  if (ptr->keyed) {
+    keyed_.erase(ptr->key);
+    ptr->keyed = false;
+  }
+  if (ptr->self != nullptr) {
+    auto prev = ptr->prev_of_self;
+    auto next = ptr->next_of_self;
+    if (next != nullptr)
+      next->prev_of_self = prev;
+    if (prev != nullptr)
+      prev->next_of_self = next;
+    else if (next != nullptr)
+      by_self_[ptr->self] = next;
+    else
+      by_self_.erase(ptr->self);
+    ptr->self = nullptr;
+  }
+}
+
+void timer_wheel_actor_clock::erase(entry* ptr) {
+  if (ptr->linked())
+    wheel_.erase(ptr);
+  forget(ptr);
+  delete ptr;
+}
+
+void timer_wheel_actor_clock::erase_all() {
+  wheel_.clear([](timer_wheel::node* x) { delete static_cast<entry*>(x); });
+  keyed_.clear();
+  by_self_.clear();
+}
+
+} // namespace detail
+} // namespace caf
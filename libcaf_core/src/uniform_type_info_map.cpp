@@ -120,7 +120,12 @@ void fill_builtins(builtins& arr, List, size_t pos) {
 } // namespace <anonymous>
 
 type_erased_value_ptr uniform_type_info_map::make_value(uint16_t nr) const {
-  return builtin_[nr - 1].second();
+  if (nr < type_nrs)
+    return builtin_[nr - 1].second();
+  auto i = static_cast<size_t>(nr - type_nrs);
+  if (i < custom_.size())
+    return custom_[i]();
+  return nullptr;
 }
 
 type_erased_value_ptr
@@ -162,6 +167,33 @@ uniform_type_info_map::portable_name(uint16_t nr,
   return nullptr;
 }
 
+uint16_t uniform_type_info_map::type_id(uint16_t nr,
+                                        const std::type_info* ti) const {
+  if (nr != 0)
+    return nr;
+  if (ti == nullptr)
+    return 0;
+  auto i = custom_ids_.find(std::type_index(*ti));
+  return i != custom_ids_.end() ? i->second : 0;
+}
+
+uint16_t uniform_type_info_map::type_id(const std::string& x) const {
+  auto i = ids_by_name_.find(x);
+  return i != ids_by_name_.end() ? i->second : 0;
+}
+
+const uniform_type_info_map::message_factory*
+uniform_type_info_map::find_message_factory(const std::string& x) const {
+  auto i = message_factories_by_name_.find(x);
+  return i != message_factories_by_name_.end() ? &i->second : nullptr;
+}
+
+const uniform_type_info_map::message_factory*
+uniform_type_info_map::find_message_factory(const std::u16string& x) const {
+  auto i = message_factories_by_id_.find(x);
+  return i != message_factories_by_id_.end() ? &i->second : nullptr;
+}
+
 uniform_type_info_map::uniform_type_info_map(actor_system& sys) : system_(sys) {
   sorted_builtin_types list;
   fill_builtins(builtin_, list, 0);
@@ -169,4 +201,60 @@ uniform_type_info_map::uniform_type_info_map(actor_system& sys) : system_(sys) {
     builtin_names_[i] = numbered_type_names[i];
 }
 
+void uniform_type_info_map::init_type_ids() {
+  // Type IDs must fit into 15 bits for the compact wire format.
+  static constexpr size_t max_type_id = 0x7FFF;
+  auto& cfg = system().config();
+  using kvp = std::pair<std::string, std::type_index>;
+  std::vector<kvp> xs;
+  for (auto& x : cfg.type_names_by_rtti)
+    xs.emplace_back(x.second, x.first);
+  std::sort(xs.begin(), xs.end(), [](const kvp& x, const kvp& y) {
+    return x.first < y.first;
+  });
+  type_names_.assign(builtin_names_.begin(), builtin_names_.end());
+  for (size_t i = 0; i < builtin_names_.size(); ++i)
+    ids_by_name_.emplace(builtin_names_[i], static_cast<uint16_t>(i + 1));
+  for (auto& x : xs) {
+    auto i = cfg.value_factories_by_name.find(x.first);
+    if (i == cfg.value_factories_by_name.end())
+      continue;
+    auto id = type_nrs + custom_.size();
+    if (id > max_type_id) {
+      CAF_LOG_WARNING("too many custom types, cannot assign type ID for"
+                      << x.first);
+      break;
+    }
+    custom_.emplace_back(i->second);
+    custom_ids_.emplace(x.second, static_cast<uint16_t>(id));
+    ids_by_name_.emplace(x.first, static_cast<uint16_t>(id));
+    type_names_.emplace_back(x.first);
+  }
+}
+
+void uniform_type_info_map::init_message_factories() {
+  for (auto& x : system().config().message_factories) {
+    std::string names = "@<>";
+    std::u16string ids;
+    for (auto& rtti : x.first) {
+      auto name = portable_name(rtti);
+      auto id = type_id(rtti);
+      if (name == nullptr || id == 0) {
+        CAF_LOG_WARNING("cannot add message factory for unknown type:"
+                        << (rtti.second != nullptr ? rtti.second->name()
+                                                   : "-not-available-"));
+        names.clear();
+        break;
+      }
+      names += '+';
+      names += *name;
+      ids += static_cast<char16_t>(id);
+    }
+    if (!names.empty()) {
+      message_factories_by_name_.emplace(std::move(names), x.second);
+      message_factories_by_id_.emplace(std::move(ids), x.second);
+    }
+  }
+}
+
 } // namespace caf
@@ -30,11 +30,14 @@
 namespace caf {
 namespace policy {
 
+constexpr size_t work_stealing::min_poll_budget_divisor;
+
 work_stealing::~work_stealing() {
   // nop
 }
 
-work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
+work_stealing::worker_data_base::worker_data_base(
+  scheduler::abstract_coordinator* p)
     : rengine(std::random_device{}()),
       // no need to worry about wrap-around; if `p->num_workers() < 2`,
       // `uniform` will not be used anyway
@@ -47,14 +50,27 @@ work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
          CONFIG("moderate-steal-interval", moderate_steal_interval),
          CONFIG("moderate-sleep-duration", moderate_sleep_duration)},
         {1, 0, CONFIG("relaxed-steal-interval", relaxed_steal_interval),
-         CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}} {
+         CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}},
+      poll_budget{{strategies[0].attempts, strategies[1].attempts}} {
   // nop
 }
 
-work_stealing::worker_data::worker_data(const worker_data& other)
+work_stealing::worker_data_base::worker_data_base(
+  const worker_data_base& other)
     : rengine(std::random_device{}()),
       uniform(other.uniform),
-      strategies(other.strategies) {
+      strategies(other.strategies),
+      poll_budget(other.poll_budget) {
+  // nop
+}
+
+work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
+    : worker_data_base(p) {
+  // nop
+}
+
+work_stealing::worker_data::worker_data(const worker_data& other)
+    : worker_data_base(other) {
   // nop
 }
 
@@ -52,4 +52,21 @@ CAF_TEST(erase) {
   CAF_CHECK_EQUAL(sys.registry().named_actors().size(), baseline);
 }
 
+CAF_TEST(put_all) {
+  std::vector<actor> xs;
+  for (auto i = 0; i < 100; ++i)
+    xs.emplace_back(sys.spawn(dummy));
+  sys.registry().put_all(xs.begin(), xs.end());
+  for (auto& x : xs)
+    CAF_CHECK_EQUAL(sys.registry().get<actor>(x.id()), x);
+  // Registering actors again has no effect.
+  sys.registry().put_all(xs.begin(), xs.end());
+  // Terminated actors remove themselves from the registry.
+  for (auto& x : xs)
+    anon_send_exit(x, exit_reason::kill);
+  run();
+  for (auto& x : xs)
+    CAF_CHECK_EQUAL(sys.registry().get(x.id()), nullptr);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
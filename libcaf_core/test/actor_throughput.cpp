@@ -0,0 +1,136 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE actor_throughput
+
+#include "caf/test/dsl.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+// Counts handled messages and simulates a processing time per message.
+struct counter {
+  size_t count = 0;
+  timespan cost{0};
+  detail::test_actor_clock* clock = nullptr;
+};
+
+class testee : public event_based_actor {
+public:
+  testee(actor_config& cfg, counter* c) : event_based_actor(cfg), c_(c) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [=](int) {
+        ++c_->count;
+        if (c_->clock != nullptr)
+          c_->clock->current_time += c_->cost;
+      }
+    };
+  }
+
+private:
+  counter* c_;
+};
+
+struct fixture : test_coordinator_fixture<> {
+  counter c;
+
+  actor spawn_testee(actor_config& cfg) {
+    auto result = sys.spawn_class<testee, no_spawn_options>(cfg, &c);
+    sched.run();
+    return result;
+  }
+
+  void send_messages(const actor& dest, int n) {
+    for (int i = 0; i < n; ++i)
+      self->send(dest, i);
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(actor_throughput_tests, fixture)
+
+CAF_TEST(actors use the throughput of the scheduler by default) {
+  actor_config cfg;
+  auto x = spawn_testee(cfg);
+  CAF_CHECK_EQUAL(deref<testee>(x).max_throughput(), 0u);
+  send_messages(x, 3);
+  // The test coordinator allows one message per activation.
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 1u);
+}
+
+CAF_TEST(actor configs override the throughput of the scheduler) {
+  actor_config cfg;
+  cfg.max_throughput = 3;
+  auto x = spawn_testee(cfg);
+  send_messages(x, 5);
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 3u);
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 5u);
+}
+
+CAF_TEST(actors can change their throughput at runtime) {
+  actor_config cfg;
+  auto x = spawn_testee(cfg);
+  deref<testee>(x).max_throughput(4);
+  send_messages(x, 5);
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 4u);
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 5u);
+}
+
+CAF_TEST(throughput budgets adapt to the cost per message) {
+  c.cost = std::chrono::milliseconds(1);
+  c.clock = &sched.clock();
+  actor_config cfg;
+  cfg.max_throughput = 10;
+  cfg.throughput_budget = std::chrono::milliseconds(2);
+  auto x = spawn_testee(cfg);
+  send_messages(x, 20);
+  // The first activation has no estimate yet.
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 10u);
+  CAF_CHECK_EQUAL(deref<testee>(x).message_cost(),
+                  timespan{std::chrono::milliseconds(1)});
+  // Two messages fit into the budget.
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, 12u);
+  // Cheaper messages raise the limit up to the configured maximum again.
+  c.cost = timespan{0};
+  send_messages(x, 200);
+  auto& self_ref = deref<testee>(x);
+  for (int i = 0; i < 100 && self_ref.message_cost().count() > 200000; ++i)
+    sched.run_once();
+  CAF_REQUIRE_LESS_OR_EQUAL(self_ref.message_cost().count(), 200000);
+  auto before = c.count;
+  sched.run_once();
+  CAF_CHECK_EQUAL(c.count, before + 10);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
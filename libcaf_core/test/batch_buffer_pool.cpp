@@ -0,0 +1,99 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE batch_buffer_pool
+
+#include "caf/detail/batch_buffer_pool.hpp"
+
+#include <thread>
+
+#include "caf/test/unit_test.hpp"
+
+using namespace caf;
+
+namespace {
+
+using pool = detail::batch_buffer_pool<int>;
+
+struct fixture {
+  fixture() {
+    pool::clear();
+  }
+
+  ~fixture() {
+    pool::clear();
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(batch_buffer_pool_tests, fixture)
+
+CAF_TEST(empty pools hand out fresh buffers) {
+  auto xs = pool::take();
+  CAF_CHECK(xs.empty());
+  CAF_CHECK_EQUAL(xs.capacity(), 0u);
+}
+
+// Without thread_local support, the pools never cache anything.
+#ifndef CAF_NO_THREAD_LOCAL
+
+CAF_TEST(recycled buffers keep their storage) {
+  std::vector<int> xs{1, 2, 3};
+  xs.reserve(100);
+  auto data = xs.data();
+  pool::recycle(std::move(xs));
+  CAF_CHECK_EQUAL(pool::size(), 1u);
+  auto ys = pool::take();
+  CAF_CHECK(ys.empty());
+  CAF_CHECK(ys.data() == data);
+  CAF_CHECK_GREATER_OR_EQUAL(ys.capacity(), 100u);
+  CAF_CHECK_EQUAL(pool::size(), 0u);
+}
+
+CAF_TEST(pools drop buffers without storage or with excess storage) {
+  pool::recycle(std::vector<int>{});
+  std::vector<int> xs;
+  xs.reserve(pool::max_capacity + 1);
+  pool::recycle(std::move(xs));
+  CAF_CHECK_EQUAL(pool::size(), 0u);
+}
+
+CAF_TEST(pools cache a limited number of buffers) {
+  for (size_t i = 0; i < pool::max_buffers + 10; ++i)
+    pool::recycle(std::vector<int>(10));
+  CAF_CHECK_EQUAL(pool::size(), pool::max_buffers);
+}
+
+CAF_TEST(each thread caches its own buffers) {
+  pool::recycle(std::vector<int>(10));
+  size_t other_size = 42;
+  std::thread t{[&] {
+    other_size = pool::size();
+    pool::recycle(std::vector<int>(10));
+    pool::recycle(std::vector<int>(10));
+  }};
+  t.join();
+  CAF_CHECK_EQUAL(other_size, 0u);
+  CAF_CHECK_EQUAL(pool::size(), 1u);
+}
+
+#endif // CAF_NO_THREAD_LOCAL
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -98,6 +98,44 @@ CAF_TEST(multiple_lambda_construct) {
   CAF_CHECK_EQUAL(f(m3), none);
 }
 
+CAF_TEST(dispatch_index) {
+  // Large behaviors dispatch via an index but keep first-match semantics.
+  behavior f{
+    [](int x) { return x + 1; },
+    [](hi_atom, int x) { return x + 2; },
+    [](atom_value, int x) -> result<int> {
+      if (x == 0)
+        return skip();
+      return x + 3;
+    },
+    [](ho_atom, int x) { return x + 40; },
+    [](int x, int y) { return x * y; },
+    [](hi_atom) { return 5; },
+    [](ho_atom) { return 6; },
+    [](hi_atom, ho_atom) { return 7; },
+    [](const string& x) { return x; },
+    [](double x) { return x; }
+  };
+  auto call = [&](message msg) {
+    return to_string(f(msg));
+  };
+  CAF_CHECK_EQUAL(to_string(f(m1)), "*(2)");
+  CAF_CHECK_EQUAL(to_string(f(m2)), "*(2)");
+  CAF_CHECK_EQUAL(f(m3), none);
+  CAF_CHECK_EQUAL(call(make_message(hi_atom::value, 1)), "*(3)");
+  // The generic atom handler precedes the handler for `ho_atom`.
+  CAF_CHECK_EQUAL(call(make_message(ho_atom::value, 1)), "*(4)");
+  CAF_CHECK_EQUAL(call(make_message(atom("foo"), 1)), "*(4)");
+  CAF_CHECK_EQUAL(call(make_message(hi_atom::value)), "*(5)");
+  CAF_CHECK_EQUAL(call(make_message(ho_atom::value)), "*(6)");
+  CAF_CHECK_EQUAL(call(make_message(atom("foo"))), "none");
+  CAF_CHECK_EQUAL(call(make_message(hi_atom::value, ho_atom::value)),
+                  "*(7)");
+  CAF_CHECK_EQUAL(call(make_message("hello")), "*(\"hello\")");
+  // A skipping handler stops dispatching.
+  CAF_CHECK_EQUAL(call(make_message(ho_atom::value, 0)), "none");
+}
+
 CAF_TEST(become_empty_behavior) {
   actor_system_config cfg{};
   actor_system sys{cfg};
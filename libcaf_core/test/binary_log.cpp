@@ -0,0 +1,138 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE binary_log
+#include "caf/test/unit_test.hpp"
+
+#include <sstream>
+#include <string>
+
+#include "caf/all.hpp"
+#include "caf/detail/binary_log.hpp"
+
+using namespace caf;
+
+using std::string;
+
+namespace {
+
+struct fixture {
+  std::stringstream buf;
+  detail::binary_log_writer writer{buf};
+  detail::binary_log_reader reader{buf};
+  timestamp t0 = make_timestamp();
+
+  logger::event make_event(unsigned line, string msg, actor_id aid) {
+    return {CAF_LOG_LEVEL_INFO,
+            line,
+            atom("caf"),
+            "void foo::bar()",
+            "bar",
+            "foo.cpp",
+            std::move(msg),
+            std::this_thread::get_id(),
+            aid,
+            t0 + std::chrono::milliseconds(line)};
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(binary_log_tests, fixture)
+
+CAF_TEST(events survive a roundtrip) {
+  writer.write_header(t0);
+  auto e1 = make_event(10, "hello", 42);
+  auto e2 = make_event(20, "world", 7);
+  writer.write(e1);
+  writer.write(e2);
+  writer.write(e1);
+  CAF_REQUIRE(reader.read_header());
+  CAF_CHECK_EQUAL(reader.t0(), t0);
+  logger::event x;
+  string thread_name;
+  for (auto e : {&e1, &e2, &e1}) {
+    CAF_REQUIRE(reader.read(x, thread_name));
+    CAF_CHECK_EQUAL(x.level, e->level);
+    CAF_CHECK_EQUAL(x.line_number, e->line_number);
+    CAF_CHECK_EQUAL(x.category_name, e->category_name);
+    CAF_CHECK_EQUAL(x.pretty_fun, e->pretty_fun);
+    CAF_CHECK_EQUAL(x.simple_fun, e->simple_fun);
+    CAF_CHECK_EQUAL(x.file_name, e->file_name);
+    CAF_CHECK_EQUAL(x.message, e->message);
+    CAF_CHECK_EQUAL(x.aid, e->aid);
+    CAF_CHECK_EQUAL(x.tstamp, e->tstamp);
+    std::ostringstream tid;
+    tid << e->tid;
+    CAF_CHECK_EQUAL(thread_name, tid.str());
+  }
+  CAF_CHECK(!reader.read(x, thread_name));
+}
+
+CAF_TEST(locations appear only once) {
+  writer.write_header(t0);
+  auto header_size = buf.str().size();
+  writer.write(make_event(10, "", 0));
+  auto first_size = buf.str().size() - header_size;
+  writer.write(make_event(10, "", 0));
+  auto second_size = buf.str().size() - header_size - first_size;
+  // The first event also introduces its location and thread.
+  CAF_CHECK_GREATER(first_size, second_size);
+  writer.write(make_event(10, "", 0));
+  CAF_CHECK_EQUAL(buf.str().size(), header_size + first_size + 2 * second_size);
+}
+
+CAF_TEST(readers reject unknown input) {
+  buf << "CAF log, but not binary";
+  CAF_CHECK(!reader.read_header());
+}
+
+CAF_TEST(events from binary logs render like regular events) {
+  writer.write_header(t0);
+  writer.write(make_event(10, "hello", 42));
+  CAF_REQUIRE(reader.read_header());
+  logger::event x;
+  string thread_name;
+  CAF_REQUIRE(reader.read(x, thread_name));
+  std::ostringstream out;
+  auto lf = logger::parse_format("%r %c %p %a %t %C %M %F:%L %m");
+  logger::render_offline(out, lf, x, reader.t0(), "thread-1");
+  CAF_CHECK_EQUAL(out.str(),
+                  "10 caf INFO actor42 thread-1 foo bar foo.cpp:10 hello");
+}
+
+CAF_TEST(binary logs store values without rendering them) {
+  writer.write_header(t0);
+  int x = 42;
+  string str = "foo";
+  logger::line_builder msg;
+  msg << "got" << CAF_ARG(x) << CAF_ARG(str);
+  writer.write(make_event(10, msg.get(), 0));
+  CAF_REQUIRE(reader.read_header());
+  logger::event e;
+  string thread_name;
+  CAF_REQUIRE(reader.read(e, thread_name));
+  std::ostringstream out;
+  auto lf = logger::parse_format("%m");
+  logger::render_offline(out, lf, e, reader.t0(), thread_name);
+  CAF_CHECK_EQUAL(out.str(), R"(got x = 42 str = "foo")");
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
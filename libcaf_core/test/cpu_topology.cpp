@@ -0,0 +1,118 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE cpu_topology
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "caf/policy/numa_work_stealing.hpp"
+
+using namespace caf;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+using svec = std::vector<size_t>;
+
+ivec parse(string_view str) {
+  return detail::parse_cpu_list(str);
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(parsing CPU lists) {
+  CAF_CHECK_EQUAL(parse("0"), ivec({0}));
+  CAF_CHECK_EQUAL(parse("0-3"), ivec({0, 1, 2, 3}));
+  CAF_CHECK_EQUAL(parse("0-1,8,10-11"), ivec({0, 1, 8, 10, 11}));
+  CAF_CHECK_EQUAL(parse(""), ivec());
+  CAF_CHECK_EQUAL(parse("3-1"), ivec());
+  CAF_CHECK_EQUAL(parse("1-2-3"), ivec());
+  CAF_CHECK_EQUAL(parse("a"), ivec());
+}
+
+CAF_TEST(detecting the topology) {
+  auto topo = detail::cpu_topology::detect();
+  CAF_REQUIRE(!topo.domains.empty());
+  CAF_CHECK(topo.num_cpus() > 0);
+  for (size_t i = 0; i < topo.domains.size(); ++i) {
+    CAF_CHECK(!topo.domains[i].empty());
+    for (auto cpu : topo.domains[i])
+      CAF_CHECK_EQUAL(topo.domain_of(cpu), i);
+  }
+}
+
+CAF_TEST(workers spread evenly across domains) {
+  detail::cpu_topology topo;
+  topo.domains = {{0, 1}, {2, 3}, {4, 5}};
+  policy::numa_work_stealing::layout l{topo, 5};
+  CAF_CHECK_EQUAL(l.cpu_of, ivec({0, 2, 4, 1, 3}));
+  CAF_CHECK_EQUAL(l.domain_of, svec({0, 1, 2, 0, 1}));
+  CAF_CHECK_EQUAL(l.workers, std::vector<svec>({{0, 3}, {1, 4}, {2}}));
+}
+
+CAF_TEST(larger domains receive more workers) {
+  detail::cpu_topology topo;
+  topo.domains = {{0, 1, 2, 3, 4, 5}, {6, 7}};
+  policy::numa_work_stealing::layout l{topo, 4};
+  CAF_CHECK_EQUAL(l.cpu_of, ivec({0, 6, 1, 2}));
+  CAF_CHECK_EQUAL(l.domain_of, svec({0, 1, 0, 0}));
+  CAF_CHECK_EQUAL(l.workers, std::vector<svec>({{0, 2, 3}, {1}}));
+  CAF_MESSAGE("leftover workers go to the domains with the largest remainder");
+  topo.domains = {{0}, {1, 2, 3}, {4, 5}};
+  policy::numa_work_stealing::layout l2{topo, 5};
+  CAF_CHECK_EQUAL(l2.workers, std::vector<svec>({{0}, {1, 3}, {2, 4}}));
+  policy::numa_work_stealing::layout l3{topo, 2};
+  CAF_CHECK_EQUAL(l3.workers, std::vector<svec>({{}, {0}, {1}}));
+}
+
+CAF_TEST(thieves visit neighbors before remote victims) {
+  detail::cpu_topology topo;
+  topo.domains = {{0, 1}, {2, 3}, {4, 5}};
+  policy::numa_work_stealing::layout l{topo, 5};
+  CAF_CHECK_EQUAL(l.victims[0], svec({3, 1, 2, 4}));
+  CAF_CHECK_EQUAL(l.num_neighbors[0], 1u);
+  CAF_CHECK_EQUAL(l.victims[2], svec({0, 1, 3, 4}));
+  CAF_CHECK_EQUAL(l.num_neighbors[2], 0u);
+  for (size_t id = 0; id < 5; ++id) {
+    auto& xs = l.victims[id];
+    CAF_REQUIRE_EQUAL(xs.size(), 4u);
+    CAF_CHECK(std::find(xs.begin(), xs.end(), id) == xs.end());
+    auto n = l.num_neighbors[id];
+    for (size_t i = 0; i < xs.size(); ++i) {
+      auto local = l.domain_of[xs[i]] == l.domain_of[id];
+      CAF_CHECK_EQUAL(local, i < n);
+    }
+  }
+}
+
+CAF_TEST(a single domain has no remote victims) {
+  detail::cpu_topology topo;
+  topo.domains = {{0, 1, 2, 3}};
+  policy::numa_work_stealing::layout l{topo, 3};
+  for (size_t id = 0; id < 3; ++id) {
+    CAF_CHECK_EQUAL(l.victims[id].size(), 2u);
+    CAF_CHECK_EQUAL(l.num_neighbors[id], 2u);
+  }
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE credit_controller
+
+#include "caf/credit_controller.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+#include "caf/detail/complexity_based_credit_controller.hpp"
+#include "caf/detail/fixed_credit_controller.hpp"
+#include "caf/detail/latency_aware_credit_controller.hpp"
+#include "caf/detail/test_actor_clock.hpp"
+
+using namespace caf;
+
+using std::chrono::milliseconds;
+using std::chrono::microseconds;
+
+namespace {
+
+struct fixture {
+  detail::test_actor_clock clock;
+
+  fixture() {
+    // Measure each batch item with 1us.
+    clock.time_per_unit.emplace(atom("batch"), timespan{1000});
+  }
+
+  // Simulates processing a batch of `n` items.
+  void process(credit_controller& x, int32_t n) {
+    downstream_msg::batch batch{n, make_message(), 0};
+    x.before_processing(batch);
+    x.after_processing(batch);
+  }
+
+  // Returns the input for a credit round with a cycle of 1ms and a desired
+  // batch complexity of 100us.
+  credit_controller::cycle_info round(int32_t queued_items = 0,
+                                      int32_t assigned_credit = 0) {
+    return {milliseconds(1), microseconds(100), queued_items, assigned_credit};
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(credit_controller_tests, fixture)
+
+CAF_TEST(fixed credit ignores measurements) {
+  detail::fixed_credit_controller x{clock, 30, 10};
+  auto y = x.compute_initial();
+  CAF_CHECK_EQUAL(y.credit, 30);
+  CAF_CHECK_EQUAL(y.batch_size, 10);
+  process(x, 100);
+  y = x.compute(round(100));
+  CAF_CHECK_EQUAL(y.credit, 30);
+  CAF_CHECK_EQUAL(y.batch_size, 10);
+}
+
+CAF_TEST(complexity based credit fills the queue for two cycles) {
+  detail::complexity_based_credit_controller x{clock};
+  auto y = x.compute_initial();
+  CAF_CHECK_EQUAL(y.credit,
+                  static_cast<int32_t>(inbound_path::initial_credit));
+  // 1us per item results in 1000 items per cycle and 100 items per batch.
+  process(x, 10);
+  y = x.compute(round());
+  CAF_CHECK_EQUAL(y.credit, 2000);
+  CAF_CHECK_EQUAL(y.batch_size, 100);
+  CAF_CHECK_EQUAL(x.stats().num_elements, 0);
+}
+
+CAF_TEST(latency aware credit covers the round trip time) {
+  detail::latency_aware_credit_controller x{clock};
+  x.compute_initial();
+  clock.current_time += milliseconds(2);
+  process(x, 10);
+  CAF_CHECK_EQUAL(x.rtt(), timespan{milliseconds(2)});
+  // The source holds credit, i.e., the next batch carries no RTT sample.
+  auto y = x.compute(round(0, 10));
+  CAF_CHECK_EQUAL(y.credit, 4000);
+  CAF_CHECK_EQUAL(y.batch_size, 100);
+  clock.current_time += milliseconds(10);
+  process(x, 10);
+  CAF_CHECK_EQUAL(x.rtt(), timespan{milliseconds(2)});
+}
+
+CAF_TEST(latency aware credit drains deep queues) {
+  detail::latency_aware_credit_controller x{clock};
+  process(x, 10);
+  // Up to 1000 queued items are processed within one cycle.
+  CAF_CHECK_EQUAL(x.compute(round(1000, 1000)).credit, 2000);
+  process(x, 10);
+  CAF_CHECK_EQUAL(x.compute(round(1500, 1500)).credit, 1500);
+  process(x, 10);
+  CAF_CHECK_EQUAL(x.compute(round(5000, 5000)).credit, 1);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
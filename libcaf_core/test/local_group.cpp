@@ -86,5 +86,19 @@ CAF_TEST(class_based_joined_at_spawn) {
     self->send_exit(x, exit_reason::user_shutdown);
 }
 
+CAF_TEST(multicast_to_many_subscribers) {
+  auto grp = system.groups().get_local("test");
+  std::vector<actor> xs;
+  for (auto i = 0; i < 100; ++i)
+    xs.emplace_back(system.spawn_in_group(grp, testee_impl));
+  anon_send(grp, put_atom::value, 23);
+  for (auto& x : xs) {
+    auto f = make_function_view(actor_cast<testee_if>(x));
+    CAF_CHECK_EQUAL(f(get_atom::value), 23);
+  }
+  for (auto& x : xs)
+    self->send_exit(x, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
@@ -21,8 +21,12 @@
 #define CAF_SUITE logger
 #include "caf/test/unit_test.hpp"
 
+#include <cstdio>
 #include <ctime>
+#include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "caf/all.hpp"
 
@@ -215,4 +219,102 @@ CAF_TEST(render_fun_prefix) {
   foo::tpl<T>::run();
 }
 
+CAF_TEST(line builders defer rendering of primitive values) {
+  int32_t i = -12345;
+  uint64_t u = 67890;
+  bool flag = true;
+  double d = 1.5;
+  std::string str = "a \"b\"";
+  auto a = atom("foo");
+  std::vector<int> xs{1, 2};
+  auto msg = (logger::line_builder{} << "values:" << CAF_ARG(i) << u
+                                     << CAF_ARG(flag) << CAF_ARG(d)
+                                     << CAF_ARG(str) << CAF_ARG(a)
+                                     << CAF_ARG(xs) << 'x').get();
+  CAF_CHECK_EQUAL(msg.find("12345"), std::string::npos);
+  CAF_CHECK_EQUAL(msg.find("67890"), std::string::npos);
+  CAF_CHECK_EQUAL(logger::render_message(msg),
+                  R"(values: i = -12345 67890 flag = true d = 1.500000 )"
+                  R"(str = "a \"b\"" a = 'foo' xs = [1, 2] x)");
+  // Messages that are not encoded by a line builder render as-is.
+  CAF_CHECK_EQUAL(logger::render_message("hello world"), "hello world");
+}
+
+CAF_TEST(the logger drops events when the buffer of a thread is full) {
+  // Without file and console output, the logger never starts its thread.
+  cfg.set("logger.file-name", "");
+  cfg.set("logger.file-verbosity", atom("debug"));
+  cfg.set("logger.console", atom("none"));
+  actor_system sys{cfg};
+  auto& lg = sys.logger();
+  for (size_t i = 0; i < logger::queue_size + 10; ++i)
+    lg.log(CAF_LOG_MAKE_EVENT(0, "caf", CAF_LOG_LEVEL_DEBUG, "event" << i));
+  CAF_CHECK_EQUAL(lg.emitted_events(), 0u);
+  CAF_CHECK_EQUAL(lg.dropped_events(), 10u);
+}
+
+CAF_TEST(the logger drains the buffers of all threads) {
+  const char* file_name = "caf-logger-test.log";
+  cfg.set("logger.file-name", file_name);
+  cfg.set("logger.file-verbosity", atom("debug"));
+  cfg.set("logger.console", atom("none"));
+  { // Lifetime scope of sys.
+    actor_system sys{cfg};
+    auto& lg = sys.logger();
+    auto producer = [&] {
+      for (int i = 0; i < 100; ++i)
+        lg.log(CAF_LOG_MAKE_EVENT(0, "caf", CAF_LOG_LEVEL_DEBUG, "event" << i));
+    };
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i)
+      producers.emplace_back(producer);
+    for (auto& t : producers)
+      t.join();
+    auto deadline = std::chrono::steady_clock::now() + seconds(10);
+    while (lg.emitted_events() < 400u
+           && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(milliseconds(1));
+    CAF_CHECK_EQUAL(lg.emitted_events(), 400u);
+    CAF_CHECK_EQUAL(lg.dropped_events(), 0u);
+  }
+  std::remove(file_name);
+}
+
+CAF_TEST(the logger emits pending events on shutdown) {
+  const char* file_name = "caf-logger-shutdown-test.log";
+  cfg.set("logger.file-name", file_name);
+  cfg.set("logger.file-verbosity", atom("debug"));
+  cfg.set("logger.console", atom("none"));
+  // Events that arrive right before shutdown race with the logger thread,
+  // hence we repeat the test a couple of times.
+  for (int run = 0; run < 50; ++run) {
+    std::remove(file_name);
+    { // Lifetime scope of sys.
+      actor_system sys{cfg};
+      auto& lg = sys.logger();
+      auto producer = [&] {
+        for (int i = 0; i < 50; ++i)
+          lg.log(CAF_LOG_MAKE_EVENT(0, "caf", CAF_LOG_LEVEL_DEBUG,
+                                    "pending-event" << i));
+      };
+      std::vector<std::thread> producers;
+      for (int i = 0; i < 4; ++i)
+        producers.emplace_back(producer);
+      for (auto& t : producers)
+        t.join();
+      // Shut down right away, i.e., without waiting for the logger thread.
+      producer();
+    }
+    std::ifstream in{file_name};
+    size_t pending_events = 0;
+    for (std::string line; std::getline(in, line);)
+      if (line.find("pending-event") != std::string::npos)
+        ++pending_events;
+    if (pending_events != 250u)
+      CAF_FAIL("logger emitted " << pending_events
+               << " of 250 events in run " << run);
+  }
+  std::remove(file_name);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -93,6 +93,18 @@ CAF_TEST(message_roundtrip_with_copy) {
   CAF_CHECK_EQUAL(msg3.cvals().get(), msg_ptr);
 }
 
+CAF_TEST(message_multicast) {
+  auto msg = make_message(1, 2, 3);
+  auto msg_ptr = msg.cvals().get();
+  auto xs = make_mailbox_elements(3, nullptr, make_message_id(), msg);
+  CAF_REQUIRE_EQUAL(xs.size(), 3u);
+  for (auto& x : xs) {
+    CAF_CHECK(x->mid.is_async());
+    CAF_CHECK_EQUAL((fetch<int, int, int>(*x)), make_tuple(1, 2, 3));
+    CAF_CHECK_EQUAL(x->move_content_to_message().cvals().get(), msg_ptr);
+  }
+}
+
 CAF_TEST(tuple) {
   auto m1 = make_mailbox_element(nullptr, make_message_id(),
                                  no_stages, 1, 2, 3);
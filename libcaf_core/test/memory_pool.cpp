@@ -0,0 +1,129 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE memory_pool
+
+#include "caf/detail/memory_pool.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "caf/mailbox_element.hpp"
+
+using namespace caf;
+
+using detail::memory_pool;
+
+#ifdef CAF_ENABLE_MEMORY_POOL
+
+CAF_TEST(freed blocks are reused by the same thread) {
+  auto x = memory_pool::allocate(40);
+  memory_pool::deallocate(x);
+  auto y = memory_pool::allocate(50);
+  CAF_CHECK_EQUAL(x, y);
+  memory_pool::deallocate(y);
+}
+
+CAF_TEST(large allocations bypass the free lists) {
+  auto before = memory_pool::stats();
+  auto x = memory_pool::allocate(memory_pool::max_block_size + 1);
+  auto after = memory_pool::stats();
+  CAF_CHECK_EQUAL(after.heap_allocations, before.heap_allocations + 1);
+  memory_pool::deallocate(x);
+}
+
+CAF_TEST(blocks freed by other threads return in batches) {
+  auto before = memory_pool::stats();
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < memory_pool::batch_size * 2; ++i)
+    blocks.emplace_back(memory_pool::allocate(64));
+  std::thread t{[&] {
+    for (auto ptr : blocks)
+      memory_pool::deallocate(ptr);
+    memory_pool::flush_thread_cache();
+  }};
+  t.join();
+  auto after = memory_pool::stats();
+  CAF_CHECK_EQUAL(after.remote_deallocations - before.remote_deallocations,
+                  blocks.size());
+  CAF_CHECK_EQUAL(after.returned_batches - before.returned_batches, 2u);
+  // The allocating thread picks up the returned blocks again.
+  std::vector<void*> reused;
+  for (size_t i = 0; i < blocks.size(); ++i)
+    reused.emplace_back(memory_pool::allocate(64));
+  CAF_CHECK_EQUAL(memory_pool::stats().reserved_bytes, after.reserved_bytes);
+  for (auto ptr : reused)
+    memory_pool::deallocate(ptr);
+}
+
+CAF_TEST(batch allocations draw multiple blocks at once) {
+  auto before = memory_pool::stats();
+  std::vector<void*> blocks(10);
+  memory_pool::allocate(64, blocks.size(), blocks.data());
+  auto after = memory_pool::stats();
+  CAF_CHECK_EQUAL(after.allocations - before.allocations, blocks.size());
+  std::sort(blocks.begin(), blocks.end());
+  CAF_CHECK(std::unique(blocks.begin(), blocks.end()) == blocks.end());
+  for (auto ptr : blocks)
+    memory_pool::deallocate(ptr);
+}
+
+CAF_TEST(blocks are aligned) {
+  std::vector<void*> blocks;
+  for (size_t size = 8; size <= memory_pool::max_block_size * 2; size *= 2)
+    blocks.emplace_back(memory_pool::allocate(size));
+  for (auto ptr : blocks) {
+    CAF_CHECK_EQUAL(reinterpret_cast<uintptr_t>(ptr) % memory_pool::alignment,
+                    0u);
+    memory_pool::deallocate(ptr);
+  }
+}
+
+CAF_TEST(over-aligned types bypass the pool) {
+  struct alignas(memory_pool::alignment * 2) over_aligned {
+    char data[16];
+  };
+  auto before = memory_pool::stats();
+  auto x = memory_pool::allocate_for<over_aligned>(sizeof(over_aligned));
+  memory_pool::deallocate_for<over_aligned>(x);
+  auto after = memory_pool::stats();
+  CAF_CHECK_EQUAL(after.allocations, before.allocations);
+  CAF_CHECK_EQUAL(after.deallocations, before.deallocations);
+  auto y = memory_pool::allocate_for<int>(sizeof(int));
+  memory_pool::deallocate_for<int>(y);
+  CAF_CHECK_EQUAL(memory_pool::stats().allocations, after.allocations + 1);
+}
+
+#endif // CAF_ENABLE_MEMORY_POOL
+
+CAF_TEST(mailbox elements use the pool) {
+  auto before = memory_pool::stats();
+  auto x = make_mailbox_element(nullptr, make_message_id(), {}, 1, 2.0, "three");
+  x.reset();
+  auto after = memory_pool::stats();
+#ifdef CAF_ENABLE_MEMORY_POOL
+  CAF_CHECK_GREATER(after.allocations, before.allocations);
+  CAF_CHECK_GREATER(after.deallocations, before.deallocations);
+#else
+  CAF_CHECK_EQUAL(after.allocations, before.allocations);
+#endif
+}
@@ -0,0 +1,186 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE parallel_stage
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/stateful_actor.hpp"
+
+using std::string;
+
+using namespace caf;
+
+namespace {
+
+TESTEE_SETUP();
+
+using buf = std::deque<int>;
+
+VARARGS_TESTEE(file_reader, size_t buf_size) {
+  return {
+    [=](string& fname) -> output_stream<int> {
+      CAF_CHECK_EQUAL(fname, "numbers.txt");
+      return self->make_source(
+        // initialize state
+        [=](buf& xs) {
+          xs.resize(buf_size);
+          std::iota(xs.begin(), xs.end(), 1);
+        },
+        // get next element
+        [](buf& xs, downstream<int>& out, size_t num) {
+          auto n = std::min(num, xs.size());
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        // check whether we reached the end
+        [](const buf& xs) {
+          return xs.empty();
+        }
+      );
+    }
+  };
+}
+
+// Doubles all odd numbers and drops all even numbers.
+void odd_doubler(unit_t&, downstream<int>& out, int x) {
+  if ((x & 0x01) != 0)
+    out.push(x * 2);
+}
+
+VARARGS_TESTEE(parallel_doubler, size_t num_workers, bool ordered) {
+  return {
+    [=](stream<int>& in) {
+      return self->make_parallel_stage(in, num_workers, odd_doubler, ordered);
+    }
+  };
+}
+
+TESTEE_STATE(collector) {
+  std::vector<int> xs;
+  bool done = false;
+};
+
+TESTEE(collector) {
+  using vec_ptr = std::vector<int>*;
+  return {
+    [=](stream<int>& in) {
+      return self->make_sink(
+        // input stream
+        in,
+        // initialize state
+        [=](vec_ptr& xs) {
+          xs = &self->state.xs;
+        },
+        // processing step
+        [](vec_ptr& xs, int x) {
+          xs->emplace_back(x);
+        },
+        // cleanup
+        [=](vec_ptr&, const error& err) {
+          CAF_CHECK_EQUAL(err, none);
+          self->state.done = true;
+        }
+      );
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  void tick() {
+    advance_time(cfg.stream_credit_round_interval);
+  }
+
+  // Runs the stream until the collector is done and returns its elements.
+  std::vector<int> run_pipeline(size_t num_items, size_t num_workers,
+                                bool ordered) {
+    auto src = sys.spawn(file_reader, num_items);
+    auto stg = sys.spawn(parallel_doubler, num_workers, ordered);
+    auto snk = sys.spawn(collector);
+    self->send(snk * stg * src, "numbers.txt");
+    auto& st = deref<collector_actor>(snk).state;
+    run();
+    for (int i = 0; i < 50 && !st.done; ++i) {
+      tick();
+      run();
+    }
+    CAF_CHECK(st.done);
+    return st.xs;
+  }
+
+  // Returns the expected output for the input `1, ..., num_items`.
+  static std::vector<int> expected(size_t num_items) {
+    std::vector<int> result;
+    for (int x = 1; x <= static_cast<int>(num_items); ++x)
+      if ((x & 0x01) != 0)
+        result.emplace_back(x * 2);
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+// -- unit tests ---------------------------------------------------------------
+
+CAF_TEST_FIXTURE_SCOPE(parallel_stage_tests, fixture)
+
+CAF_TEST(ordered parallel stages preserve the input order) {
+  CAF_CHECK_EQUAL(run_pipeline(500, 4, true), expected(500));
+}
+
+CAF_TEST(unordered parallel stages produce all results) {
+  auto xs = run_pipeline(500, 4, false);
+  std::sort(xs.begin(), xs.end());
+  CAF_CHECK_EQUAL(xs, expected(500));
+}
+
+CAF_TEST(parallel stages with a single worker) {
+  CAF_CHECK_EQUAL(run_pipeline(50, 1, true), expected(50));
+}
+
+CAF_TEST(parallel stages stop their workers when done) {
+  auto src = sys.spawn(file_reader, 50u);
+  auto stg = sys.spawn(parallel_doubler, size_t{3}, true);
+  auto snk = sys.spawn(collector);
+  auto running = sys.registry().running();
+  self->send(snk * stg * src, "numbers.txt");
+  // The stage spawns its workers when receiving the handshake.
+  for (int i = 0; i < 10 && sys.registry().running() == running; ++i)
+    sched.run_once();
+  CAF_CHECK_GREATER(sys.registry().running(), running);
+  run();
+  auto& st = deref<collector_actor>(snk).state;
+  for (int i = 0; i < 50 && !st.done; ++i) {
+    tick();
+    run();
+  }
+  CAF_REQUIRE(st.done);
+  CAF_CHECK_EQUAL(st.xs, expected(50));
+  CAF_CHECK_EQUAL(sys.registry().running(), running);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE parker
+
+#include "caf/detail/parker.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+constexpr timespan one_ms = std::chrono::milliseconds(1);
+
+constexpr timespan ten_seconds = std::chrono::seconds(10);
+
+struct fixture {
+  detail::parker uut;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(parker_tests, fixture)
+
+CAF_TEST(unpark does nothing for running threads) {
+  CAF_CHECK(!uut.is_parked());
+  CAF_CHECK(!uut.unpark());
+  uut.prepare_park();
+  CAF_CHECK(uut.is_parked());
+  uut.cancel_park();
+  CAF_CHECK(!uut.is_parked());
+  CAF_CHECK(!uut.unpark());
+}
+
+CAF_TEST(park returns false on timeout) {
+  uut.prepare_park();
+  CAF_CHECK(!uut.park(one_ms));
+  CAF_CHECK(!uut.is_parked());
+}
+
+CAF_TEST(unpark before park prevents blocking) {
+  uut.prepare_park();
+  CAF_CHECK(uut.unpark());
+  CAF_CHECK(!uut.unpark());
+  CAF_CHECK(uut.park(ten_seconds));
+}
+
+CAF_TEST(unpark wakes up parked threads) {
+  std::atomic<bool> flag{false};
+  auto t0 = std::chrono::steady_clock::now();
+  std::thread sleeper{[&] {
+    while (!flag) {
+      uut.prepare_park();
+      if (flag)
+        uut.cancel_park();
+      else
+        uut.park(ten_seconds);
+    }
+  }};
+  flag = true;
+  uut.unpark();
+  sleeper.join();
+  auto t1 = std::chrono::steady_clock::now();
+  CAF_CHECK(t1 - t0 < ten_seconds);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,323 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE partitioned_downstream_manager
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <numeric>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/partitioned_downstream_manager.hpp"
+#include "caf/scheduled_actor.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+using namespace caf;
+
+namespace {
+
+using part_manager = partitioned_downstream_manager<int>;
+
+// Mocks just enough of a stream manager to serve our entity.
+class mock_stream_manager : public stream_manager {
+public:
+  using super = stream_manager;
+
+  mock_stream_manager(scheduled_actor* self) : super(self), out_(this) {
+    // nop
+  }
+
+  part_manager& out() override {
+    return out_;
+  }
+
+  bool done() const override {
+    return false;
+  }
+
+  bool idle() const noexcept override {
+    return false;
+  }
+
+private:
+  part_manager out_;
+};
+
+// Mocks just enough of an actor to receive and send batches.
+class entity : public scheduled_actor {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = scheduled_actor;
+
+  using signatures = none_t;
+
+  using behavior_type = behavior;
+
+  entity(actor_config& cfg, const char* cstr)
+      : super(cfg),
+        cstr_name(cstr),
+        mgr(this),
+        next_slot(1) {
+    // nop
+  }
+
+  void enqueue(mailbox_element_ptr what, execution_unit*) override {
+    mbox.push_back(what->move_content_to_message());
+  }
+
+  void attach(attachable_ptr) override {
+    // nop
+  }
+
+  size_t detach(const attachable::token&) override {
+    return 0;
+  }
+
+  void add_link(abstract_actor*) override {
+    // nop
+  }
+
+  void remove_link(abstract_actor*) override {
+    // nop
+  }
+
+  bool add_backlink(abstract_actor*) override {
+    return false;
+  }
+
+  bool remove_backlink(abstract_actor*) override {
+    return false;
+  }
+
+  void launch(execution_unit*, bool, bool) override {
+    // nop
+  }
+
+  stream_slot add_path_to(entity& x, int32_t desired_batch_size) {
+    auto slot = next_slot++;
+    auto ptr = mgr.out().add_path(slot, x.ctrl());
+    CAF_REQUIRE(ptr != nullptr);
+    ptr->set_desired_batch_size(desired_batch_size);
+    ptr->slots.receiver = x.next_slot++;
+    return slot;
+  }
+
+  void grant(stream_slot slot, int32_t num) {
+    auto ptr = mgr.out().path(slot);
+    CAF_REQUIRE(ptr != nullptr);
+    ptr->open_credit += num;
+  }
+
+  void push(int first, int last) {
+    for (auto i = first; i <= last; ++i)
+      mgr.out().push(i);
+  }
+
+  const char* name() const override {
+    return cstr_name;
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  const char* cstr_name;
+
+  /// Manager-under-test.
+  mock_stream_manager mgr;
+
+  /// Dummy mailbox.
+  std::vector<message> mbox;
+
+  /// Next free ID.
+  stream_slot next_slot;
+};
+
+// Provides the setup with alice, bob, carl, and dave.
+struct fixture {
+  actor_system_config cfg;
+
+  actor_system sys;
+
+  strong_actor_ptr alice_hdl;
+
+  strong_actor_ptr bob_hdl;
+
+  strong_actor_ptr carl_hdl;
+
+  strong_actor_ptr dave_hdl;
+
+  entity& alice;
+
+  entity& bob;
+
+  entity& carl;
+
+  entity& dave;
+
+  static strong_actor_ptr spawn(actor_system& sys, actor_id id,
+                                const char* name) {
+    actor_config conf;
+    auto hdl = make_actor<entity>(id, node_id{}, &sys, conf, name);
+    return actor_cast<strong_actor_ptr>(std::move(hdl));
+  }
+
+  static entity& fetch(const strong_actor_ptr& hdl) {
+    return *static_cast<entity*>(actor_cast<abstract_actor*>(hdl));
+  }
+
+  fixture()
+      : sys(cfg),
+        alice_hdl(spawn(sys, 0, "alice")),
+        bob_hdl(spawn(sys, 1, "bob")),
+        carl_hdl(spawn(sys, 2, "carl")),
+        dave_hdl(spawn(sys, 3, "dave")),
+        alice(fetch(alice_hdl)),
+        bob(fetch(bob_hdl)),
+        carl(fetch(carl_hdl)),
+        dave(fetch(dave_hdl)) {
+    // nop
+  }
+
+  using batch_type = std::vector<int>;
+
+  // Returns all elements from the batches in the mailbox of `x`.
+  batch_type received(entity& x) {
+    batch_type result;
+    for (auto& msg : x.mbox) {
+      CAF_REQUIRE(msg.match_elements<downstream_msg>());
+      auto& dm = msg.get_mutable_as<downstream_msg>(0);
+      CAF_REQUIRE(holds_alternative<downstream_msg::batch>(dm.content));
+      auto& b = get<downstream_msg::batch>(dm.content);
+      CAF_REQUIRE(b.xs.match_elements<batch_type>());
+      auto& xs = b.xs.get_as<batch_type>(0);
+      result.insert(result.end(), xs.begin(), xs.end());
+    }
+    x.mbox.clear();
+    return result;
+  }
+
+  // Maps each received element to its receiver.
+  std::map<int, entity*> owners(std::initializer_list<entity*> xs) {
+    std::map<int, entity*> result;
+    for (auto x : xs)
+      for (auto y : received(*x))
+        CAF_CHECK(result.emplace(y, x).second);
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(partitioned_downstream_manager_tests, fixture)
+
+CAF_TEST(elements go to exactly one path) {
+  for (auto x : {&bob, &carl, &dave})
+    alice.grant(alice.add_path_to(*x, 10), 1000);
+  alice.push(1, 300);
+  alice.mgr.out().force_emit_batches();
+  batch_type all;
+  for (auto x : {&bob, &carl, &dave}) {
+    auto xs = received(*x);
+    CAF_MESSAGE(x->name() << " received " << xs.size() << " elements");
+    CAF_CHECK(!xs.empty());
+    CAF_CHECK(std::is_sorted(xs.begin(), xs.end()));
+    all.insert(all.end(), xs.begin(), xs.end());
+  }
+  std::sort(all.begin(), all.end());
+  batch_type expected(300);
+  std::iota(expected.begin(), expected.end(), 1);
+  CAF_CHECK_EQUAL(all, expected);
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 0u);
+}
+
+CAF_TEST(equal keys go to the same path) {
+  for (auto x : {&bob, &carl, &dave})
+    alice.grant(alice.add_path_to(*x, 10), 1000);
+  for (int i = 0; i < 100; ++i)
+    alice.mgr.out().push(i % 10);
+  alice.mgr.out().force_emit_batches();
+  std::map<int, entity*> receivers;
+  for (auto x : {&bob, &carl, &dave})
+    for (auto key : received(*x))
+      CAF_CHECK(receivers.emplace(key, x).first->second == x);
+  CAF_CHECK_EQUAL(receivers.size(), 10u);
+}
+
+CAF_TEST(adding a path only moves keys to the new path) {
+  alice.grant(alice.add_path_to(bob, 10), 1000);
+  alice.grant(alice.add_path_to(carl, 10), 1000);
+  alice.push(1, 200);
+  alice.mgr.out().force_emit_batches();
+  auto before = owners({&bob, &carl});
+  CAF_REQUIRE_EQUAL(before.size(), 200u);
+  alice.grant(alice.add_path_to(dave, 10), 1000);
+  alice.push(1, 200);
+  alice.mgr.out().force_emit_batches();
+  auto after = owners({&bob, &carl, &dave});
+  CAF_REQUIRE_EQUAL(after.size(), 200u);
+  size_t moved = 0;
+  for (auto& kvp : after) {
+    if (kvp.second != before[kvp.first]) {
+      CAF_CHECK(kvp.second == &dave);
+      ++moved;
+    }
+  }
+  CAF_MESSAGE(moved << " of 200 keys moved to dave");
+  CAF_CHECK_GREATER(moved, 0u);
+}
+
+CAF_TEST(paths without credit do not block other paths) {
+  auto bob_slot = alice.add_path_to(bob, 10);
+  alice.grant(alice.add_path_to(carl, 10), 1000);
+  alice.push(1, 100);
+  alice.mgr.out().force_emit_batches();
+  auto xs = received(carl);
+  CAF_CHECK(!xs.empty());
+  CAF_CHECK(received(bob).empty());
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 100u - xs.size());
+  alice.grant(bob_slot, 1000);
+  alice.mgr.out().force_emit_batches();
+  CAF_CHECK_EQUAL(received(bob).size(), 100u - xs.size());
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 0u);
+}
+
+CAF_TEST(removing a path reroutes its cached elements) {
+  // Bob gets less credit than his desired batch size, i.e., his elements wait
+  // in his cache unless we force batches.
+  auto bob_slot = alice.add_path_to(bob, 1000);
+  alice.grant(bob_slot, 500);
+  alice.grant(alice.add_path_to(carl, 1000), 1000);
+  alice.push(1, 100);
+  alice.mgr.out().emit_batches();
+  CAF_CHECK(received(bob).empty());
+  CAF_CHECK(received(carl).empty());
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 100u);
+  alice.mgr.out().remove_path(bob_slot, none, true);
+  alice.mgr.out().force_emit_batches();
+  auto xs = received(carl);
+  std::sort(xs.begin(), xs.end());
+  batch_type expected(100);
+  std::iota(expected.begin(), expected.end(), 1);
+  CAF_CHECK_EQUAL(xs, expected);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
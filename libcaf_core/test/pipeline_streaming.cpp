@@ -147,6 +147,34 @@ TESTEE(sum_up) {
   };
 }
 
+TESTEE_STATE(fixed_credit_sum_up) {
+  int x = 0;
+};
+
+TESTEE(fixed_credit_sum_up) {
+  using intptr = int*;
+  return {
+    [=](stream<int>& in) {
+      return self->make_sink(
+        // input stream
+        in,
+        // initialize state
+        [=](intptr& x) {
+          x = &self->state.x;
+        },
+        // processing step
+        [](intptr& x, int y) {
+          *x += y;
+        },
+        // cleanup
+        fin<intptr>(self),
+        // allow 10 items in flight, sent in batches of 5
+        fixed_credit(10, 5)
+      );
+    }
+  };
+}
+
 TESTEE_STATE(delayed_sum_up) {
   int x = 0;
 };
@@ -271,6 +299,29 @@ CAF_TEST(depth_2_pipeline_50_items) {
   CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.x, 1275);
 }
 
+CAF_TEST(depth_2_pipeline_with_fixed_credit) {
+  auto src = sys.spawn(file_reader, 50u);
+  auto snk = sys.spawn(fixed_credit_sum_up);
+  CAF_MESSAGE(CAF_ARG(self) << CAF_ARG(src) << CAF_ARG(snk));
+  CAF_MESSAGE("initiate stream handshake");
+  self->send(snk * src, "numbers.txt");
+  expect((string), from(self).to(src).with("numbers.txt"));
+  expect((open_stream_msg), from(self).to(snk));
+  expect((upstream_msg::ack_open), from(snk).to(src));
+  CAF_MESSAGE("the initial credit allows two batches of 5 items");
+  expect((downstream_msg::batch), from(src).to(snk));
+  expect((downstream_msg::batch), from(src).to(snk));
+  disallow((downstream_msg::batch), from(src).to(snk));
+  CAF_CHECK_EQUAL(deref<fixed_credit_sum_up_actor>(snk).state.x, 55);
+  CAF_MESSAGE("the sink grants new credit in each credit round");
+  auto& st = deref<fixed_credit_sum_up_actor>(snk).state;
+  for (int i = 0; i < 10 && st.x != 1275; ++i) {
+    tick();
+    run();
+  }
+  CAF_CHECK_EQUAL(st.x, 1275);
+}
+
 CAF_TEST(depth_2_pipeline_setup2_50_items) {
   auto src = sys.spawn(file_reader, 50u);
   auto snk = sys.spawn(sum_up);
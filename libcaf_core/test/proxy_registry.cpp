@@ -0,0 +1,221 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE proxy_registry
+
+#include "caf/proxy_registry.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
+#include "caf/make_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+// Creates proxies that forward to no broker and counts all created proxies.
+class counting_backend : public proxy_registry::backend {
+public:
+  counting_backend(actor_system& sys) : created(0), sys_(sys) {
+    // nop
+  }
+
+  strong_actor_ptr make_proxy(node_id nid, actor_id aid) override {
+    ++created;
+    if (before_make)
+      before_make(aid);
+    actor_config cfg;
+    return make_actor<forwarding_actor_proxy, strong_actor_ptr>(
+      aid, std::move(nid), &sys_, cfg, actor{});
+  }
+
+  execution_unit* registry_context() override {
+    return sys_.dummy_execution_unit();
+  }
+
+  std::atomic<size_t> created;
+
+  // Runs before creating a proxy, without any lock of the registry held.
+  std::function<void(actor_id)> before_make;
+
+private:
+  actor_system& sys_;
+};
+
+struct fixture {
+  fixture() : sys(cfg), be(sys), reg(sys, be) {
+    // nop
+  }
+
+  // Returns a node ID that differs from all other nodes in its process ID.
+  static node_id node(uint32_t pid) {
+    return node_id{pid, std::string(40, 'a')};
+  }
+
+  actor_system_config cfg;
+  actor_system sys;
+  counting_backend be;
+  proxy_registry reg;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(proxy_registry_tests, fixture)
+
+CAF_TEST(get_or_put creates each proxy once) {
+  auto nid = node(1);
+  CAF_CHECK_EQUAL(reg.get(nid, 42), nullptr);
+  auto x = reg.get_or_put(nid, 42);
+  CAF_REQUIRE_NOT_EQUAL(x, nullptr);
+  CAF_CHECK_EQUAL(x->id(), 42u);
+  CAF_CHECK_EQUAL(x->node(), nid);
+  CAF_CHECK_EQUAL(reg.get(nid, 42), x);
+  CAF_CHECK_EQUAL(reg.get_or_put(nid, 42), x);
+  CAF_CHECK_EQUAL(be.created.load(), 1u);
+  CAF_CHECK_EQUAL(reg.count_proxies(nid), 1u);
+  CAF_CHECK_EQUAL(reg.get(nid, 43), nullptr);
+  CAF_CHECK_EQUAL(reg.get(node(2), 42), nullptr);
+}
+
+CAF_TEST(proxies of many nodes spread across shards) {
+  const uint32_t num_nodes = 100;
+  for (uint32_t pid = 1; pid <= num_nodes; ++pid)
+    for (actor_id aid = 1; aid <= pid % 3 + 1; ++aid)
+      reg.get_or_put(node(pid), aid);
+  CAF_CHECK_EQUAL(reg.size(), num_nodes);
+  CAF_CHECK(!reg.empty());
+  for (uint32_t pid = 1; pid <= num_nodes; ++pid) {
+    auto nid = node(pid);
+    auto xs = reg.get_all(nid);
+    CAF_CHECK_EQUAL(reg.count_proxies(nid), pid % 3 + 1);
+    CAF_CHECK_EQUAL(xs.size(), pid % 3 + 1);
+    for (auto& x : xs) {
+      CAF_CHECK_EQUAL(x->node(), nid);
+      CAF_CHECK_EQUAL(reg.get(nid, x->id()), x);
+    }
+  }
+  reg.clear();
+  CAF_CHECK(reg.empty());
+  CAF_CHECK_EQUAL(reg.size(), 0u);
+}
+
+CAF_TEST(erasing a node removes only its proxies) {
+  auto x = reg.get_or_put(node(1), 1);
+  reg.get_or_put(node(1), 2);
+  auto y = reg.get_or_put(node(2), 1);
+  reg.erase(node(1));
+  CAF_CHECK_EQUAL(reg.count_proxies(node(1)), 0u);
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), nullptr);
+  CAF_CHECK(reg.get_all(node(1)).empty());
+  CAF_CHECK_EQUAL(reg.get(node(2), 1), y);
+  CAF_CHECK_EQUAL(reg.size(), 1u);
+  CAF_MESSAGE("erased proxies terminate");
+  CAF_CHECK(x->get()->getf(abstract_actor::is_terminated_flag));
+  CAF_CHECK(!y->get()->getf(abstract_actor::is_terminated_flag));
+  CAF_MESSAGE("erasing unknown nodes has no effect");
+  reg.erase(node(3));
+  CAF_CHECK_EQUAL(reg.size(), 1u);
+}
+
+CAF_TEST(erasing a single proxy keeps all others) {
+  reg.get_or_put(node(1), 1);
+  auto x = reg.get_or_put(node(1), 2);
+  reg.erase(node(1), 1);
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), nullptr);
+  CAF_CHECK_EQUAL(reg.get(node(1), 2), x);
+  reg.erase(node(1), 2);
+  CAF_CHECK_EQUAL(reg.size(), 0u);
+  CAF_MESSAGE("get_or_put creates a new proxy after erasing the old one");
+  auto y = reg.get_or_put(node(1), 2);
+  CAF_CHECK_NOT_EQUAL(y, x);
+  CAF_CHECK_EQUAL(be.created.load(), 3u);
+}
+
+CAF_TEST(shared registries agree on a single proxy) {
+  counting_backend other_be{sys};
+  proxy_registry other{sys, other_be};
+  other.share(reg);
+  auto x = reg.get_or_put(node(1), 1);
+  CAF_CHECK_EQUAL(other.get_or_put(node(1), 1), x);
+  CAF_CHECK_EQUAL(other_be.created.load(), 0u);
+  other.erase(node(1));
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), nullptr);
+}
+
+CAF_TEST(concurrent get_or_put calls create each proxy once) {
+  const size_t num_threads = 4;
+  const actor_id num_actors = 50;
+  std::vector<std::vector<strong_actor_ptr>> results(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&, i] {
+      for (actor_id aid = 1; aid <= num_actors; ++aid)
+        results[i].emplace_back(reg.get_or_put(node(aid % 2 + 1), aid));
+    });
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(be.created.load(), num_actors);
+  for (size_t i = 1; i < num_threads; ++i)
+    CAF_CHECK(results[i] == results[0]);
+}
+
+CAF_TEST(creating a proxy does not block other proxies of the same node) {
+  std::atomic<bool> entered{false};
+  std::atomic<bool> released{false};
+  be.before_make = [&](actor_id aid) {
+    if (aid != 1)
+      return;
+    entered = true;
+    while (!released)
+      std::this_thread::yield();
+  };
+  strong_actor_ptr x;
+  std::thread t{[&] { x = reg.get_or_put(node(1), 1); }};
+  while (!entered)
+    std::this_thread::yield();
+  auto y = reg.get_or_put(node(1), 2);
+  CAF_CHECK_NOT_EQUAL(y, nullptr);
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), nullptr);
+  released = true;
+  t.join();
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), x);
+  CAF_CHECK_EQUAL(reg.count_proxies(node(1)), 2u);
+}
+
+CAF_TEST(erasing a node discards proxies under construction) {
+  be.before_make = [&](actor_id) {
+    reg.erase(node(1));
+  };
+  auto x = reg.get_or_put(node(1), 1);
+  CAF_REQUIRE_NOT_EQUAL(x, nullptr);
+  CAF_CHECK(x->get()->getf(abstract_actor::is_terminated_flag));
+  CAF_CHECK_EQUAL(reg.get(node(1), 1), nullptr);
+  CAF_CHECK(reg.empty());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
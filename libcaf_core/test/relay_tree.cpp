@@ -0,0 +1,95 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE relay_tree
+
+#include "caf/detail/relay_tree.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <utility>
+
+using namespace caf;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+using tree_type = detail::relay_tree<int>;
+
+struct fixture {
+  // Collects the peers visited by `tree.for_each_root`.
+  ivec roots(const tree_type& tree) {
+    ivec result;
+    tree.for_each_root([&](int x) { result.emplace_back(x); });
+    return result;
+  }
+
+  // Collects the updates of `tree.sync`.
+  std::vector<std::pair<int, ivec>> sync(tree_type& tree) {
+    std::vector<std::pair<int, ivec>> result;
+    tree.sync([&](int x, const ivec& xs) { result.emplace_back(x, xs); });
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(relay_tree_tests, fixture)
+
+CAF_TEST(a fan-out of zero disables relaying) {
+  tree_type tree;
+  for (auto i = 1; i <= 5; ++i)
+    tree.add(i);
+  CAF_CHECK_EQUAL(roots(tree), ivec({1, 2, 3, 4, 5}));
+  CAF_CHECK_EQUAL(tree.children(0), ivec());
+  CAF_CHECK(sync(tree).empty());
+}
+
+CAF_TEST(peers form an implicit tree) {
+  tree_type tree{2};
+  for (auto i = 1; i <= 7; ++i)
+    tree.add(i);
+  CAF_CHECK(!tree.add(3));
+  CAF_CHECK_EQUAL(tree.size(), 7u);
+  CAF_CHECK_EQUAL(roots(tree), ivec({1, 2}));
+  CAF_CHECK_EQUAL(tree.num_roots(), 2u);
+  CAF_CHECK_EQUAL(tree.children(0), ivec({3, 4}));
+  CAF_CHECK_EQUAL(tree.children(1), ivec({5, 6}));
+  CAF_CHECK_EQUAL(tree.children(2), ivec({7}));
+  CAF_CHECK_EQUAL(tree.children(3), ivec());
+}
+
+CAF_TEST(sync reports changed children only) {
+  tree_type tree{2};
+  for (auto i = 1; i <= 4; ++i)
+    tree.add(i);
+  using update = std::pair<int, ivec>;
+  CAF_CHECK_EQUAL(sync(tree), std::vector<update>({{1, {3, 4}}}));
+  CAF_CHECK(sync(tree).empty());
+  tree.add(5);
+  CAF_CHECK_EQUAL(sync(tree), std::vector<update>({{2, {5}}}));
+  // Removing 1 moves 5 to the front and leaves 2 without children.
+  CAF_CHECK(tree.remove(1));
+  CAF_CHECK(!tree.remove(1));
+  CAF_CHECK_EQUAL(roots(tree), ivec({5, 2}));
+  CAF_CHECK_EQUAL(sync(tree), std::vector<update>({{5, {3, 4}}, {2, {}}}));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -263,6 +263,26 @@ behavior ping_multiplexed3(ping_actor* self, bool* had_timeout,
   return {};
 }
 
+// sends requests with a timeout and counts the responses
+behavior ping_many(ping_actor* self, int* responses, const actor& buddy) {
+  for (auto i = 0; i < 10; ++i)
+    self->request(buddy, seconds(10), ping_atom::value).then(
+      [=](pong_atom) {
+        ++*responses;
+      }
+    );
+  self->request(buddy, seconds(10), ping_atom::value).await(
+    [=](pong_atom) {
+      ++*responses;
+    }
+  );
+  return {
+    [=](timeout_atom) {
+      self->quit();
+    }
+  };
+}
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(request_timeout_tests, test_coordinator_fixture<>)
@@ -342,4 +362,17 @@ CAF_TEST(multiplexed_timeout) {
   }
 }
 
+CAF_TEST(responses_cancel_request_timeouts) {
+  int responses = 0;
+  auto testee = sys.spawn(ping_many, &responses, sys.spawn<lazy_init>(pong));
+  sched.run_once();
+  CAF_CHECK_EQUAL(sched.clock().schedule().size(), 11u);
+  sched.run();
+  CAF_CHECK_EQUAL(responses, 11);
+  CAF_CHECK_EQUAL(sched.clock().schedule().size(), 0u);
+  CAF_CHECK_EQUAL(sched.clock().actor_lookup().size(), 0u);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+  sched.run();
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
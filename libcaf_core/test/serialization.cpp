@@ -60,6 +60,7 @@
 #include "caf/make_type_erased_view.hpp"
 #include "caf/make_type_erased_tuple_view.hpp"
 
+#include "caf/detail/dynamic_message_data.hpp"
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/int_list.hpp"
 #include "caf/detail/safe_equal.hpp"
@@ -135,6 +136,7 @@ public:
     add_message_type<test_array>("test_array");
     add_message_type<test_empty_non_pod>("test_empty_non_pod");
     add_message_type<std::vector<bool>>("bool_vector");
+    add_message_signature<int32_t, string, raw_struct>();
   }
 };
 
@@ -184,6 +186,27 @@ struct fixture {
     return result;
   }
 
+  // serializes `xs` element by element, i.e., bypasses bulk processing
+  template <class T>
+  vector<char> serialize_elementwise(vector<T>& xs) {
+    vector<char> buf;
+    binary_serializer bs{&context, buf};
+    auto s = xs.size();
+    bs.begin_sequence(s);
+    for (auto& x : xs)
+      bs(x);
+    bs.end_sequence();
+    return buf;
+  }
+
+  // checks that bulk serialization of `xs` produces the same output as
+  // serializing its elements individually and that `xs` survives a roundtrip
+  template <class T>
+  void check_arithmetic_sequence(vector<T> xs) {
+    CAF_CHECK_EQUAL(serialize(xs), serialize_elementwise(xs));
+    CAF_CHECK_EQUAL(roundtrip(xs), xs);
+  }
+
   // converts `x` to a message, serialize it, then deserializes it, and
   // finally returns unboxed value
   template <class T>
@@ -384,6 +407,56 @@ CAF_TEST(multiple_messages) {
   CAF_CHECK(is_message(m2).equal(i32, i64, dur, ts, te, str, rs));
 }
 
+CAF_TEST(messages_with_signature) {
+  auto is_dynamic = [](const message& x) {
+    using detail::dynamic_message_data;
+    return dynamic_cast<const dynamic_message_data*>(x.cvals().get())
+           != nullptr;
+  };
+  auto m = make_message(i32, str, rs);
+  message x;
+  deserialize(serialize(m), x);
+  CAF_CHECK(!is_dynamic(x));
+  CAF_CHECK(is_message(x).equal(i32, str, rs));
+  std::vector<uint16_t> ids(system.types().type_names().size() + 1);
+  for (size_t i = 0; i < ids.size(); ++i)
+    ids[i] = static_cast<uint16_t>(i);
+  vector<char> buf;
+  binary_serializer bs{&context, buf};
+  CAF_REQUIRE(!m.save_compact(bs));
+  message y;
+  binary_deserializer bd{&context, buf};
+  CAF_REQUIRE(!y.load_compact(bd, ids));
+  CAF_CHECK(!is_dynamic(y));
+  CAF_CHECK(is_message(y).equal(i32, str, rs));
+  // messages without factory still use dynamic_message_data
+  auto m2 = make_message(str, i32);
+  message z;
+  deserialize(serialize(m2), z);
+  CAF_CHECK(is_dynamic(z));
+  CAF_CHECK(is_message(z).equal(str, i32));
+}
+
+CAF_TEST(compact_messages) {
+  // map each type ID to itself, i.e., assume the sender has our type IDs
+  std::vector<uint16_t> ids(system.types().type_names().size() + 1);
+  for (size_t i = 0; i < ids.size(); ++i)
+    ids[i] = static_cast<uint16_t>(i);
+  vector<char> buf;
+  binary_serializer bs{&context, buf};
+  CAF_REQUIRE(!msg.save_compact(bs));
+  CAF_CHECK_LESS(buf.size(), serialize(msg).size());
+  message x;
+  binary_deserializer bd{&context, buf};
+  CAF_REQUIRE(!x.load_compact(bd, ids));
+  CAF_CHECK_EQUAL(to_string(msg), to_string(x));
+  CAF_CHECK(is_message(x).equal(i32, i64, dur, ts, te, str, rs));
+  // type IDs without local counterpart result in an error
+  message y;
+  binary_deserializer bd2{&context, buf};
+  CAF_CHECK_NOT_EQUAL(y.load_compact(bd2, {0}), none);
+}
+
 
 CAF_TEST(type_erased_value) {
   auto buf = serialize(str);
@@ -487,6 +560,39 @@ CAF_TEST(non-empty vector) {
 // -- our vector<bool> serialization packs into an uint64_t. Hence, the
 // critical sizes to test are 0, 1, 63, 64, and 65.
 
+CAF_TEST(arithmetic_sequences) {
+  // Use more than 128 elements to cover multiple chunks.
+  vector<int32_t> xs;
+  for (int32_t i = 0; i < 300; ++i)
+    xs.push_back(i * -4567);
+  check_arithmetic_sequence(xs);
+  check_arithmetic_sequence(vector<uint16_t>(xs.begin(), xs.end()));
+  check_arithmetic_sequence(vector<int64_t>(xs.begin(), xs.end()));
+  check_arithmetic_sequence(vector<int8_t>(xs.begin(), xs.end()));
+  vector<double> ys;
+  for (auto x : xs)
+    ys.push_back(x / 3.);
+  check_arithmetic_sequence(ys);
+  check_arithmetic_sequence(vector<float>(ys.begin(), ys.end()));
+  check_arithmetic_sequence(vector<double>{});
+}
+
+CAF_TEST(truncated_arithmetic_sequences) {
+  vector<int32_t> xs{1, 2, 3};
+  auto buf = serialize(xs);
+  buf.pop_back();
+  vector<int32_t> ys;
+  binary_deserializer bd{&context, buf};
+  auto err = bd(ys);
+  CAF_CHECK(err != none);
+  vector<double> zs{1., 2., 3.};
+  buf = serialize(zs);
+  buf.pop_back();
+  binary_deserializer bd2{&context, buf};
+  err = bd2(zs);
+  CAF_CHECK(err != none);
+}
+
 CAF_TEST(bool_vector_size_0) {
   std::vector<bool> xs;
   CAF_CHECK_EQUAL(deep_to_string(xs), "[]");
@@ -0,0 +1,218 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE shared_batches
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/stateful_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+TESTEE_SETUP();
+
+// Counts how many times the test copies stream elements.
+size_t copies = 0;
+
+struct item {
+  int value;
+
+  item(int x = 0) : value(x) {
+    // nop
+  }
+
+  item(item&&) = default;
+
+  item(const item& other) : value(other.value) {
+    ++copies;
+  }
+
+  item& operator=(item&&) = default;
+
+  item& operator=(const item& other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+};
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, item& x) {
+  return f(meta::type_name("item"), x.value);
+}
+
+// Streams the numbers `1, ..., num_items` to all sinks.
+VARARGS_TESTEE(broadcaster, int num_items) {
+  return {
+    [=](const std::vector<actor>& sinks) {
+      auto res = self->make_source(
+        sinks.front(),
+        // initialize state
+        [](int& x) {
+          x = 0;
+        },
+        // get next element
+        [=](int& x, downstream<item>& out, size_t hint) {
+          auto n = std::min(num_items - x, static_cast<int>(hint));
+          for (int i = 0; i < n; ++i)
+            out.push(item{++x});
+        },
+        // check whether we reached the end
+        [=](const int& x) {
+          return x == num_items;
+        }
+      );
+      for (size_t i = 1; i < sinks.size(); ++i)
+        res.ptr()->add_outbound_path(sinks[i]);
+    }
+  };
+}
+
+TESTEE_STATE(reader) {
+  std::vector<const item*> addresses;
+  std::vector<int> values;
+  bool done = false;
+};
+
+// Reads batches without modifying them.
+TESTEE(reader) {
+  return {
+    [=](stream<item> in) {
+      return self->make_sink(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [=](unit_t&, const std::vector<item>& xs) {
+          for (auto& x : xs) {
+            self->state.addresses.emplace_back(&x);
+            self->state.values.emplace_back(x.value);
+          }
+        },
+        [=](unit_t&, const error&) {
+          self->state.done = true;
+        }
+      );
+    }
+  };
+}
+
+TESTEE_STATE(writer) {
+  std::vector<int> values;
+  bool done = false;
+};
+
+// Negates all elements in each batch.
+TESTEE(writer) {
+  return {
+    [=](stream<item> in) {
+      return self->make_sink(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [=](unit_t&, std::vector<item>& xs) {
+          for (auto& x : xs) {
+            x.value = -x.value;
+            self->state.values.emplace_back(x.value);
+          }
+        },
+        [=](unit_t&, const error&) {
+          self->state.done = true;
+        }
+      );
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() {
+    copies = 0;
+  }
+
+  void tick() {
+    advance_time(cfg.stream_credit_round_interval);
+  }
+
+  // Streams `num_items` elements from a new source to all `sinks`.
+  template <class F>
+  void run_broadcast(int num_items, std::vector<actor> sinks, F all_done) {
+    auto src = sys.spawn(broadcaster, num_items);
+    self->send(src, std::move(sinks));
+    run();
+    for (int i = 0; i < 50 && !all_done(); ++i) {
+      tick();
+      run();
+    }
+    CAF_REQUIRE(all_done());
+  }
+
+  static std::vector<int> iota(int num_items, int sign = 1) {
+    std::vector<int> result;
+    for (int x = 1; x <= num_items; ++x)
+      result.emplace_back(x * sign);
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+// -- unit tests ---------------------------------------------------------------
+
+CAF_TEST_FIXTURE_SCOPE(shared_batches_tests, fixture)
+
+CAF_TEST(local sinks share broadcast batches without copying) {
+  std::vector<actor> sinks{sys.spawn(reader), sys.spawn(reader),
+                           sys.spawn(reader)};
+  std::vector<reader_state*> states;
+  for (auto& x : sinks)
+    states.emplace_back(&deref<reader_actor>(x).state);
+  run_broadcast(100, sinks, [&] {
+    return std::all_of(states.begin(), states.end(),
+                       [](reader_state* st) { return st->done; });
+  });
+  for (auto st : states) {
+    CAF_CHECK_EQUAL(st->values, iota(100));
+    CAF_CHECK(st->addresses == states.front()->addresses);
+  }
+  CAF_CHECK_EQUAL(copies, 0u);
+}
+
+CAF_TEST(sinks modifying batches do not affect other sinks) {
+  std::vector<actor> sinks{sys.spawn(reader), sys.spawn(writer),
+                           sys.spawn(reader)};
+  auto& st1 = deref<reader_actor>(sinks[0]).state;
+  auto& st2 = deref<writer_actor>(sinks[1]).state;
+  auto& st3 = deref<reader_actor>(sinks[2]).state;
+  run_broadcast(100, sinks, [&] {
+    return st1.done && st2.done && st3.done;
+  });
+  CAF_CHECK_EQUAL(st1.values, iota(100));
+  CAF_CHECK_EQUAL(st2.values, iota(100, -1));
+  CAF_CHECK_EQUAL(st3.values, iota(100));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
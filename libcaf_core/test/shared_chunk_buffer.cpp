@@ -0,0 +1,93 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE shared_chunk_buffer
+
+#include "caf/detail/shared_chunk_buffer.hpp"
+
+#include "caf/test/dsl.hpp"
+
+using namespace caf;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+using buffer_type = detail::shared_chunk_buffer<int>;
+
+struct fixture {
+  buffer_type buf;
+
+  static const ivec& elements(const message& x) {
+    return buffer_type::elements(x);
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(shared_chunk_buffer_tests, fixture)
+
+CAF_TEST(taking entire chunks shares them) {
+  auto chunk = buffer_type::make_chunk(ivec{1, 2, 3});
+  buf.push_back(chunk);
+  CAF_CHECK_EQUAL(buf.size(), 3u);
+  auto xs = buf.take(3);
+  CAF_CHECK(buf.empty());
+  CAF_CHECK_EQUAL(xs.cvals().get(), chunk.cvals().get());
+  CAF_CHECK_EQUAL(elements(xs), ivec({1, 2, 3}));
+}
+
+CAF_TEST(taking partial chunks copies elements) {
+  auto chunk = buffer_type::make_chunk(ivec{1, 2, 3});
+  buf.push_back(chunk);
+  auto xs = buf.take(2);
+  CAF_CHECK_NOT_EQUAL(xs.cvals().get(), chunk.cvals().get());
+  CAF_CHECK_EQUAL(elements(xs), ivec({1, 2}));
+  auto ys = buf.take(1);
+  CAF_CHECK_EQUAL(elements(ys), ivec({3}));
+  CAF_CHECK(buf.empty());
+}
+
+CAF_TEST(batches may span multiple chunks) {
+  buf.push_back(buffer_type::make_chunk(ivec{1, 2}));
+  buf.push_back(buffer_type::make_chunk(ivec{3, 4, 5}));
+  CAF_CHECK_EQUAL(buf.size(), 5u);
+  auto xs = buf.take(3);
+  CAF_CHECK_EQUAL(elements(xs), ivec({1, 2, 3}));
+  auto ys = buf.take(2);
+  CAF_CHECK_EQUAL(elements(ys), ivec({4, 5}));
+  CAF_CHECK(buf.empty());
+}
+
+CAF_TEST(index lists select elements from chunks) {
+  auto chunk = buffer_type::make_chunk(ivec{1, 2, 3, 4, 5});
+  buf.push_back(chunk, {0, 2, 4});
+  buf.push_back(chunk, {});
+  buf.push_back(chunk, {0, 1, 2, 3, 4});
+  CAF_CHECK_EQUAL(buf.size(), 8u);
+  auto xs = buf.take(2);
+  CAF_CHECK_EQUAL(elements(xs), ivec({1, 3}));
+  auto ys = buf.take(1);
+  CAF_CHECK_EQUAL(elements(ys), ivec({5}));
+  // Selecting all elements is equivalent to pushing the chunk.
+  auto zs = buf.take(5);
+  CAF_CHECK_EQUAL(zs.cvals().get(), chunk.cvals().get());
+  CAF_CHECK(buf.empty());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE spsc_ringbuffer
+
+#include "caf/detail/spsc_ringbuffer.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+static constexpr size_t buf_size = 64;
+
+using int_ringbuffer = detail::spsc_ringbuffer<int, buf_size>;
+
+struct fixture {
+  int_ringbuffer buf;
+
+  std::vector<int> drain() {
+    std::vector<int> result;
+    buf.consume([&](int& x) { result.emplace_back(x); });
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(spsc_ringbuffer_tests, fixture)
+
+CAF_TEST(construction) {
+  CAF_CHECK_EQUAL(buf.empty(), true);
+  CAF_CHECK_EQUAL(buf.size(), 0u);
+}
+
+CAF_TEST(try_push) {
+  CAF_MESSAGE("add one element");
+  CAF_CHECK(buf.try_push(42));
+  CAF_CHECK_EQUAL(buf.empty(), false);
+  CAF_CHECK_EQUAL(buf.size(), 1u);
+  CAF_CHECK_EQUAL(drain(), std::vector<int>({42}));
+  CAF_CHECK_EQUAL(buf.empty(), true);
+  CAF_MESSAGE("fill buffer");
+  for (int i = 0; i < static_cast<int>(buf_size); ++i)
+    CAF_CHECK(buf.try_push(std::move(i)));
+  CAF_CHECK_EQUAL(buf.size(), buf_size);
+  CAF_CHECK(!buf.try_push(-1));
+  auto xs = drain();
+  CAF_REQUIRE_EQUAL(xs.size(), buf_size);
+  CAF_CHECK_EQUAL(xs.front(), 0);
+  CAF_CHECK_EQUAL(xs.back(), static_cast<int>(buf_size - 1));
+  CAF_CHECK(buf.try_push(1));
+}
+
+CAF_TEST(concurrent access) {
+  std::thread producer{[&] {
+    for (int i = 0; i < 10000; ++i) {
+      auto x = i;
+      while (!buf.try_push(std::move(x)))
+        std::this_thread::yield();
+    }
+  }};
+  std::vector<int> xs;
+  while (xs.size() < 10000u) {
+    if (buf.consume([&](int& x) { xs.emplace_back(x); }) == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+  auto in_order = true;
+  for (size_t i = 0; i < xs.size(); ++i)
+    if (xs[i] != static_cast<int>(i))
+      in_order = false;
+  CAF_CHECK(in_order);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
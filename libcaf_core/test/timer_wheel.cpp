@@ -0,0 +1,180 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE timer_wheel
+
+#include "caf/detail/timer_wheel.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/stateful_actor.hpp"
+
+using namespace caf;
+
+using std::chrono::milliseconds;
+
+namespace {
+
+using tick_type = detail::timer_wheel::tick_type;
+
+struct timer : detail::timer_wheel::node {
+  tick_type fired_at = 0;
+};
+
+struct fixture {
+  detail::timer_wheel wheel;
+
+  /// Expiries of all timers in firing order.
+  std::vector<tick_type> fired;
+
+  void advance(tick_type t) {
+    wheel.advance(t, [&](detail::timer_wheel::node* x) {
+      static_cast<timer*>(x)->fired_at = wheel.now();
+      fired.emplace_back(x->expiry);
+    });
+  }
+};
+
+using tvec = std::vector<tick_type>;
+
+struct pending_state {
+  std::vector<response_promise> promises;
+};
+
+behavior never_responds(stateful_actor<pending_state>* self) {
+  return {
+    [=](int) {
+      self->state.promises.emplace_back(self->make_response_promise());
+    }
+  };
+}
+
+// Sends requests with the given timeouts in milliseconds to `aut` and tells
+// `listener` whenever a request times out.
+behavior timeout_observer(event_based_actor* self, actor aut, actor listener,
+                          std::vector<int> timeouts) {
+  for (auto t : timeouts)
+    self->request(aut, milliseconds(t), t).then(
+      [](int) {
+        CAF_FAIL("unexpected response");
+      },
+      [=](error& err) {
+        CAF_CHECK_EQUAL(err, sec::request_timeout);
+        self->send(listener, t);
+      }
+    );
+  return {
+    [](ok_atom) {
+      // nop
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(timer_wheel_tests, fixture)
+
+CAF_TEST(timers fire at their expiry) {
+  tvec expiries{1, 2, 255, 256, 257, 300, 65535, 65536, 70000};
+  std::vector<timer> timers(expiries.size());
+  for (size_t i = 0; i < expiries.size(); ++i)
+    wheel.insert(&timers[i], expiries[i]);
+  CAF_CHECK_EQUAL(wheel.size(), expiries.size());
+  CAF_CHECK_EQUAL(wheel.next_tick(), 1u);
+  for (tick_type t = 1; t <= 70000; ++t)
+    advance(t);
+  CAF_CHECK_EQUAL(fired, expiries);
+  CAF_CHECK(wheel.empty());
+  for (auto& x : timers)
+    CAF_CHECK_EQUAL(x.fired_at, x.expiry);
+}
+
+CAF_TEST(advancing skips ticks without timers) {
+  tvec expiries{5, 1000, 1u << 20, (1ull << 24) + 5, (1ull << 32) + 7,
+                (1ull << 40) + 3};
+  std::vector<timer> timers(expiries.size());
+  for (size_t i = 0; i < expiries.size(); ++i)
+    wheel.insert(&timers[i], expiries[i]);
+  advance(1ull << 41);
+  CAF_CHECK_EQUAL(fired, expiries);
+  CAF_CHECK_EQUAL(wheel.now(), 1ull << 41);
+  for (auto& x : timers)
+    CAF_CHECK_EQUAL(x.fired_at, x.expiry);
+  CAF_CHECK_EQUAL(wheel.next_tick(), detail::timer_wheel::infinite);
+}
+
+CAF_TEST(timers in the past expire on the next advance) {
+  advance(100);
+  timer x;
+  wheel.insert(&x, 50);
+  CAF_CHECK_EQUAL(wheel.next_tick(), 100u);
+  advance(100);
+  CAF_CHECK_EQUAL(fired, tvec({50}));
+}
+
+CAF_TEST(erased timers never fire) {
+  std::vector<timer> timers(3);
+  wheel.insert(&timers[0], 10);
+  wheel.insert(&timers[1], 20000);
+  wheel.insert(&timers[2], 30);
+  wheel.erase(&timers[1]);
+  wheel.erase(&timers[2]);
+  CAF_CHECK_EQUAL(wheel.size(), 1u);
+  advance(100000);
+  CAF_CHECK_EQUAL(fired, tvec({10}));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(the timer wheel clock fires actor timeouts in order) {
+  actor_system_config cfg;
+  cfg.set("scheduler.clock", atom("wheel"));
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  // Receives `xs` in order.
+  auto receive_all = [&](const std::vector<int>& xs) {
+    for (auto x : xs)
+      self->receive(
+        [&](int y) {
+          CAF_CHECK_EQUAL(y, x);
+        },
+        after(std::chrono::seconds(5)) >> [] {
+          CAF_FAIL("timeout did not fire");
+        }
+      );
+  };
+  CAF_MESSAGE("delayed messages arrive in order of their delay");
+  for (auto x : {40, 20, 50, 10, 30})
+    self->delayed_send(self, milliseconds(x), x);
+  receive_all({10, 20, 30, 40, 50});
+  CAF_MESSAGE("requests time out in order of their timeout");
+  auto aut = sys.spawn(never_responds);
+  auto obs = sys.spawn(timeout_observer, aut, actor{self},
+                       std::vector<int>{30, 10, 50, 20, 40});
+  receive_all({10, 20, 30, 40, 50});
+  anon_send_exit(obs, exit_reason::user_shutdown);
+  anon_send_exit(aut, exit_reason::user_shutdown);
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#define CAF_SUITE work_stealing_deque
+
+#include "caf/detail/work_stealing_deque.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using deque_type = detail::work_stealing_deque<int>;
+
+struct fixture {
+  fixture() : uut(4, 4), values(100) {
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = static_cast<int>(i);
+  }
+
+  int* ptr(size_t x) {
+    return &values[x];
+  }
+
+  deque_type uut;
+  std::vector<int> values;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(work_stealing_deque_tests, fixture)
+
+CAF_TEST(construction) {
+  CAF_CHECK(uut.empty());
+  CAF_CHECK(uut.take_head() == nullptr);
+  CAF_CHECK(uut.take_tail() == nullptr);
+}
+
+CAF_TEST(owner operations are LIFO) {
+  for (size_t i = 0; i < 3; ++i)
+    uut.prepend(ptr(i));
+  CAF_CHECK(!uut.empty());
+  CAF_CHECK_EQUAL(*uut.take_head(), 2);
+  CAF_CHECK_EQUAL(*uut.take_head(), 1);
+  CAF_CHECK_EQUAL(*uut.take_head(), 0);
+  CAF_CHECK(uut.take_head() == nullptr);
+  CAF_CHECK(uut.empty());
+}
+
+CAF_TEST(thieves steal the oldest element) {
+  for (size_t i = 0; i < 3; ++i)
+    uut.prepend(ptr(i));
+  CAF_CHECK_EQUAL(*uut.take_tail(), 0);
+  CAF_CHECK_EQUAL(*uut.take_head(), 2);
+  CAF_CHECK_EQUAL(*uut.take_tail(), 1);
+  CAF_CHECK(uut.empty());
+}
+
+CAF_TEST(the deque grows beyond its initial capacity) {
+  for (size_t i = 0; i < 50; ++i)
+    uut.prepend(ptr(i));
+  for (size_t i = 0; i < 25; ++i)
+    CAF_CHECK_EQUAL(*uut.take_tail(), static_cast<int>(i));
+  for (size_t i = 50; i > 25; --i)
+    CAF_CHECK_EQUAL(*uut.take_head(), static_cast<int>(i - 1));
+  CAF_CHECK(uut.empty());
+}
+
+CAF_TEST(appended elements arrive in FIFO order after local elements) {
+  uut.append(ptr(10));
+  uut.append(ptr(11));
+  uut.prepend(ptr(0));
+  CAF_CHECK_EQUAL(*uut.take_head(), 0);
+  CAF_CHECK_EQUAL(*uut.take_head(), 10);
+  CAF_CHECK_EQUAL(*uut.take_tail(), 11);
+  CAF_CHECK(uut.empty());
+}
+
+CAF_TEST(the inbox overflows without losing elements) {
+  for (size_t i = 0; i < 10; ++i)
+    uut.append(ptr(i));
+  std::vector<int> result;
+  for (auto x = uut.take_head(); x != nullptr; x = uut.take_head())
+    result.push_back(*x);
+  CAF_CHECK_EQUAL(result, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  CAF_CHECK(uut.empty());
+}
+
+CAF_TEST(concurrent stealing) {
+  static constexpr size_t num_items = 20000;
+  static constexpr size_t num_thieves = 3;
+  std::vector<int> items(num_items);
+  std::vector<std::atomic<int>> counts(num_items);
+  for (auto& x : counts)
+    x = 0;
+  std::atomic<bool> done{false};
+  auto consume = [&](int* x) {
+    counts[static_cast<size_t>(x - items.data())].fetch_add(1);
+  };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&] {
+      while (!done) {
+        auto x = uut.take_tail();
+        if (x != nullptr)
+          consume(x);
+        else
+          std::this_thread::yield();
+      }
+    });
+  for (size_t i = 0; i < num_items; ++i) {
+    if (i % 3 == 0)
+      uut.append(&items[i]);
+    else
+      uut.prepend(&items[i]);
+    if (i % 2 == 0) {
+      auto x = uut.take_head();
+      if (x != nullptr)
+        consume(x);
+    }
+  }
+  for (auto x = uut.take_head(); x != nullptr; x = uut.take_head())
+    consume(x);
+  done = true;
+  for (auto& t : thieves)
+    t.join();
+  for (auto x = uut.take_head(); x != nullptr; x = uut.take_head())
+    consume(x);
+  auto once = [](const std::atomic<int>& x) { return x.load() == 1; };
+  CAF_CHECK(std::all_of(counts.begin(), counts.end(), once));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -31,6 +31,7 @@
 #include "caf/io/system_messages.hpp"
 #include "caf/io/connection_handle.hpp"
 
+#include "caf/io/network/io_vec.hpp"
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
 #include "caf/io/network/stream_manager.hpp"
@@ -151,6 +152,10 @@ public:
   /// Writes `data` into the buffer for a given connection.
   void write(connection_handle hdl, size_t bs, const void* buf);
 
+  /// Enqueues `chunk` after the content of the buffer for a given connection
+  /// without copying it, if supported by the transport.
+  void write(connection_handle hdl, network::chunk_ptr chunk);
+
   /// Sends the content of the buffer for a given connection.
   void flush(connection_handle hdl);
 
@@ -424,6 +429,7 @@ private:
   doorman_map doormen_;
   datagram_servant_map datagram_servants_;
   std::vector<char> dummy_wr_buf_;
+  network::multiplexer* backend_;
 };
 
 } // namespace io
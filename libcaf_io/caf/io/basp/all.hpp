@@ -25,6 +25,7 @@
 #include "caf/io/basp/instance.hpp"
 #include "caf/io/basp/message_type.hpp"
 #include "caf/io/basp/routing_table.hpp"
+#include "caf/io/basp/shard_table.hpp"
 #include "caf/io/basp/version.hpp"
 
 /// @defgroup BASP Binary Actor Sytem Protocol
@@ -66,6 +66,10 @@ struct header {
   /// Identifies a receiver by name rather than ID.
   static const uint8_t named_receiver_flag = 0x01;
 
+  /// Marks handshakes that carry the type-ID table of the sender and
+  /// messages that use type IDs instead of type names.
+  static const uint8_t type_ids_flag = 0x02;
+
   /// Queries whether this header has the given flag.
   bool has(uint8_t flag) const {
     return (flags & flag) != 0;
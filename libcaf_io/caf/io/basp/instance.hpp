@@ -19,6 +19,9 @@
 #pragma once
 
 #include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "caf/error.hpp"
 #include "caf/variant.hpp"
@@ -110,6 +113,9 @@ public:
     /// Returns a reference to the sent buffer.
     virtual buffer_type& get_buffer(connection_handle hdl) = 0;
 
+    /// Enqueues `chunk` after the content of the sent buffer.
+    virtual void write(connection_handle hdl, network::chunk_ptr chunk) = 0;
+
     /// Flushes the underlying write buffer of `hdl`.
     virtual void flush(connection_handle hdl) = 0;
 
@@ -172,9 +178,13 @@ public:
 
   /// Returns the routing table of this BASP instance.
   routing_table& tbl() {
-    return tbl_;
+    return *tbl_;
   }
 
+  /// Replaces the routing table of this instance with the routing table of
+  /// `other`, allowing several brokers to share their routes.
+  void share_routing_table(instance& other);
+
   /// Stores the address of a published actor along with its publicly
   /// visible messaging interface.
   using published_actor = std::pair<strong_actor_ptr, std::set<std::string>>;
@@ -231,14 +241,29 @@ public:
   bool handle(execution_unit* ctx, connection_handle hdl, header& hdr,
               std::vector<char>* payload);
 
+  /// Removes the type-ID table received via `hdl`.
+  void erase_type_ids(connection_handle hdl);
+
 private:
+  /// Stores the type-ID table of the peer at `hdl`, mapping each of its type
+  /// IDs to our local type IDs.
+  void add_type_ids(connection_handle hdl,
+                    const std::vector<std::string>& type_names);
+
+  /// Returns the type-ID table of the peer at `hdl` or `nullptr` if the peer
+  /// does not use compact type IDs.
+  const std::vector<uint16_t>* type_ids(connection_handle hdl) const;
+
   void forward(execution_unit* ctx, const node_id& dest_node, const header& hdr,
                std::vector<char>& payload);
 
-  routing_table tbl_;
+  std::shared_ptr<routing_table> tbl_;
+  abstract_broker* parent_;
   published_actor_map published_actors_;
   node_id this_node_;
   callee& callee_;
+  bool compact_type_ids_;
+  std::unordered_map<connection_handle, std::vector<uint16_t>> type_ids_;
 };
 
 /// @}
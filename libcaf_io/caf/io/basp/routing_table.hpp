@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -33,7 +34,9 @@ namespace basp {
 /// @addtogroup BASP
 
 /// Stores routing information for a single broker participating as
-/// BASP peer and provides both direct and indirect paths.
+/// BASP peer and provides both direct and indirect paths. All member
+/// functions are thread-safe, which allows several brokers to share a single
+/// routing table.
 class routing_table {
 public:
 
@@ -43,7 +46,7 @@ public:
 
   /// Describes a routing path to a node.
   struct route {
-    const node_id& next_hop;
+    node_id next_hop;
     connection_handle hdl;
   };
 
@@ -66,9 +69,10 @@ public:
   /// or `none` if there's no indirect route to `nid`.
   node_id lookup_indirect(const node_id& nid) const;
 
-  /// Adds a new direct route to the table.
+  /// Adds a new direct route to the table. Returns `false` if the table
+  /// already contains a direct route to `nid`, `true` otherwise.
   /// @pre `hdl != invalid_connection_handle && nid != none`
-  void add_direct(const connection_handle& hdl, const node_id& nid);
+  bool add_direct(const connection_handle& hdl, const node_id& nid);
 
   /// Adds a new indirect route to the table.
   bool add_indirect(const node_id& hop, const node_id& dest);
@@ -99,7 +103,7 @@ public:
     return parent_;
   }
 
-public:
+private:
   template <class Map, class Fallback>
   typename Map::mapped_type
   get_opt(const Map& m, const typename Map::key_type& k, Fallback&& x) const {
@@ -115,6 +119,7 @@ public:
                                               node_id_set>; // hop
 
   abstract_broker* parent_;
+  mutable std::mutex mtx_;
   std::unordered_map<connection_handle, node_id> direct_by_hdl_;
   std::unordered_map<node_id, connection_handle> direct_by_nid_;
   indirect_entries indirect_;
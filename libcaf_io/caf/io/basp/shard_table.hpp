@@ -0,0 +1,79 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+#include "caf/actor.hpp"
+
+#include "caf/io/connection_handle.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// @addtogroup BASP
+
+/// Assigns connections to the BASP brokers of a middleman with multiple
+/// multiplexers. Each BASP broker runs in its own multiplexer and manages all
+/// connections assigned to its shard. All member functions are thread-safe.
+class shard_table {
+public:
+  explicit shard_table(size_t num_shards);
+
+  /// Returns the number of shards.
+  size_t size() const {
+    return brokers_.size();
+  }
+
+  /// Returns the shard for the new connection `hdl`.
+  size_t select(connection_handle hdl) const;
+
+  /// Sets the BASP broker for `shard`.
+  void set(size_t shard, actor broker);
+
+  /// Returns the BASP broker for `shard` or an invalid handle if
+  /// `shard` has no broker yet.
+  actor get(size_t shard) const;
+
+  /// Stores that `broker` manages `hdl`.
+  void assign(connection_handle hdl, actor broker);
+
+  /// Removes the entry for `hdl`.
+  void erase(connection_handle hdl);
+
+  /// Returns the BASP broker managing `hdl` or an invalid handle if
+  /// `hdl` is unknown.
+  actor owner(connection_handle hdl) const;
+
+private:
+  mutable std::mutex mtx_;
+  std::vector<actor> brokers_;
+  std::unordered_map<connection_handle, actor> owners_;
+};
+
+/// @}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <set>
+#include <memory>
 #include <stack>
 #include <string>
 #include <future>
@@ -89,6 +90,9 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // inherited from basp::instance::callee
   buffer_type& get_buffer(connection_handle hdl) override;
 
+  // inherited from basp::instance::callee
+  void write(connection_handle hdl, network::chunk_ptr chunk) override;
+
   // inherited from basp::instance::callee
   void flush(connection_handle hdl) override;
 
@@ -101,6 +105,22 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   /// Cleans up any state for `hdl`.
   void cleanup(connection_handle hdl);
 
+  /// Makes this state share its routing table, proxies, and shards with the
+  /// state of the primary BASP broker.
+  void join(basp_broker_state& primary);
+
+  /// Returns whether this broker manages the connection `hdl`. Always `true`
+  /// when running a single BASP broker.
+  bool owns(connection_handle hdl);
+
+  /// Returns the shard for the new connection `hdl` or 0 if this broker
+  /// keeps `hdl`.
+  size_t select_shard(connection_handle hdl);
+
+  /// Creates a scribe for the connection `hdl` in the backend of `shard`.
+  /// Returns `nullptr` if the connection cannot move to the other backend.
+  scribe_ptr migrate(connection_handle hdl, size_t shard);
+
   // pointer to ourselves
   broker* self;
 
@@ -115,6 +135,17 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // points to the current context for callbacks such as `make_proxy`
   basp::endpoint_context* this_context = nullptr;
 
+  // assigns connections to BASP brokers when running multiple multiplexers,
+  // `nullptr` otherwise
+  std::shared_ptr<basp::shard_table> shards;
+
+  // stores whether this broker is the primary BASP broker that accepts new
+  // connections and distributes them to its shards
+  bool is_primary = true;
+
+  // buffers outgoing data for connections of other BASP brokers
+  std::unordered_map<connection_handle, buffer_type> outboxes;
+
   // stores handles to spawn servers for other nodes; these servers
   // are spawned whenever the broker learns a new node ID and try to
   // get a 'SpawnServ' instance on the remote side
@@ -155,6 +186,10 @@ public:
 
   explicit basp_broker(actor_config& cfg);
 
+  /// Creates a shard of `primary`, i.e., a BASP broker that shares routing
+  /// table and proxies with `primary`.
+  basp_broker(actor_config& cfg, basp_broker* primary);
+
   behavior make_behavior() override;
   proxy_registry* proxy_registry_ptr() override;
   resume_result resume(execution_unit*, size_t) override;
@@ -149,6 +149,15 @@ public:
   /// Returns the IO backend used by this middleman.
   virtual network::multiplexer& backend() = 0;
 
+  /// Returns the number of IO backends, i.e., the number of threads
+  /// performing network I/O.
+  size_t num_backends() const;
+
+  /// Returns the IO backend at position `index`, whereas index 0 always
+  /// refers to the primary backend returned by `backend()`.
+  /// @pre `index < num_backends()`
+  network::multiplexer& backend(size_t index);
+
   /// Invokes the callback(s) associated with given event.
   template <hook::event_type Event, typename... Ts>
   void notify(Ts&&... ts) {
@@ -278,6 +287,11 @@ public:
         return backend_;
       }
 
+    protected:
+      backend_pointer make_backend() override {
+        return backend_pointer{new Backend(&system())};
+      }
+
     private:
       Backend backend_;
     };
@@ -287,6 +301,10 @@ public:
 protected:
   middleman(actor_system& sys);
 
+  /// Creates an additional backend for running BASP brokers in parallel
+  /// or returns `nullptr` if the backend does not support multiple instances.
+  virtual backend_pointer make_backend();
+
 private:
   template <spawn_options Os, class Impl, class F, class... Ts>
   expected<typename infer_handle_from_class<Impl>::type>
@@ -346,6 +364,14 @@ private:
   network::multiplexer::supervisor_ptr backend_supervisor_;
   // runs the backend
   std::thread thread_;
+  // additional backends for running BASP brokers in parallel
+  std::vector<backend_pointer> backends_;
+  // prevents additional backends from shutting down
+  std::vector<network::multiplexer::supervisor_ptr> backend_supervisors_;
+  // runs the additional backends
+  std::vector<std::thread> threads_;
+  // BASP brokers running in the additional backends
+  std::vector<actor> basp_shards_;
   // keeps track of "singleton-like" brokers
   std::map<atom_value, actor> named_brokers_;
   // user-defined hooks
@@ -76,6 +76,12 @@ protected:
     }
   }
 
+  /// Returns the manager for accepted connections or `nullptr` if this
+  /// acceptor has been closed.
+  inline const manager_ptr& manager() const {
+    return mgr_;
+  }
+
 private:
   manager_ptr mgr_;
   native_socket sock_;
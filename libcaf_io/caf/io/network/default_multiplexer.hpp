@@ -157,9 +157,9 @@ public:
 
   void run() override;
 
-  void add(operation op, native_socket fd, event_handler* ptr);
+  virtual void add(operation op, native_socket fd, event_handler* ptr);
 
-  void del(operation op, native_socket fd, event_handler* ptr);
+  virtual void del(operation op, native_socket fd, event_handler* ptr);
 
   /// Calls `ptr->resume`.
   void resume(intrusive_ptr<resumable> ptr);
@@ -173,10 +173,17 @@ public:
   /// Run all pending events generated from calls to `add` or `del`.
   void handle_internal_events();
 
-private:
+protected:
   /// Calls `epoll`, `kqueue`, or `poll` with or without blocking.
-  bool poll_once_impl(bool block);
+  virtual bool poll_once_impl(bool block);
+
+  /// Returns the socket handle to the OS-level event loop such as `epoll`.
+  /// Unused in the `poll` implementation.
+  inline native_socket epoll_fd() const {
+    return epollfd_;
+  }
 
+private:
   // platform-dependent additional initialization code
   void init();
 
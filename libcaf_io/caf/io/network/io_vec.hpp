@@ -0,0 +1,46 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// A reference-counted, immutable block of output data. Streams keep a
+/// reference to the block until they have written all of its bytes, which
+/// allows multiple streams to send the same data without copying it.
+using chunk_ptr = std::shared_ptr<const std::vector<char>>;
+
+/// Describes a contiguous block of data for scatter/gather writes.
+struct io_vec {
+  const void* data;
+  size_t size;
+};
+
+/// Maximum number of blocks per scatter/gather write.
+constexpr size_t max_io_vecs = 64;
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -83,6 +83,10 @@ std::string last_socket_error_as_string();
 /// and the latter is the write handle.
 std::pair<native_socket, native_socket> create_pipe();
 
+/// Creates a new nonblocking socket that refers to the same connection as
+/// `fd`. The new socket is not inherited by child processes.
+expected<native_socket> duplicate_socket(native_socket fd);
+
 /// Sets fd to be inherited by child processes if `new_value == true`
 /// or not if `new_value == false`.  Not implemented on Windows.
 /// throws `network_error` on error
@@ -43,6 +43,8 @@ public:
 
   std::vector<char>& rd_buf() override;
 
+  void write(chunk_ptr chunk) override;
+
   void graceful_shutdown() override;
 
   void flush() override;
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "caf/logger.hpp"
@@ -26,6 +29,7 @@
 #include "caf/io/fwd.hpp"
 #include "caf/io/receive_policy.hpp"
 
+#include "caf/io/network/io_vec.hpp"
 #include "caf/io/network/rw_state.hpp"
 #include "caf/io/network/event_handler.hpp"
 #include "caf/io/network/stream_manager.hpp"
@@ -63,6 +67,11 @@ public:
   /// @warning Not thread safe.
   void write(const void* buf, size_t num_bytes);
 
+  /// Enqueues `chunk` for writing without copying its content. Data in the
+  /// write buffer precedes `chunk` in the output.
+  /// @warning Not thread safe.
+  void write(chunk_ptr chunk);
+
   /// Returns the write buffer of this stream.
   /// @warning Must not be modified outside the IO multiplexers event loop
   ///          once the stream has been started.
@@ -116,9 +125,10 @@ protected:
         break;
       }
       case io::network::operation::write: {
+        io_vec bufs[max_io_vecs];
+        auto num_bufs = prepare_io_vecs(bufs);
         size_t wb; // Written bytes.
-        auto res = policy.write_some(wb, fd(), wr_buf_.data() + written_,
-                                     wr_buf_.size() - written_);
+        auto res = policy.write_some(wb, fd(), bufs, num_bufs);
         handle_write_result(res, wb);
         break;
       }
@@ -128,17 +138,59 @@ protected:
     }
   }
 
-private:
-  void prepare_next_read();
-
-  void prepare_next_write();
+  /// Fills `bufs` with the unsent data in the write queue and returns the
+  /// number of used elements.
+  size_t prepare_io_vecs(io_vec* bufs);
 
+  /// Processes the result of reading `rb` bytes to `rd_buf_pos()`.
+  /// @returns `false` if the stream stopped reading, `true` otherwise.
   bool handle_read_result(rw_state read_result, size_t rb);
 
+  /// Processes the result of writing `wb` bytes from the buffers returned by
+  /// `prepare_io_vecs`.
   void handle_write_result(rw_state write_result, size_t wb);
 
   void handle_error_propagation();
 
+  /// Returns the manager for read operations or `nullptr` after the stream
+  /// stopped reading.
+  inline const manager_ptr& reader() const {
+    return reader_;
+  }
+
+  /// Returns the manager for write operations or `nullptr` while the stream
+  /// has nothing to write.
+  inline const manager_ptr& writer() const {
+    return writer_;
+  }
+
+  /// Returns the position in the read buffer for the next received byte.
+  inline char* rd_buf_pos() {
+    return rd_buf_.data() + collected_;
+  }
+
+  /// Returns how many bytes fit into the read buffer before the stream calls
+  /// `consume` on its manager.
+  inline size_t rd_buf_space() const {
+    return rd_buf_.size() - collected_;
+  }
+
+  /// Returns whether the write queue contains unsent data.
+  inline bool has_queued_data() const {
+    return !wr_queue_.empty();
+  }
+
+private:
+  void prepare_next_read();
+
+  void prepare_next_write();
+
+  /// Moves the content of the write buffer to the end of the write queue.
+  void enqueue_wr_offline_buf();
+
+  /// Removes the first chunk from the write queue.
+  void pop_wr_queue();
+
   /// Initiates a graceful shutdown of the connection by sending FIN on the TCP
   /// connection.
   void send_fin();
@@ -152,10 +204,13 @@ private:
   size_t max_;
   buffer_type rd_buf_;
 
-  // State for writing.
+  // State for writing. The flag in each entry of the write queue marks chunks
+  // created by the stream, which we can recycle after writing them.
   manager_ptr writer_;
   size_t written_;
-  buffer_type wr_buf_;
+  size_t wr_queue_size_;
+  std::deque<std::pair<chunk_ptr, bool>> wr_queue_;
+  std::shared_ptr<buffer_type> wr_spare_buf_;
   buffer_type wr_offline_buf_;
 };
 
@@ -0,0 +1,54 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "caf/io/network/acceptor.hpp"
+#include "caf/io/network/uring_multiplexer.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// An acceptor that receives new connections from a multishot accept request
+/// to the io_uring of its multiplexer.
+class uring_acceptor : public acceptor, public uring_handler {
+public:
+  uring_acceptor(uring_multiplexer& mpx, native_socket sockfd);
+
+  void handle_event(operation op) override;
+
+  void arm(operation op) override;
+
+  void disarm(operation op) override;
+
+  void resume() override;
+
+  void complete(uint8_t tag, int32_t res, uint32_t flags) override;
+
+private:
+  bool want_accept_;
+  bool accept_pending_;
+  manager_ptr accept_guard_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -0,0 +1,277 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "caf/io/network/default_multiplexer.hpp"
+
+// Forward declaration of C types.
+extern "C" {
+
+struct msghdr;
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+} // extern "C"
+
+namespace caf {
+namespace io {
+namespace network {
+
+class uring_multiplexer;
+
+/// Base class for event handlers that perform their I/O via requests to the
+/// io_uring instance of a `uring_multiplexer` instead of waiting for readiness
+/// events.
+class uring_handler {
+public:
+  friend class uring_multiplexer;
+
+  explicit uring_handler(uring_multiplexer& mpx);
+
+  virtual ~uring_handler();
+
+  /// Called whenever the parent adds this handler for `op` to the event loop.
+  virtual void arm(operation op) = 0;
+
+  /// Called whenever the parent removes this handler for `op` from the event
+  /// loop. The multiplexer calls `removed_from_loop` later.
+  virtual void disarm(operation op) = 0;
+
+  /// Submits requests for all armed operations and processes completed I/O.
+  /// The multiplexer calls this member function from its event loop after the
+  /// handler called `uring_multiplexer::schedule`.
+  virtual void resume() = 0;
+
+  /// Processes the completion of a request with `tag`.
+  virtual void complete(uint8_t tag, int32_t res, uint32_t flags) = 0;
+
+protected:
+  /// Points to the parent or is `nullptr` after the parent went out of scope.
+  uring_multiplexer* mpx_;
+
+private:
+  bool registered_;
+};
+
+/// A multiplexer that performs stream I/O via io_uring. Each handler keeps a
+/// multishot receive request in the ring that fills buffers from a shared
+/// pool, and sends data with batched `sendmsg` requests. Acceptors use
+/// multishot accept requests. All other event handlers (the pipe and datagram
+/// servants) remain readiness-based: the ring polls the epoll instance of the
+/// base class and dispatches epoll events whenever it becomes readable.
+class uring_multiplexer : public default_multiplexer {
+public:
+  friend class uring_handler;
+
+  /// Tags requests in the ring to dispatch their completions.
+  enum request_tag : uint8_t {
+    poll_tag,
+    recv_tag,
+    send_tag,
+    accept_tag,
+    cancel_tag,
+  };
+
+  /// Number of entries in the submission queue.
+  static constexpr unsigned sq_entries = 256;
+
+  /// Number of entries in the completion queue.
+  static constexpr unsigned cq_entries = 4096;
+
+  /// Number of buffers in the pool for multishot receive requests.
+  static constexpr uint16_t num_buffers = 128;
+
+  /// Size of a single buffer in the pool for multishot receive requests.
+  static constexpr size_t buffer_size = 16 * 1024;
+
+  explicit uring_multiplexer(actor_system* sys);
+
+  ~uring_multiplexer() override;
+
+  /// Checks whether the kernel supports all io_uring features this
+  /// multiplexer depends on and allows this process to set up a ring with
+  /// its buffer pool.
+  static bool available();
+
+  /// Returns whether this multiplexer performs stream I/O via io_uring. A
+  /// multiplexer that failed to set up its ring behaves exactly like a
+  /// `default_multiplexer`.
+  bool uses_ring() const noexcept {
+    return ring_fd_ >= 0;
+  }
+
+  scribe_ptr new_scribe(native_socket fd) override;
+
+  doorman_ptr new_doorman(native_socket fd) override;
+
+  void run() override;
+
+  void add(operation op, native_socket fd, event_handler* ptr) override;
+
+  void del(operation op, native_socket fd, event_handler* ptr) override;
+
+  /// Returns whether the multiplexer cancels all requests for shutting down.
+  bool closing() const noexcept {
+    return closing_;
+  }
+
+  /// Returns the number of submitted requests that did not complete yet.
+  size_t num_requests() const noexcept {
+    return requests_;
+  }
+
+  /// Calls `ptr->resume()` from the event loop.
+  void schedule(uring_handler* ptr);
+
+  /// Starts a multishot receive request for `fd` that picks its buffers from
+  /// the pool.
+  void submit_recv(uring_handler* ptr, native_socket fd);
+
+  /// Starts a `sendmsg` request for `fd`. The message header and the buffers
+  /// it refers to must remain valid until the request completes.
+  void submit_sendmsg(uring_handler* ptr, native_socket fd, msghdr* msg);
+
+  /// Starts a multishot accept request for `fd`.
+  void submit_accept(uring_handler* ptr, native_socket fd);
+
+  /// Cancels the pending request of `ptr` with `tag`.
+  void cancel(uring_handler* ptr, request_tag tag);
+
+  /// Returns the pool buffer with `id`.
+  const char* buffer(uint16_t id) const {
+    return buffers_.data() + id * buffer_size;
+  }
+
+  /// Returns a buffer to the pool after the handler has consumed its content.
+  void recycle(uint16_t id);
+
+  /// Calls `ptr->resume()` after the next buffer returns to the pool or
+  /// immediately if the kernel ran dry before the handler recycled buffers.
+  void wait_for_buffers(uring_handler* ptr);
+
+  /// Checks whether `ptr` waits for buffers.
+  bool waiting_for_buffers(const uring_handler* ptr) const;
+
+protected:
+  bool poll_once_impl(bool block) override;
+
+private:
+  /// Sets up the ring and registers the buffer pool. Returns `false` and
+  /// leaves `errno` set on error.
+  bool init_ring();
+
+  /// Releases all resources acquired by `init_ring`, even if it failed
+  /// half-way through.
+  void release_ring();
+
+  /// Returns an initialized submission queue entry for a request of `ptr`.
+  io_uring_sqe* next_sqe(uring_handler* ptr, request_tag tag);
+
+  /// Hands all pending submission queue entries to the kernel and waits for
+  /// at least `wait_nr` completions.
+  void submit(unsigned wait_nr);
+
+  /// Dispatches all completions in the completion queue.
+  bool handle_completions();
+
+  /// Resumes scheduled handlers and delivers `removed_from_loop` callbacks.
+  bool handle_pending();
+
+  /// Puts `id` into the buffer ring without publishing it to the kernel.
+  void add_buffer(uint16_t id);
+
+  /// Removes all references to `ptr` before it goes out of scope.
+  void forget(uring_handler* ptr);
+
+  struct removal {
+    uring_handler* handler;
+    event_handler* ptr;
+    operation op;
+  };
+
+  /// File descriptor of the ring.
+  int ring_fd_;
+
+  // Memory mappings of the ring.
+  void* sq_ptr_;
+  size_t sq_size_;
+  void* cq_ptr_;
+  size_t cq_size_;
+  io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  // Pointers into the submission queue.
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_flags_;
+  unsigned* sq_array_;
+  unsigned sq_mask_;
+  unsigned sq_local_tail_;
+  unsigned to_submit_;
+
+  // Pointers into the completion queue.
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  io_uring_cqe* cqes_;
+  unsigned cq_mask_;
+
+  /// Ring for handing buffers of the pool to the kernel.
+  io_uring_buf_ring* buf_ring_;
+  uint16_t buf_tail_;
+
+  /// Number of buffers the kernel can select for multishot receives.
+  size_t free_buffers_;
+
+  /// Storage for all buffers of the pool.
+  std::vector<char> buffers_;
+
+  /// Stores whether the ring currently polls the epoll instance.
+  bool epoll_armed_;
+
+  /// Stores whether we cancel all requests for shutting down.
+  bool closing_;
+
+  /// Number of in-flight requests, not counting polling the epoll instance.
+  size_t requests_;
+
+  /// All handlers that used this multiplexer at least once.
+  std::unordered_set<uring_handler*> handlers_;
+
+  /// Handlers waiting for a call to `resume`.
+  std::vector<uring_handler*> ready_;
+
+  /// Handlers waiting for buffers to return to the pool.
+  std::vector<uring_handler*> starved_;
+
+  /// Pending calls to `removed_from_loop`.
+  std::vector<removal> removed_;
+
+  /// Swap space for `ready_` and `removed_` while dispatching them.
+  std::vector<uring_handler*> resuming_;
+  std::vector<removal> removing_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
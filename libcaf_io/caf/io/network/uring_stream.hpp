@@ -0,0 +1,90 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "caf/io/network/stream.hpp"
+#include "caf/io/network/uring_multiplexer.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// A stream that receives data from a multishot receive request and writes
+/// via `sendmsg` requests to the io_uring of its multiplexer.
+class uring_stream : public stream, public uring_handler {
+public:
+  uring_stream(uring_multiplexer& mpx, native_socket sockfd);
+
+  ~uring_stream() override;
+
+  void handle_event(operation op) override;
+
+  void arm(operation op) override;
+
+  void disarm(operation op) override;
+
+  void resume() override;
+
+  void complete(uint8_t tag, int32_t res, uint32_t flags) override;
+
+private:
+  /// Refers to received data in a buffer of the pool.
+  struct received_data {
+    uint16_t id;
+    size_t offset;
+    size_t size;
+  };
+
+  /// Moves received data to the read buffer, calling `consume` on the manager
+  /// whenever the read buffer satisfies the receive policy.
+  void deliver();
+
+  void start_recv();
+
+  void start_send();
+
+  void recv_done(int32_t res, uint32_t flags);
+
+  void send_done(int32_t res);
+
+  // State for reading.
+  bool want_read_;
+  bool recv_pending_;
+  bool eof_;
+  std::deque<received_data> inbox_;
+  manager_ptr recv_guard_;
+
+  // State for writing. The message header and the I/O vectors must remain
+  // valid until the kernel completes the request.
+  bool want_write_;
+  bool send_pending_;
+  msghdr msg_;
+  iovec iov_[max_io_vecs];
+  manager_ptr send_guard_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
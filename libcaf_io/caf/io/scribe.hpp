@@ -25,6 +25,7 @@
 #include "caf/io/broker_servant.hpp"
 #include "caf/io/receive_policy.hpp"
 #include "caf/io/system_messages.hpp"
+#include "caf/io/network/io_vec.hpp"
 #include "caf/io/network/stream_manager.hpp"
 
 namespace caf {
@@ -53,6 +54,10 @@ public:
   /// Returns the current input buffer.
   virtual std::vector<char>& rd_buf() = 0;
 
+  /// Enqueues `chunk` after the content of the output buffer. The default
+  /// implementation copies `chunk` into the output buffer.
+  virtual void write(network::chunk_ptr chunk);
+
   /// Flushes the output buffer, i.e., sends the
   /// content of the buffer via the network.
   virtual void flush() = 0;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "caf/io/network/io_vec.hpp"
 #include "caf/io/network/native_socket.hpp"
 #include "caf/io/network/rw_state.hpp"
 
@@ -42,6 +43,16 @@ struct tcp {
                                           io::network::native_socket fd,
                                           const void* buf, size_t len);
 
+  /// Writes up to `num_bufs` blocks from `bufs` to `fd` with a single system
+  /// call. Returns `true` as long as `fd` is readable and `false` if the
+  /// socket has been closed or an IO error occured. The number of written
+  /// bytes is stored in `result` (can be 0).
+  /// @pre `num_bufs <= io::network::max_io_vecs`
+  static io::network::rw_state write_some(size_t& result,
+                                          io::network::native_socket fd,
+                                          const io::network::io_vec* bufs,
+                                          size_t num_bufs);
+
   /// Tries to accept a new connection from `fd`. On success,
   /// the new connection is stored in `result`. Returns true
   /// as long as
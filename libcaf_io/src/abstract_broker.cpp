@@ -105,6 +105,16 @@ void abstract_broker::write(connection_handle hdl, size_t bs, const void* buf) {
   out.insert(out.end(), first, last);
 }
 
+void abstract_broker::write(connection_handle hdl, network::chunk_ptr chunk) {
+  auto x = by_id(hdl);
+  if (!x) {
+    CAF_LOG_ERROR("tried to write to an unknown connection_handle:"
+                  << CAF_ARG(hdl));
+    return;
+  }
+  x->write(std::move(chunk));
+}
+
 void abstract_broker::flush(connection_handle hdl) {
   auto x = by_id(hdl);
   if (x)
@@ -376,12 +386,14 @@ void abstract_broker::init_broker() {
     kvp.second->launch();
 }
 
-abstract_broker::abstract_broker(actor_config& cfg) : scheduled_actor(cfg) {
-  // nop
+abstract_broker::abstract_broker(actor_config& cfg)
+    : scheduled_actor(cfg),
+      backend_(static_cast<network::multiplexer*>(cfg.host)) {
+  CAF_ASSERT(backend_ != nullptr);
 }
 
 network::multiplexer& abstract_broker::backend() {
-  return system().middleman().backend();
+  return *backend_;
 }
 
 void abstract_broker::launch_servant(doorman_ptr& ptr) {
@@ -32,6 +32,7 @@
 #include "caf/io/connection_helper.hpp"
 #include "caf/io/middleman.hpp"
 #include "caf/io/network/interfaces.hpp"
+#include "caf/io/network/native_socket.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/sec.hpp"
 #include "caf/send.hpp"
@@ -51,6 +52,9 @@ basp_broker_state::basp_broker_state(broker* selfptr)
     self(selfptr),
     instance(selfptr, *this) {
   CAF_ASSERT(this_node() != none);
+  auto n = selfptr->parent().num_backends();
+  if (n > 1)
+    shards = std::make_shared<basp::shard_table>(n);
 }
 
 basp_broker_state::~basp_broker_state() {
@@ -82,14 +86,21 @@ strong_actor_ptr basp_broker_state::make_proxy(node_id nid, actor_id aid) {
     return nullptr;
   }
   // create proxy and add functor that will be called if we
-  // receive a basp::down_message
+  // receive a basp::down_message; the proxy forwards its messages directly
+  // to the BASP broker managing the connection to `nid`
   auto mm = &system().middleman();
+  actor mgr;
+  if (!owns(path->hdl))
+    mgr = shards->owner(path->hdl);
+  if (!mgr)
+    mgr = actor{self};
   actor_config cfg;
   auto res = make_actor<forwarding_actor_proxy, strong_actor_ptr>(
-    aid, nid, &(self->home_system()), cfg, self);
+    aid, nid, &(self->home_system()), cfg, std::move(mgr));
   strong_actor_ptr selfptr{self->ctrl()};
+  auto mpx = &self->backend();
   res->get()->attach_functor([=](const error& rsn) {
-    mm->backend().post([=] {
+    mpx->post([=] {
       // using res->id() instead of aid keeps this actor instance alive
       // until the original instance terminates, thus preventing subtle
       // bugs with attachables
@@ -354,10 +365,12 @@ void basp_broker_state::learned_new_node_indirectly(const node_id& nid) {
   // This member function gets only called once, after adding a new indirect
   // connection to the routing table; hence, spawning our helper here exactly
   // once and there is no need to track in-flight connection requests.
+  // The helper creates scribes in the backend of the primary BASP broker.
+  auto primary = is_primary ? actor{self} : shards->get(0);
   using namespace detail;
   auto tmp = get_or(config(), "middleman.attach-utility-actors", false)
-               ? system().spawn<hidden>(connection_helper, self)
-               : system().spawn<detached + hidden>(connection_helper, self);
+               ? system().spawn<hidden>(connection_helper, primary)
+               : system().spawn<detached + hidden>(connection_helper, primary);
   auto sender = actor_cast<strong_actor_ptr>(tmp);
   system().registry().put(sender->id(), sender);
   std::vector<strong_actor_ptr> fwd_stack;
@@ -394,6 +407,9 @@ void basp_broker_state::cleanup(connection_handle hdl) {
     return none;
   });
   instance.tbl().erase_direct(hdl, cb);
+  instance.erase_type_ids(hdl);
+  if (shards != nullptr)
+    shards->erase(hdl);
   // Remove the context for `hdl`, making sure clients receive an error in case
   // this connection was closed during handshake.
   auto i = ctx.find(hdl);
@@ -408,13 +424,80 @@ void basp_broker_state::cleanup(connection_handle hdl) {
   }
 }
 
+void basp_broker_state::join(basp_broker_state& primary) {
+  CAF_LOG_TRACE("");
+  CAF_ASSERT(primary.shards != nullptr);
+  instance.share_routing_table(primary.instance);
+  namespace_.share(primary.namespace_);
+  shards = primary.shards;
+  is_primary = false;
+}
+
+bool basp_broker_state::owns(connection_handle hdl) {
+  return shards == nullptr || self->valid(hdl);
+}
+
+size_t basp_broker_state::select_shard(connection_handle hdl) {
+  if (shards == nullptr || !is_primary)
+    return 0;
+  auto result = shards->select(hdl);
+  if (result == 0 || !shards->get(result))
+    return 0;
+  return result;
+}
+
+scribe_ptr basp_broker_state::migrate(connection_handle hdl, size_t shard) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(shard));
+  // The default multiplexer uses the socket as connection handle. We hand the
+  // connection to the other backend by duplicating the socket, because the
+  // scribe in our backend closes its socket when going out of scope.
+  auto fd = static_cast<network::native_socket>(hdl.id());
+  auto new_fd = network::duplicate_socket(fd);
+  if (!new_fd) {
+    CAF_LOG_WARNING("unable to move connection to another shard:"
+                    << CAF_ARG(hdl) << CAF_ARG(shard)
+                    << system().render(new_fd.error()));
+    return nullptr;
+  }
+  return self->parent().backend(shard).new_scribe(*new_fd);
+}
+
 basp_broker_state::buffer_type&
 basp_broker_state::get_buffer(connection_handle hdl) {
-  return self->wr_buf(hdl);
+  if (owns(hdl))
+    return self->wr_buf(hdl);
+  return outboxes[hdl];
+}
+
+void basp_broker_state::write(connection_handle hdl,
+                              network::chunk_ptr chunk) {
+  if (owns(hdl)) {
+    self->write(hdl, std::move(chunk));
+    return;
+  }
+  auto& buf = outboxes[hdl];
+  buf.insert(buf.end(), chunk->begin(), chunk->end());
 }
 
 void basp_broker_state::flush(connection_handle hdl) {
-  self->flush(hdl);
+  if (owns(hdl)) {
+    self->flush(hdl);
+    return;
+  }
+  // Ship buffered data to the BASP broker managing `hdl`.
+  auto i = outboxes.find(hdl);
+  if (i == outboxes.end())
+    return;
+  auto buf = std::move(i->second);
+  outboxes.erase(i);
+  if (buf.empty())
+    return;
+  auto dest = shards->owner(hdl);
+  if (!dest) {
+    CAF_LOG_DEBUG("drop data for closed connection:" << CAF_ARG(hdl));
+    return;
+  }
+  self->send(dest, forward_atom::value, hdl, std::move(buf));
 }
 
 void basp_broker_state::handle_heartbeat() {
@@ -432,20 +515,28 @@ basp_broker::basp_broker(actor_config& cfg)
   });
 }
 
+basp_broker::basp_broker(actor_config& cfg, basp_broker* primary)
+    : basp_broker(cfg) {
+  state.join(primary->state);
+}
+
 behavior basp_broker::make_behavior() {
   CAF_LOG_TRACE(CAF_ARG(system().node()));
   if (get_or(config(), "middleman.enable-automatic-connections", false)) {
     CAF_LOG_DEBUG("enable automatic connections");
     // open a random port and store a record for our peers how to
-    // connect to this broker directly in the configuration server
-    auto res = add_tcp_doorman(uint16_t{0});
-    if (res) {
-      auto port = res->second;
-      auto addrs = network::interfaces::list_addresses(false);
-      auto config_server = system().registry().get(atom("ConfigServ"));
-      send(actor_cast<actor>(config_server), put_atom::value,
-           "basp.default-connectivity-tcp",
-           make_message(port, std::move(addrs)));
+    // connect to this broker directly in the configuration server; only the
+    // primary BASP broker accepts new connections
+    if (state.is_primary) {
+      auto res = add_tcp_doorman(uint16_t{0});
+      if (res) {
+        auto port = res->second;
+        auto addrs = network::interfaces::list_addresses(false);
+        auto config_server = system().registry().get(atom("ConfigServ"));
+        send(actor_cast<actor>(config_server), put_atom::value,
+             "basp.default-connectivity-tcp",
+             make_message(port, std::move(addrs)));
+      }
     }
     state.automatic_connections = true;
   }
@@ -522,6 +613,22 @@ behavior basp_broker::make_behavior() {
     [=](const new_connection_msg& msg) {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
       auto& bi = state.instance;
+      auto shard = state.select_shard(msg.handle);
+      if (shard != 0) {
+        auto ptr = state.migrate(msg.handle, shard);
+        if (ptr != nullptr) {
+          // Only we know the published actors, hence we write the handshake
+          // before handing the connection over to the shard.
+          std::vector<char> buf;
+          bi.write_server_handshake(context(), buf, local_port(msg.source));
+          take(msg.handle);
+          send(state.shards->get(shard), connect_atom::value, std::move(ptr),
+               std::move(buf));
+          return;
+        }
+      }
+      if (state.shards != nullptr)
+        state.shards->assign(msg.handle, this);
       bi.write_server_handshake(context(), state.get_buffer(msg.handle),
                                 local_port(msg.source));
       state.flush(msg.handle);
@@ -553,9 +660,21 @@ behavior basp_broker::make_behavior() {
     [=](connect_atom, scribe_ptr& ptr, uint16_t port) {
       CAF_LOG_TRACE(CAF_ARG(ptr) << CAF_ARG(port));
       CAF_ASSERT(ptr != nullptr);
-      auto rp = make_response_promise();
       auto hdl = ptr->hdl();
+      auto shard = state.select_shard(hdl);
+      if (shard != 0) {
+        auto new_ptr = state.migrate(hdl, shard);
+        if (new_ptr != nullptr) {
+          ptr.reset();
+          delegate(state.shards->get(shard), connect_atom::value,
+                   std::move(new_ptr), port);
+          return;
+        }
+      }
+      auto rp = make_response_promise();
       add_scribe(std::move(ptr));
+      if (state.shards != nullptr)
+        state.shards->assign(hdl, this);
       auto& ctx = state.ctx[hdl];
       ctx.hdl = hdl;
       ctx.remote_port = port;
@@ -564,6 +683,28 @@ behavior basp_broker::make_behavior() {
       // await server handshake
       configure_read(hdl, receive_policy::exactly(basp::header_size));
     },
+    // received from the primary BASP broker
+    [=](connect_atom, scribe_ptr& ptr, std::vector<char>& handshake) {
+      CAF_LOG_TRACE(CAF_ARG(ptr));
+      CAF_ASSERT(ptr != nullptr);
+      auto hdl = ptr->hdl();
+      add_scribe(std::move(ptr));
+      state.shards->assign(hdl, this);
+      auto& buf = wr_buf(hdl);
+      buf.insert(buf.end(), handshake.begin(), handshake.end());
+      flush(hdl);
+      configure_read(hdl, receive_policy::exactly(basp::header_size));
+    },
+    // received from other BASP brokers
+    [=](forward_atom, connection_handle hdl, std::vector<char>& buf) {
+      CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG2("num_bytes", buf.size()));
+      if (!valid(hdl)) {
+        CAF_LOG_DEBUG("drop data for closed connection:" << CAF_ARG(hdl));
+        return;
+      }
+      write(hdl, std::make_shared<const std::vector<char>>(std::move(buf)));
+      flush(hdl);
+    },
     [=](delete_atom, const node_id& nid, actor_id aid) {
       CAF_LOG_TRACE(CAF_ARG(nid) << ", " << CAF_ARG(aid));
       state.proxies().erase(nid, aid);
@@ -592,15 +733,23 @@ behavior basp_broker::make_behavior() {
       return sec::cannot_close_invalid_port;
     },
     [=](get_atom, const node_id& x)
-    -> std::tuple<node_id, std::string, uint16_t> {
+    -> result<node_id, std::string, uint16_t> {
       std::string addr;
       uint16_t port = 0;
       auto hdl = state.instance.tbl().lookup_direct(x);
+      if (hdl && !state.owns(*hdl)) {
+        auto dest = state.shards->owner(*hdl);
+        if (dest) {
+          delegate(dest, get_atom::value, x);
+          return delegated<node_id, std::string, uint16_t>{};
+        }
+        hdl = none;
+      }
       if (hdl) {
         addr = remote_addr(*hdl);
         port = remote_port(*hdl);
       }
-      return std::make_tuple(x, std::move(addr), port);
+      return {x, std::move(addr), port};
     },
     [=](tick_atom, size_t interval) {
       state.instance.handle_heartbeat(context());
@@ -29,6 +29,14 @@ namespace caf {
 namespace io {
 namespace basp {
 
+namespace {
+
+// Forwarded payloads of at least this size go to the transport as-is instead
+// of being copied into the output buffer.
+constexpr size_t zero_copy_threshold = 4096;
+
+} // namespace <anonymous>
+
 instance::callee::callee(actor_system& sys, proxy_registry::backend& backend)
     : namespace_(sys, backend) {
   // nop
@@ -39,9 +47,13 @@ instance::callee::~callee() {
 }
 
 instance::instance(abstract_broker* parent, callee& lstnr)
-    : tbl_(parent),
+    : tbl_(std::make_shared<routing_table>(parent)),
+      parent_(parent),
       this_node_(parent->system().node()),
-      callee_(lstnr) {
+      callee_(lstnr),
+      compact_type_ids_(get_or(parent->system().config(),
+                               "middleman.compact-type-ids",
+                               defaults::middleman::compact_type_ids)) {
   CAF_ASSERT(this_node_ != none);
 }
 
@@ -55,7 +67,7 @@ connection_state instance::handle(execution_unit* ctx,
       callee_.purge_state(nid);
       return none;
     });
-    tbl_.erase_direct(dm.handle, cb);
+    tbl_->erase_direct(dm.handle, cb);
     return close_connection;
   };
   std::vector<char>* payload = nullptr;
@@ -86,15 +98,24 @@ connection_state instance::handle(execution_unit* ctx,
 
 void instance::handle_heartbeat(execution_unit* ctx) {
   CAF_LOG_TRACE("");
-  for (auto& kvp: tbl_.direct_by_hdl_) {
-    CAF_LOG_TRACE(CAF_ARG(kvp.first) << CAF_ARG(kvp.second));
-    write_heartbeat(ctx, callee_.get_buffer(kvp.first));
-    callee_.flush(kvp.first);
+  // Other brokers sharing our routing table send heartbeats over their own
+  // connections, hence we only consider connections of our parent.
+  for (auto& hdl : parent_->connections()) {
+    auto nid = tbl_->lookup_direct(hdl);
+    if (nid == none)
+      continue;
+    CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(nid));
+    write_heartbeat(ctx, callee_.get_buffer(hdl));
+    callee_.flush(hdl);
   }
 }
 
+void instance::share_routing_table(instance& other) {
+  tbl_ = other.tbl_;
+}
+
 optional<routing_table::route> instance::lookup(const node_id& target) {
-  return tbl_.lookup(target);
+  return tbl_->lookup(target);
 }
 
 void instance::flush(const routing_table::route& path) {
@@ -176,10 +197,18 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
   }
   auto& source_node = sender ? sender->node() : this_node_;
   if (dest_node == path->next_hop && source_node == this_node_) {
+    // Only direct messages use type IDs, because the receiver of a routed
+    // message does not know the type-ID table of the sender.
+    auto compact = type_ids(path->hdl) != nullptr;
+    if (compact)
+      flags |= header::type_ids_flag;
     header hdr{message_type::direct_message, flags, 0, mid.integer_value(),
                sender ? sender->id() : invalid_actor_id, dest_actor};
     auto writer = make_callback([&](serializer& sink) -> error {
-      return sink(forwarding_stack, msg);
+      if (!compact)
+        return sink(forwarding_stack, msg);
+      return error::eval([&] { return sink(forwarding_stack); },
+                         [&] { return msg.save_compact(sink); });
     });
     write(ctx, callee_.get_buffer(path->hdl), hdr, &writer);
   } else {
@@ -239,18 +268,26 @@ void instance::write_server_handshake(execution_unit* ctx, buffer_type& out_buf,
       aid = pa->first->id();
       iface = pa->second;
     }
-    return sink(this_node_, app_ids, aid, iface);
+    if (!compact_type_ids_)
+      return sink(this_node_, app_ids, aid, iface);
+    auto type_names = system().types().type_names();
+    return sink(this_node_, app_ids, aid, iface, type_names);
   });
-  header hdr{message_type::server_handshake, 0, 0, version,
+  uint8_t flags = compact_type_ids_ ? header::type_ids_flag : 0;
+  header hdr{message_type::server_handshake, flags, 0, version,
              invalid_actor_id, invalid_actor_id};
   write(ctx, out_buf, hdr, &writer);
 }
 
 void instance::write_client_handshake(execution_unit* ctx, buffer_type& buf) {
   auto writer = make_callback([&](serializer& sink) -> error {
-    return sink(this_node_);
+    if (!compact_type_ids_)
+      return sink(this_node_);
+    auto type_names = system().types().type_names();
+    return sink(this_node_, type_names);
   });
-  header hdr{message_type::client_handshake, 0, 0, 0,
+  uint8_t flags = compact_type_ids_ ? header::type_ids_flag : 0;
+  header hdr{message_type::client_handshake, flags, 0, 0,
              invalid_actor_id, invalid_actor_id};
   write(ctx, buf, hdr, &writer);
 }
@@ -310,6 +347,14 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
                         << ctx->system().render(err));
         return false;
       }
+      std::vector<std::string> type_names;
+      if (hdr.has(header::type_ids_flag)) {
+        if (auto err = bd(type_names)) {
+          CAF_LOG_WARNING("unable to deserialize type IDs of server handshake:"
+                          << ctx->system().render(err));
+          return false;
+        }
+      }
       // Check the application ID.
       auto whitelist = get_or(callee_.config(), "middleman.app-identifiers",
                               defaults::middleman::app_identifiers);
@@ -326,19 +371,20 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
         callee_.finalize_handshake(source_node, aid, sigs);
         return false;
       }
-      // Close this connection if we already have a direct connection.
-      if (tbl_.lookup_direct(source_node)) {
+      // Add direct route to this node or close this connection if we
+      // already have a direct connection.
+      if (!tbl_->add_direct(hdl, source_node)) {
         CAF_LOG_DEBUG("close redundant direct connection:"
                       << CAF_ARG(source_node));
         callee_.finalize_handshake(source_node, aid, sigs);
         return false;
       }
-      // Add direct route to this node and remove any indirect entry.
       CAF_LOG_DEBUG("new direct connection:" << CAF_ARG(source_node));
-      tbl_.add_direct(hdl, source_node);
-      auto was_indirect = tbl_.erase_indirect(source_node);
+      if (hdr.has(header::type_ids_flag))
+        add_type_ids(hdl, type_names);
+      auto was_indirect = tbl_->erase_indirect(source_node);
       // write handshake as client in response
-      auto path = tbl_.lookup(source_node);
+      auto path = tbl_->lookup(source_node);
       if (!path) {
         CAF_LOG_ERROR("no route to host after server handshake");
         return false;
@@ -358,16 +404,24 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
                         << ctx->system().render(err));
         return false;
       }
-      // Drop repeated handshakes.
-      if (tbl_.lookup_direct(source_node)) {
+      std::vector<std::string> type_names;
+      if (hdr.has(header::type_ids_flag)) {
+        if (auto err = bd(type_names)) {
+          CAF_LOG_WARNING("unable to deserialize type IDs of client handshake:"
+                          << ctx->system().render(err));
+          return false;
+        }
+      }
+      // Add direct route to this node and drop repeated handshakes.
+      if (!tbl_->add_direct(hdl, source_node)) {
         CAF_LOG_DEBUG("received repeated client handshake:"
                      << CAF_ARG(source_node));
         break;
       }
-      // Add direct route to this node and remove any indirect entry.
       CAF_LOG_DEBUG("new direct connection:" << CAF_ARG(source_node));
-      tbl_.add_direct(hdl, source_node);
-      auto was_indirect = tbl_.erase_indirect(source_node);
+      if (hdr.has(header::type_ids_flag))
+        add_type_ids(hdl, type_names);
+      auto was_indirect = tbl_->erase_indirect(source_node);
       callee_.learned_new_node_directly(source_node, was_indirect);
       break;
     }
@@ -376,13 +430,25 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
       binary_deserializer bd{ctx, *payload};
       std::vector<strong_actor_ptr> forwarding_stack;
       message msg;
-      if (auto err = bd(forwarding_stack, msg)) {
+      error err;
+      if (hdr.has(header::type_ids_flag)) {
+        auto ids = type_ids(hdl);
+        if (ids == nullptr) {
+          CAF_LOG_WARNING("received type IDs without type-ID table");
+          return false;
+        }
+        err = error::eval([&] { return bd(forwarding_stack); },
+                          [&] { return msg.load_compact(bd, *ids); });
+      } else {
+        err = bd(forwarding_stack, msg);
+      }
+      if (err) {
         CAF_LOG_WARNING("unable to deserialize payload of direct message:"
                         << ctx->system().render(err));
         return false;
       }
       // Dispatch message to callee_.
-      auto source_node = tbl_.lookup_direct(hdl);
+      auto source_node = tbl_->lookup_direct(hdl);
       if (hdr.has(header::named_receiver_flag))
         callee_.deliver(source_node, hdr.source_actor,
                         static_cast<atom_value>(hdr.dest_actor),
@@ -418,10 +484,10 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
       }
       // in case the sender of this message was received via a third node,
       // we assume that that node to offers a route to the original source
-      auto last_hop = tbl_.lookup_direct(hdl);
+      auto last_hop = tbl_->lookup_direct(hdl);
       if (source_node != none && source_node != this_node_
-          && last_hop != source_node && !tbl_.lookup_direct(source_node)
-          && tbl_.add_indirect(last_hop, source_node))
+          && last_hop != source_node && !tbl_->lookup_direct(source_node)
+          && tbl_->add_indirect(last_hop, source_node))
         callee_.learned_new_node_indirectly(source_node);
       if (hdr.has(header::named_receiver_flag))
         callee_.deliver(source_node, hdr.source_actor,
@@ -481,6 +547,29 @@ bool instance::handle(execution_unit* ctx, connection_handle hdl, header& hdr,
   return true;
 }
 
+void instance::erase_type_ids(connection_handle hdl) {
+  type_ids_.erase(hdl);
+}
+
+void instance::add_type_ids(connection_handle hdl,
+                            const std::vector<std::string>& type_names) {
+  if (!compact_type_ids_)
+    return;
+  auto& types = system().types();
+  // Index 0 is not a valid type ID and maps to 0 ("unknown type").
+  std::vector<uint16_t> ids;
+  ids.reserve(type_names.size() + 1);
+  ids.emplace_back(0);
+  for (auto& name : type_names)
+    ids.emplace_back(types.type_id(name));
+  type_ids_[hdl] = std::move(ids);
+}
+
+const std::vector<uint16_t>* instance::type_ids(connection_handle hdl) const {
+  auto i = type_ids_.find(hdl);
+  return i != type_ids_.end() ? &i->second : nullptr;
+}
+
 void instance::forward(execution_unit* ctx, const node_id& dest_node,
                        const header& hdr, std::vector<char>& payload) {
   CAF_LOG_TRACE(CAF_ARG(dest_node) << CAF_ARG(hdr) << CAF_ARG(payload));
@@ -491,6 +580,21 @@ void instance::forward(execution_unit* ctx, const node_id& dest_node,
       CAF_LOG_ERROR("unable to serialize BASP header");
       return;
     }
+    if (payload.size() >= zero_copy_threshold) {
+      // The payload is the receive buffer of the scribe, swapped into the
+      // `new_data_msg` only for the duration of this call. Moving it out saves
+      // copying the bytes, but we must leave a buffer with the same capacity
+      // behind. Otherwise, the scribe starts from scratch and reallocates on
+      // its next read.
+      auto capacity = payload.capacity();
+      auto chunk = std::make_shared<std::vector<char>>(std::move(payload));
+      payload.clear();
+      payload.reserve(capacity);
+      callee_.write(path->hdl, chunk);
+      flush(*path);
+      notify<hook::message_forwarded>(hdr, chunk.get());
+      return;
+    }
     if (auto err = bs.apply_raw(payload.size(), payload.data())) {
       CAF_LOG_ERROR("unable to serialize raw payload");
       return;
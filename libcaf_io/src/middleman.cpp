@@ -50,6 +50,10 @@
 #include "caf/io/network/test_multiplexer.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 
+#ifdef CAF_ENABLE_IO_URING
+#include "caf/io/network/uring_multiplexer.hpp"
+#endif // CAF_ENABLE_IO_URING
+
 #include "caf/scheduler/abstract_coordinator.hpp"
 
 #include "caf/detail/ripemd_160.hpp"
@@ -79,10 +83,40 @@ public:
     return backend_;
   }
 
+protected:
+  backend_pointer make_backend() override {
+    return backend_pointer{new T(&system())};
+  }
+
 private:
   T backend_;
 };
 
+// Runs `mpx` in a new thread and returns after the thread has started.
+std::thread launch_backend(actor_system& sys, network::multiplexer& mpx) {
+  std::atomic<bool> init_done{false};
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::thread result{[&] {
+    CAF_SET_LOGGER_SYS(&sys);
+    detail::set_thread_name("caf.multiplexer");
+    sys.thread_started();
+    CAF_LOG_TRACE("");
+    {
+      std::unique_lock<std::mutex> guard{mtx};
+      mpx.thread_id(std::this_thread::get_id());
+      init_done = true;
+      cv.notify_one();
+    }
+    mpx.run();
+    sys.thread_terminates();
+  }};
+  std::unique_lock<std::mutex> guard{mtx};
+  while (init_done == false)
+    cv.wait(guard);
+  return result;
+}
+
 } // namespace <anonymous>
 
 actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
@@ -91,6 +125,13 @@ actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
   switch (atom_uint(atm)) {
     case atom_uint(atom("testing")):
       return new mm_impl<network::test_multiplexer>(sys);
+#ifdef CAF_ENABLE_IO_URING
+    case atom_uint(atom("uring")):
+      // Fall back to the default multiplexer on kernels without io_uring.
+      if (network::uring_multiplexer::available())
+        return new mm_impl<network::uring_multiplexer>(sys);
+      return new mm_impl<network::default_multiplexer>(sys);
+#endif // CAF_ENABLE_IO_URING
     default:
       return new mm_impl<network::default_multiplexer>(sys);
   }
@@ -100,6 +141,19 @@ middleman::middleman(actor_system& sys) : system_(sys) {
   // nop
 }
 
+size_t middleman::num_backends() const {
+  return backends_.size() + 1;
+}
+
+network::multiplexer& middleman::backend(size_t index) {
+  CAF_ASSERT(index < num_backends());
+  return index == 0 ? backend() : *backends_[index - 1];
+}
+
+middleman::backend_pointer middleman::make_backend() {
+  return nullptr;
+}
+
 expected<strong_actor_ptr> middleman::remote_spawn_impl(const node_id& nid,
                                                         std::string& name,
                                                         message& args,
@@ -281,35 +335,59 @@ void middleman::start() {
   // thread instead. Other backends can set `middleman_detach_multiplexer` to
   // false to suppress creation of the supervisor.
   if (backend_supervisor_ != nullptr) {
-    std::atomic<bool> init_done{false};
-    std::mutex mtx;
-    std::condition_variable cv;
-    thread_ = std::thread{[&,this] {
-      CAF_SET_LOGGER_SYS(&system());
-      detail::set_thread_name("caf.multiplexer");
-      system().thread_started();
-      CAF_LOG_TRACE("");
-      {
-        std::unique_lock<std::mutex> guard{mtx};
-        backend().thread_id(std::this_thread::get_id());
-        init_done = true;
-        cv.notify_one();
+    thread_ = launch_backend(system(), backend());
+    // Launch additional backends for running BASP brokers in parallel. We
+    // cannot move TLS sessions between backends, hence OpenSSL always uses
+    // a single backend.
+    auto n = get_or(config(), "middleman.multiplexer-threads",
+                    defaults::middleman::multiplexer_threads);
+    if (!system().has_openssl_manager()) {
+      for (size_t i = 1; i < n; ++i) {
+        auto ptr = make_backend();
+        if (ptr == nullptr)
+          break;
+        auto sptr = ptr->make_supervisor();
+        if (sptr == nullptr)
+          break;
+        threads_.emplace_back(launch_backend(system(), *ptr));
+        backend_supervisors_.emplace_back(std::move(sptr));
+        backends_.emplace_back(std::move(ptr));
       }
-      backend().run();
-      system().thread_terminates();
-    }};
-    std::unique_lock<std::mutex> guard{mtx};
-    while (init_done == false)
-      cv.wait(guard);
+    }
   }
   // Spawn utility actors.
   auto basp = named_broker<basp_broker>(atom("BASP"));
   manager_ = make_middleman_actor(system(), basp);
-  auto hdl = actor_cast<actor>(basp);
+  // Spawn one BASP broker per additional backend. All of them share the
+  // routing table and proxies with the primary BASP broker, which assigns
+  // incoming and outgoing connections to its shards.
+  if (!backends_.empty()) {
+    auto primary = static_cast<basp_broker*>(actor_cast<abstract_actor*>(basp));
+    auto& shards = *primary->state.shards;
+    shards.set(0, basp);
+    for (size_t i = 0; i < backends_.size(); ++i) {
+      actor_config cfg{backends_[i].get()};
+      auto shard = system().spawn_impl<basp_broker, hidden>(cfg, primary);
+      shards.set(i + 1, shard);
+      basp_shards_.emplace_back(std::move(shard));
+    }
+  }
 }
 
 void middleman::stop() {
   CAF_LOG_TRACE("");
+  for (size_t i = 0; i < basp_shards_.size(); ++i) {
+    auto mpx = backends_[i].get();
+    auto hdl = basp_shards_[i];
+    mpx->dispatch([=] {
+      auto ptr = static_cast<broker*>(actor_cast<abstract_actor*>(hdl));
+      if (!ptr->getf(abstract_actor::is_terminated_flag)) {
+        ptr->context(mpx);
+        ptr->quit();
+        ptr->finalize();
+      }
+    });
+  }
   backend().dispatch([=] {
     CAF_LOG_TRACE("");
     notify<hook::before_shutdown>();
@@ -329,12 +407,17 @@ void middleman::stop() {
     backend_supervisor_.reset();
     if (thread_.joinable())
       thread_.join();
+    backend_supervisors_.clear();
+    for (auto& t : threads_)
+      t.join();
+    threads_.clear();
   } else {
     while (backend().try_run_once())
       ; // nop
   }
   hooks_.clear();
   named_brokers_.clear();
+  basp_shards_.clear();
   scoped_actor self{system(), true};
   self->send_exit(manager_, exit_reason::kill);
   if (!get_or(config(), "middleman.attach-utility-actors", false))
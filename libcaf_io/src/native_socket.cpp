@@ -172,6 +172,14 @@ namespace network {
     return {pipefds[0], pipefds[1]};
   }
 
+  expected<native_socket> duplicate_socket(native_socket fd) {
+    CAF_LOG_TRACE(CAF_ARG(fd));
+    CALL_CFUN(res, detail::cc_not_minus1, "dup", dup(fd));
+    child_process_inherit(res, false);
+    nonblocking(res, true);
+    return res;
+  }
+
 #else // CAF_WINDOWS
 
   int last_socket_error() {
@@ -235,6 +243,17 @@ namespace network {
     return unit;
   }
 
+  expected<native_socket> duplicate_socket(native_socket fd) {
+    WSAPROTOCOL_INFO info;
+    CALL_CFUN(tmp, detail::cc_zero, "WSADuplicateSocket",
+              WSADuplicateSocket(fd, GetCurrentProcessId(), &info));
+    CALL_CFUN(res, detail::cc_valid_socket, "WSASocket",
+              WSASocket(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+                        FROM_PROTOCOL_INFO, &info, 0, WSA_FLAG_OVERLAPPED));
+    nonblocking(res, true);
+    return res;
+  }
+
   /**************************************************************************\
    * Based on work of others;                                               *
    * original header:                                                       *
@@ -34,18 +34,19 @@ routing_table::~routing_table() {
 }
 
 optional<routing_table::route> routing_table::lookup(const node_id& target) {
-  auto hdl = lookup_direct(target);
-  if (hdl)
-    return route{target, *hdl};
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto i = direct_by_nid_.find(target);
+  if (i != direct_by_nid_.end())
+    return route{target, i->second};
   // pick first available indirect route
-  auto i = indirect_.find(target);
-  if (i != indirect_.end()) {
-    auto& hops = i->second;
+  auto j = indirect_.find(target);
+  if (j != indirect_.end()) {
+    auto& hops = j->second;
     while (!hops.empty()) {
       auto& hop = *hops.begin();
-      hdl = lookup_direct(hop);
-      if (hdl)
-        return route{hop, *hdl};
+      auto k = direct_by_nid_.find(hop);
+      if (k != direct_by_nid_.end())
+        return route{hop, k->second};
       hops.erase(hops.begin());
     }
   }
@@ -53,11 +54,13 @@ optional<routing_table::route> routing_table::lookup(const node_id& target) {
 }
 
 node_id routing_table::lookup_direct(const connection_handle& hdl) const {
+  std::unique_lock<std::mutex> guard{mtx_};
   return get_opt(direct_by_hdl_, hdl, none);
 }
 
 optional<connection_handle>
 routing_table::lookup_direct(const node_id& nid) const {
+  std::unique_lock<std::mutex> guard{mtx_};
   auto i = direct_by_nid_.find(nid);
   if (i != direct_by_nid_.end())
     return i->second;
@@ -65,6 +68,7 @@ routing_table::lookup_direct(const node_id& nid) const {
 }
 
 node_id routing_table::lookup_indirect(const node_id& nid) const {
+  std::unique_lock<std::mutex> guard{mtx_};
   auto i = indirect_.find(nid);
   if (i == indirect_.end())
     return none;
@@ -74,6 +78,7 @@ node_id routing_table::lookup_indirect(const node_id& nid) const {
 }
 
 void routing_table::blacklist(const node_id& hop, const node_id& dest) {
+  std::unique_lock<std::mutex> guard{mtx_};
   blacklist_[dest].emplace(hop);
   auto i = indirect_.find(dest);
   if (i == indirect_.end())
@@ -83,73 +88,101 @@ void routing_table::blacklist(const node_id& hop, const node_id& dest) {
     indirect_.erase(i);
 }
 
+// Note: we never call callbacks or hooks while holding the lock, since they
+//       may access data structures that in turn access the routing table.
+
 void routing_table::erase_direct(const connection_handle& hdl,
                                  erase_callback& cb) {
-  auto i = direct_by_hdl_.find(hdl);
-  if (i == direct_by_hdl_.end())
-    return;
-  cb(i->second);
-  parent_->parent().notify<hook::connection_lost>(i->second);
-  direct_by_nid_.erase(i->second);
-  direct_by_hdl_.erase(i->first);
+  node_id nid;
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto i = direct_by_hdl_.find(hdl);
+    if (i == direct_by_hdl_.end())
+      return;
+    nid = i->second;
+  }
+  cb(nid);
+  parent_->parent().notify<hook::connection_lost>(nid);
+  std::unique_lock<std::mutex> guard{mtx_};
+  direct_by_nid_.erase(nid);
+  direct_by_hdl_.erase(hdl);
 }
 
 bool routing_table::erase_indirect(const node_id& dest) {
-  auto i = indirect_.find(dest);
-  if (i == indirect_.end())
-    return false;
+  node_id_set hops;
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto i = indirect_.find(dest);
+    if (i == indirect_.end())
+      return false;
+    hops.swap(i->second);
+    indirect_.erase(i);
+  }
   if (parent_->parent().has_hook())
-    for (auto& nid : i->second)
+    for (auto& nid : hops)
       parent_->parent().notify<hook::route_lost>(nid, dest);
-  indirect_.erase(i);
   return true;
 }
 
-void routing_table::add_direct(const connection_handle& hdl,
+bool routing_table::add_direct(const connection_handle& hdl,
                                const node_id& nid) {
-  CAF_ASSERT(direct_by_hdl_.count(hdl) == 0);
-  CAF_ASSERT(direct_by_nid_.count(nid) == 0);
-  direct_by_hdl_.emplace(hdl, nid);
-  direct_by_nid_.emplace(nid, hdl);
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{mtx_};
+    CAF_ASSERT(direct_by_hdl_.count(hdl) == 0);
+    if (direct_by_nid_.count(nid) > 0)
+      return false;
+    direct_by_hdl_.emplace(hdl, nid);
+    direct_by_nid_.emplace(nid, hdl);
+  }
   parent_->parent().notify<hook::new_connection_established>(nid);
+  return true;
 }
 
 bool routing_table::add_indirect(const node_id& hop, const node_id& dest) {
-  auto i = blacklist_.find(dest);
-  if (i == blacklist_.end() || i->second.count(hop) == 0) {
+  bool added_first;
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto i = blacklist_.find(dest);
+    if (i != blacklist_.end() && i->second.count(hop) > 0)
+      return false; // blacklisted
     auto& hops = indirect_[dest];
-    auto added_first = hops.empty();
+    added_first = hops.empty();
     hops.emplace(hop);
-    parent_->parent().notify<hook::new_route_added>(hop, dest);
-    return added_first;
   }
-  return false; // blacklisted
+  parent_->parent().notify<hook::new_route_added>(hop, dest);
+  return added_first;
 }
 
 bool routing_table::reachable(const node_id& dest) {
+  std::unique_lock<std::mutex> guard{mtx_};
   return direct_by_nid_.count(dest) > 0 || indirect_.count(dest) > 0;
 }
 
 size_t routing_table::erase(const node_id& dest, erase_callback& cb) {
   cb(dest);
-  size_t res = 0;
-  auto i = indirect_.find(dest);
-  if (i != indirect_.end()) {
-    res = i->second.size();
-    for (auto& nid : i->second) {
-      cb(nid);
-      parent_->parent().notify<hook::route_lost>(nid, dest);
+  node_id_set hops;
+  bool had_direct_route = false;
+  { // Lifetime scope of guard.
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto i = indirect_.find(dest);
+    if (i != indirect_.end()) {
+      hops.swap(i->second);
+      indirect_.erase(i);
+    }
+    auto j = direct_by_nid_.find(dest);
+    if (j != direct_by_nid_.end()) {
+      direct_by_hdl_.erase(j->second);
+      direct_by_nid_.erase(j);
+      had_direct_route = true;
     }
-    indirect_.erase(i);
   }
-  auto hdl = lookup_direct(dest);
-  if (hdl) {
-    direct_by_hdl_.erase(*hdl);
-    direct_by_nid_.erase(dest);
-    parent_->parent().notify<hook::connection_lost>(dest);
-    ++res;
+  for (auto& nid : hops) {
+    cb(nid);
+    parent_->parent().notify<hook::route_lost>(nid, dest);
   }
-  return res;
+  if (had_direct_route)
+    parent_->parent().notify<hook::connection_lost>(dest);
+  return hops.size() + (had_direct_route ? 1 : 0);
 }
 
 } // namespace basp
@@ -31,6 +31,12 @@ scribe::~scribe() {
   CAF_LOG_TRACE("");
 }
 
+void scribe::write(network::chunk_ptr chunk) {
+  CAF_ASSERT(chunk != nullptr);
+  auto& buf = wr_buf();
+  buf.insert(buf.end(), chunk->begin(), chunk->end());
+}
+
 message scribe::detach_message() {
   return make_message(connection_closed_msg{hdl()});
 }
@@ -51,6 +51,10 @@ std::vector<char>& scribe_impl::wr_buf() {
   return stream_.wr_buf();
 }
 
+void scribe_impl::write(chunk_ptr chunk) {
+  stream_.write(std::move(chunk));
+}
+
 std::vector<char>& scribe_impl::rd_buf() {
   return stream_.rd_buf();
 }
@@ -0,0 +1,66 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/io/basp/shard_table.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+shard_table::shard_table(size_t num_shards) : brokers_(num_shards) {
+  CAF_ASSERT(num_shards > 0);
+}
+
+size_t shard_table::select(connection_handle hdl) const {
+  return static_cast<size_t>(hdl.id()) % brokers_.size();
+}
+
+void shard_table::set(size_t shard, actor broker) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  CAF_ASSERT(shard < brokers_.size());
+  brokers_[shard] = std::move(broker);
+}
+
+actor shard_table::get(size_t shard) const {
+  std::unique_lock<std::mutex> guard{mtx_};
+  CAF_ASSERT(shard < brokers_.size());
+  return brokers_[shard];
+}
+
+void shard_table::assign(connection_handle hdl, actor broker) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  owners_[hdl] = std::move(broker);
+}
+
+void shard_table::erase(connection_handle hdl) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  owners_.erase(hdl);
+}
+
+actor shard_table::owner(connection_handle hdl) const {
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto i = owners_.find(hdl);
+  if (i != owners_.end())
+    return i->second;
+  return nullptr;
+}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
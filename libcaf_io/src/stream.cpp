@@ -37,7 +37,8 @@ stream::stream(default_multiplexer& backend_ref, native_socket sockfd)
                defaults::middleman::max_consecutive_reads)),
       read_threshold_(1),
       collected_(0),
-      written_(0) {
+      written_(0),
+      wr_queue_size_(0) {
   configure_read(receive_policy::at_most(1024));
 }
 
@@ -66,10 +67,20 @@ void stream::write(const void* buf, size_t num_bytes) {
   wr_offline_buf_.insert(wr_offline_buf_.end(), first, last);
 }
 
+void stream::write(chunk_ptr chunk) {
+  CAF_ASSERT(chunk != nullptr);
+  CAF_LOG_TRACE(CAF_ARG2("num_bytes", chunk->size()));
+  if (chunk->empty())
+    return;
+  enqueue_wr_offline_buf();
+  wr_queue_size_ += chunk->size();
+  wr_queue_.emplace_back(std::move(chunk), false);
+}
+
 void stream::flush(const manager_ptr& mgr) {
   CAF_ASSERT(mgr != nullptr);
-  CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()));
-  if (!wr_offline_buf_.empty() && !state_.writing) {
+  CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()) << CAF_ARG(wr_queue_size_));
+  if ((!wr_offline_buf_.empty() || !wr_queue_.empty()) && !state_.writing) {
     backend().add(operation::write, fd(), this);
     writer_ = mgr;
     state_.writing = true;
@@ -133,19 +144,60 @@ void stream::prepare_next_read() {
 }
 
 void stream::prepare_next_write() {
-  CAF_LOG_TRACE(CAF_ARG(wr_buf_.size()) << CAF_ARG(wr_offline_buf_.size()));
-  written_ = 0;
-  wr_buf_.clear();
-  if (wr_offline_buf_.empty()) {
+  CAF_LOG_TRACE(CAF_ARG(wr_queue_size_) << CAF_ARG(wr_offline_buf_.size()));
+  enqueue_wr_offline_buf();
+  if (wr_queue_.empty()) {
     state_.writing = false;
     backend().del(operation::write, fd(), this);
     if (state_.shutting_down)
       send_fin();
-  } else {
-    wr_buf_.swap(wr_offline_buf_);
   }
 }
 
+void stream::enqueue_wr_offline_buf() {
+  if (wr_offline_buf_.empty())
+    return;
+  std::shared_ptr<buffer_type> chunk;
+  if (wr_spare_buf_ != nullptr)
+    chunk.swap(wr_spare_buf_);
+  else
+    chunk = std::make_shared<buffer_type>();
+  // Swapping hands the capacity of the recycled chunk to the write buffer.
+  chunk->swap(wr_offline_buf_);
+  wr_queue_size_ += chunk->size();
+  wr_queue_.emplace_back(std::move(chunk), true);
+}
+
+void stream::pop_wr_queue() {
+  CAF_ASSERT(!wr_queue_.empty());
+  auto& front = wr_queue_.front();
+  if (front.second && wr_spare_buf_ == nullptr && front.first.use_count() == 1) {
+    wr_spare_buf_ = std::const_pointer_cast<buffer_type>(front.first);
+    wr_spare_buf_->clear();
+  }
+  wr_queue_.pop_front();
+  written_ = 0;
+}
+
+size_t stream::prepare_io_vecs(io_vec* bufs) {
+  // Also pick up data that was written since the last flush.
+  enqueue_wr_offline_buf();
+  if (wr_queue_.empty()) {
+    // Policies such as SSL rely on write events without any data.
+    bufs[0] = io_vec{nullptr, 0};
+    return 1;
+  }
+  size_t result = 0;
+  auto offset = written_;
+  for (auto i = wr_queue_.begin();
+       i != wr_queue_.end() && result < max_io_vecs; ++i) {
+    auto& buf = *i->first;
+    bufs[result++] = io_vec{buf.data() + offset, buf.size() - offset};
+    offset = 0;
+  }
+  return result;
+}
+
 bool stream::handle_read_result(rw_state read_result, size_t rb) {
   switch (read_result) {
     case rw_state::failure:
@@ -179,19 +231,33 @@ void stream::handle_write_result(rw_state write_result, size_t wb) {
       backend().del(operation::write, fd(), this);
       break;
     case rw_state::indeterminate:
+      wr_queue_.clear();
+      wr_queue_size_ = 0;
+      written_ = 0;
       prepare_next_write();
       break;
-    case rw_state::success:
-      written_ += wb;
-      CAF_ASSERT(written_ <= wr_buf_.size());
-      auto remaining = wr_buf_.size() - written_;
+    case rw_state::success: {
+      CAF_ASSERT(wb <= wr_queue_size_);
+      wr_queue_size_ -= wb;
+      // drop all chunks we have written completely
+      auto n = wb;
+      while (n > 0) {
+        auto remaining = wr_queue_.front().first->size() - written_;
+        if (n < remaining) {
+          written_ += n;
+          break;
+        }
+        n -= remaining;
+        pop_wr_queue();
+      }
       if (state_.ack_writes)
         writer_->data_transferred(&backend(), wb,
-                                  remaining + wr_offline_buf_.size());
+                                  wr_queue_size_ + wr_offline_buf_.size());
       // prepare next send (or stop sending)
-      if (remaining == 0)
+      if (wr_queue_.empty())
         prepare_next_write();
       break;
+    }
   }
 }
 
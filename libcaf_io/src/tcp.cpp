@@ -27,9 +27,12 @@
 #else
 # include <sys/types.h>
 # include <sys/socket.h>
+# include <sys/uio.h>
 #endif
 
+using caf::io::network::io_vec;
 using caf::io::network::is_error;
+using caf::io::network::max_io_vecs;
 using caf::io::network::rw_state;
 using caf::io::network::native_socket;
 using caf::io::network::socket_size_type;
@@ -64,6 +67,42 @@ rw_state tcp::write_some(size_t& result, native_socket fd, const void* buf,
   return rw_state::success;
 }
 
+rw_state tcp::write_some(size_t& result, native_socket fd, const io_vec* bufs,
+                         size_t num_bufs) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num_bufs));
+  CAF_ASSERT(num_bufs <= max_io_vecs);
+#ifdef CAF_WINDOWS
+  WSABUF xs[max_io_vecs];
+  for (size_t i = 0; i < num_bufs; ++i) {
+    xs[i].buf = const_cast<char*>(static_cast<const char*>(bufs[i].data));
+    xs[i].len = static_cast<ULONG>(bufs[i].size);
+  }
+  DWORD sent = 0;
+  auto sres = ::WSASend(fd, xs, static_cast<DWORD>(num_bufs), &sent, 0,
+                        nullptr, nullptr);
+  CAF_LOG_DEBUG(CAF_ARG(fd) << CAF_ARG(sres) << CAF_ARG(sent));
+  if (is_error(sres, true))
+    return rw_state::failure;
+  result = sres == 0 ? static_cast<size_t>(sent) : 0;
+#else
+  iovec xs[max_io_vecs];
+  for (size_t i = 0; i < num_bufs; ++i) {
+    xs[i].iov_base = const_cast<void*>(bufs[i].data);
+    xs[i].iov_len = bufs[i].size;
+  }
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = xs;
+  msg.msg_iovlen = num_bufs;
+  auto sres = ::sendmsg(fd, &msg, no_sigpipe_io_flag);
+  CAF_LOG_DEBUG(CAF_ARG(fd) << CAF_ARG(sres));
+  if (is_error(sres, true))
+    return rw_state::failure;
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+#endif
+  return rw_state::success;
+}
+
 bool tcp::try_accept(native_socket& result, native_socket fd) {
   using namespace io::network;
   CAF_LOG_TRACE(CAF_ARG(fd));
@@ -0,0 +1,132 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#ifdef CAF_ENABLE_IO_URING
+
+#include "caf/io/network/uring_acceptor.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+
+#include "caf/logger.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+namespace {
+
+// Hands a socket from a completed accept request to `acceptor`.
+struct accepted_socket_policy {
+  native_socket sockfd;
+
+  bool try_accept(native_socket& result, native_socket) {
+    result = sockfd;
+    return true;
+  }
+};
+
+} // namespace <anonymous>
+
+uring_acceptor::uring_acceptor(uring_multiplexer& mpx, native_socket sockfd)
+    : acceptor(mpx, sockfd),
+      uring_handler(mpx),
+      want_accept_(false),
+      accept_pending_(false) {
+  // nop
+}
+
+void uring_acceptor::handle_event(operation) {
+  // nop, the multiplexer drives this acceptor via `resume` and `complete`
+}
+
+void uring_acceptor::arm(operation op) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(op));
+  if (op == operation::read) {
+    want_accept_ = true;
+    mpx_->schedule(this);
+  }
+}
+
+void uring_acceptor::disarm(operation op) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(op));
+  if (op == operation::read) {
+    want_accept_ = false;
+    if (accept_pending_)
+      mpx_->cancel(this, uring_multiplexer::accept_tag);
+  }
+}
+
+void uring_acceptor::resume() {
+  if (mpx_ == nullptr || mpx_->closing())
+    return;
+  if (want_accept_ && manager() && !accept_pending_) {
+    mpx_->submit_accept(this, fd());
+    accept_pending_ = true;
+    accept_guard_ = manager();
+  }
+}
+
+void uring_acceptor::complete(uint8_t, int32_t res, uint32_t flags) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(res));
+  // The guard keeps this acceptor alive until the end of this scope.
+  manager_ptr guard;
+  if ((flags & IORING_CQE_F_MORE) == 0) {
+    accept_pending_ = false;
+    guard.swap(accept_guard_);
+  }
+  if (res >= 0) {
+    if (!want_accept_ || !manager() || mpx_->closing()) {
+      close_socket(res);
+      return;
+    }
+    accepted_socket_policy policy{res};
+    handle_event_impl(operation::read, policy);
+  } else {
+    switch (-res) {
+      case ECANCELED:
+        return;
+      case EINTR:
+      case EAGAIN:
+      case EMFILE:
+      case ENFILE:
+      case ENOBUFS:
+      case ENOMEM:
+      case ECONNABORTED:
+        // Try again, just like the readiness-based acceptor does.
+        break;
+      default:
+        // Most likely, the socket was shut down.
+        CAF_LOG_DEBUG("accept failed:" << CAF_ARG2("fd", fd_)
+                      << CAF_ARG2("error", strerror(-res)));
+        want_accept_ = false;
+    }
+  }
+  if (!accept_pending_)
+    resume();
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_ENABLE_IO_URING
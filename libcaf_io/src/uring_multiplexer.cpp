@@ -0,0 +1,706 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#ifdef CAF_ENABLE_IO_URING
+
+#include "caf/io/network/uring_multiplexer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "caf/logger.hpp"
+#include "caf/make_counted.hpp"
+
+#include "caf/io/doorman.hpp"
+#include "caf/io/scribe.hpp"
+
+#include "caf/io/network/uring_acceptor.hpp"
+#include "caf/io/network/uring_stream.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+namespace {
+
+static_assert((uring_multiplexer::num_buffers
+               & (uring_multiplexer::num_buffers - 1)) == 0,
+              "the size of a buffer ring must be a power of two");
+
+// The low bits of the user data in a request store its tag. This works
+// because handlers are aligned to at least 8 bytes.
+constexpr uint64_t tag_mask = 0x7;
+
+uint64_t make_user_data(uring_handler* ptr,
+                        uring_multiplexer::request_tag tag) {
+  auto result = reinterpret_cast<uint64_t>(ptr);
+  CAF_ASSERT((result & tag_mask) == 0);
+  return result | tag;
+}
+
+// We talk to the kernel directly instead of depending on liburing.
+
+int uring_setup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+int uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg,
+                                  nr_args));
+}
+
+// Creates a ring with the queue sizes of `uring_multiplexer` and returns its
+// file descriptor or -1 on error.
+int create_ring(io_uring_params& params, unsigned flags) {
+  memset(&params, 0, sizeof(io_uring_params));
+  params.flags = IORING_SETUP_CQSIZE | flags;
+  params.cq_entries = uring_multiplexer::cq_entries;
+  return uring_setup(uring_multiplexer::sq_entries, &params);
+}
+
+// Returns `nullptr` on error.
+void* map_ring(int fd, size_t size, off_t offset) {
+  auto result = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, offset);
+  if (result == MAP_FAILED)
+    return nullptr;
+  return result;
+}
+
+constexpr size_t buf_ring_size = uring_multiplexer::num_buffers
+                                 * sizeof(io_uring_buf);
+
+// Allocates a buffer ring and registers it as buffer group 0. Returns `nullptr`
+// on error and leaves `errno` untouched by the cleanup.
+io_uring_buf_ring* register_buf_ring(int ring_fd) {
+  auto ptr = mmap(nullptr, buf_ring_size, PROT_READ | PROT_WRITE,
+                  MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  if (ptr == MAP_FAILED)
+    return nullptr;
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(io_uring_buf_reg));
+  reg.ring_addr = reinterpret_cast<uint64_t>(ptr);
+  reg.ring_entries = uring_multiplexer::num_buffers;
+  reg.bgid = 0;
+  if (uring_register(ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+    auto err = errno;
+    munmap(ptr, buf_ring_size);
+    errno = err;
+    return nullptr;
+  }
+  return static_cast<io_uring_buf_ring*>(ptr);
+}
+
+template <class T>
+T* ring_field(void* ring, unsigned offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+/// Scribe implementation for the io_uring multiplexer.
+class uring_scribe : public scribe {
+public:
+  uring_scribe(uring_multiplexer& mx, native_socket sockfd)
+      : scribe(conn_hdl_from_socket(sockfd)),
+        launched_(false),
+        stream_(mx, sockfd) {
+    // nop
+  }
+
+  void configure_read(receive_policy::config config) override {
+    CAF_LOG_TRACE("");
+    stream_.configure_read(config);
+    if (!launched_)
+      launch();
+  }
+
+  void ack_writes(bool enable) override {
+    CAF_LOG_TRACE(CAF_ARG(enable));
+    stream_.ack_writes(enable);
+  }
+
+  std::vector<char>& wr_buf() override {
+    return stream_.wr_buf();
+  }
+
+  std::vector<char>& rd_buf() override {
+    return stream_.rd_buf();
+  }
+
+  void write(chunk_ptr chunk) override {
+    stream_.write(std::move(chunk));
+  }
+
+  void graceful_shutdown() override {
+    CAF_LOG_TRACE("");
+    stream_.graceful_shutdown();
+    detach(&stream_.backend(), false);
+  }
+
+  void flush() override {
+    CAF_LOG_TRACE("");
+    stream_.flush(this);
+  }
+
+  std::string addr() const override {
+    auto x = remote_addr_of_fd(stream_.fd());
+    if (!x)
+      return "";
+    return *x;
+  }
+
+  uint16_t port() const override {
+    auto x = remote_port_of_fd(stream_.fd());
+    if (!x)
+      return 0;
+    return *x;
+  }
+
+  void launch() {
+    CAF_LOG_TRACE("");
+    CAF_ASSERT(!launched_);
+    launched_ = true;
+    stream_.start(this);
+  }
+
+  void add_to_loop() override {
+    stream_.activate(this);
+  }
+
+  void remove_from_loop() override {
+    stream_.passivate();
+  }
+
+private:
+  bool launched_;
+  uring_stream stream_;
+};
+
+/// Doorman implementation for the io_uring multiplexer.
+class uring_doorman : public doorman {
+public:
+  uring_doorman(uring_multiplexer& mx, native_socket sockfd)
+      : doorman(accept_hdl_from_socket(sockfd)),
+        acceptor_(mx, sockfd) {
+    // nop
+  }
+
+  bool new_connection() override {
+    CAF_LOG_TRACE("");
+    // See doorman_impl::new_connection.
+    if (detached())
+      return false;
+    auto& dm = acceptor_.backend();
+    auto sptr = dm.new_scribe(acceptor_.accepted_socket());
+    auto hdl = sptr->hdl();
+    parent()->add_scribe(std::move(sptr));
+    return doorman::new_connection(&dm, hdl);
+  }
+
+  void graceful_shutdown() override {
+    CAF_LOG_TRACE("");
+    acceptor_.graceful_shutdown();
+    detach(&acceptor_.backend(), false);
+  }
+
+  void launch() override {
+    CAF_LOG_TRACE("");
+    acceptor_.start(this);
+  }
+
+  std::string addr() const override {
+    auto x = local_addr_of_fd(acceptor_.fd());
+    if (!x)
+      return "";
+    return std::move(*x);
+  }
+
+  uint16_t port() const override {
+    auto x = local_port_of_fd(acceptor_.fd());
+    if (!x)
+      return 0;
+    return *x;
+  }
+
+  void add_to_loop() override {
+    acceptor_.activate(this);
+  }
+
+  void remove_from_loop() override {
+    acceptor_.passivate();
+  }
+
+private:
+  uring_acceptor acceptor_;
+};
+
+} // namespace <anonymous>
+
+// -- uring_handler ------------------------------------------------------------
+
+uring_handler::uring_handler(uring_multiplexer& mpx)
+    : mpx_(&mpx),
+      registered_(false) {
+  // nop
+}
+
+uring_handler::~uring_handler() {
+  if (mpx_ != nullptr && registered_)
+    mpx_->forget(this);
+}
+
+// -- uring_multiplexer --------------------------------------------------------
+
+uring_multiplexer::uring_multiplexer(actor_system* sys)
+    : default_multiplexer(sys),
+      ring_fd_(-1),
+      sq_ptr_(nullptr),
+      cq_ptr_(nullptr),
+      sqes_(nullptr),
+      buf_ring_(nullptr),
+      buf_tail_(0),
+      free_buffers_(0),
+      epoll_armed_(false),
+      closing_(false),
+      requests_(0) {
+  // `available` only probes a single ring. Running out of locked memory or
+  // file descriptors for additional rings degrades this multiplexer to a
+  // plain epoll-based one instead of taking down the process.
+  if (!init_ring()) {
+    CAF_LOG_ERROR("unable to set up io_uring, falling back to epoll:"
+                  << strerror(errno));
+    release_ring();
+  }
+}
+
+uring_multiplexer::~uring_multiplexer() {
+  if (uses_ring()) {
+    // Handlers keep their managers alive while they have requests in the
+    // ring. Hence, we need to cancel all requests and wait for their
+    // completion.
+    closing_ = true;
+    if (requests_ > 0) {
+      auto sqe = next_sqe(nullptr, cancel_tag);
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+      while (requests_ > 0) {
+        submit(1);
+        handle_completions();
+      }
+    }
+    handle_pending();
+    for (auto ptr : handlers_)
+      ptr->mpx_ = nullptr;
+  }
+  release_ring();
+}
+
+bool uring_multiplexer::available() {
+  // Multishot receive requests require Linux 6.0, which also introduced
+  // single issuer rings. Hence, the kernel supports everything we need if it
+  // accepts this flag. On top of that, we run the same setup as the
+  // constructor, because io_uring may be disabled via sysctl or seccomp
+  // filters and the queue sizes as well as the buffer ring count against the
+  // locked memory limit.
+  io_uring_params params;
+  auto fd = create_ring(params, IORING_SETUP_SINGLE_ISSUER);
+  if (fd < 0)
+    return false;
+  auto buf_ring = register_buf_ring(fd);
+  close(fd);
+  if (buf_ring == nullptr)
+    return false;
+  munmap(buf_ring, buf_ring_size);
+  return true;
+}
+
+scribe_ptr uring_multiplexer::new_scribe(native_socket fd) {
+  CAF_LOG_TRACE("");
+  if (!uses_ring())
+    return default_multiplexer::new_scribe(fd);
+  return make_counted<uring_scribe>(*this, fd);
+}
+
+doorman_ptr uring_multiplexer::new_doorman(native_socket fd) {
+  CAF_LOG_TRACE(CAF_ARG(fd));
+  CAF_ASSERT(fd != network::invalid_native_socket);
+  if (!uses_ring())
+    return default_multiplexer::new_doorman(fd);
+  return make_counted<uring_doorman>(*this, fd);
+}
+
+void uring_multiplexer::run() {
+  if (!uses_ring()) {
+    default_multiplexer::run();
+    return;
+  }
+  CAF_LOG_TRACE("io_uring-based multiplexer");
+  while (num_socket_handlers() > 0 || requests_ > 0 || !ready_.empty()
+         || !removed_.empty())
+    poll_once(true);
+}
+
+void uring_multiplexer::add(operation op, native_socket fd,
+                            event_handler* ptr) {
+  auto x = dynamic_cast<uring_handler*>(ptr);
+  if (x == nullptr) {
+    default_multiplexer::add(op, fd, ptr);
+    return;
+  }
+  CAF_LOG_TRACE(CAF_ARG(op) << CAF_ARG(fd));
+  if (!x->registered_) {
+    handlers_.emplace(x);
+    x->registered_ = true;
+  }
+  // Adding an operation again before delivering the `removed_from_loop`
+  // callback turns both events into a nop, just like squashing epoll events.
+  auto pred = [&](const removal& y) { return y.handler == x && y.op == op; };
+  auto i = std::find_if(removed_.begin(), removed_.end(), pred);
+  if (i != removed_.end())
+    removed_.erase(i);
+  x->arm(op);
+}
+
+void uring_multiplexer::del(operation op, native_socket fd,
+                            event_handler* ptr) {
+  auto x = dynamic_cast<uring_handler*>(ptr);
+  if (x == nullptr) {
+    default_multiplexer::del(op, fd, ptr);
+    return;
+  }
+  CAF_LOG_TRACE(CAF_ARG(op) << CAF_ARG(fd));
+  x->disarm(op);
+  auto pred = [&](const removal& y) { return y.handler == x && y.op == op; };
+  if (std::none_of(removed_.begin(), removed_.end(), pred))
+    removed_.emplace_back(removal{x, ptr, op});
+}
+
+void uring_multiplexer::schedule(uring_handler* ptr) {
+  ready_.emplace_back(ptr);
+}
+
+void uring_multiplexer::submit_recv(uring_handler* ptr, native_socket fd) {
+  auto sqe = next_sqe(ptr, recv_tag);
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = 0;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+}
+
+void uring_multiplexer::submit_sendmsg(uring_handler* ptr, native_socket fd,
+                                       msghdr* msg) {
+  auto sqe = next_sqe(ptr, send_tag);
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(msg);
+  sqe->len = 1;
+  sqe->msg_flags = MSG_NOSIGNAL;
+}
+
+void uring_multiplexer::submit_accept(uring_handler* ptr, native_socket fd) {
+  auto sqe = next_sqe(ptr, accept_tag);
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = fd;
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags = SOCK_CLOEXEC;
+}
+
+void uring_multiplexer::cancel(uring_handler* ptr, request_tag tag) {
+  auto sqe = next_sqe(ptr, cancel_tag);
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->addr = make_user_data(ptr, tag);
+}
+
+void uring_multiplexer::recycle(uint16_t id) {
+  add_buffer(id);
+  __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+  if (!starved_.empty()) {
+    for (auto ptr : starved_)
+      schedule(ptr);
+    starved_.clear();
+  }
+}
+
+void uring_multiplexer::wait_for_buffers(uring_handler* ptr) {
+  // The kernel may consume the entire pool before we get to process any
+  // completion. In this case, all buffers may have returned to the pool by
+  // the time a handler observes ENOBUFS.
+  if (free_buffers_ > 0)
+    schedule(ptr);
+  else if (!waiting_for_buffers(ptr))
+    starved_.emplace_back(ptr);
+}
+
+bool uring_multiplexer::waiting_for_buffers(const uring_handler* ptr) const {
+  return std::find(starved_.begin(), starved_.end(), ptr) != starved_.end();
+}
+
+bool uring_multiplexer::poll_once_impl(bool block) {
+  if (!uses_ring())
+    return default_multiplexer::poll_once_impl(block);
+  CAF_LOG_TRACE("io_uring-based multiplexer" << CAF_ARG(block));
+  auto result = handle_pending();
+  // Dispatch readiness events of the base class whenever epoll has events.
+  if (!epoll_armed_ && num_socket_handlers() > 0) {
+    auto sqe = next_sqe(nullptr, poll_tag);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = epoll_fd();
+    sqe->poll32_events = POLLIN;
+    epoll_armed_ = true;
+  }
+  submit(block && !result ? 1 : 0);
+  if (handle_completions())
+    result = true;
+  if (handle_pending())
+    result = true;
+  handle_internal_events();
+  return result;
+}
+
+bool uring_multiplexer::init_ring() {
+  io_uring_params params;
+  ring_fd_ = create_ring(params, 0);
+  if (ring_fd_ < 0)
+    return false;
+  // Map the submission queue, the completion queue and the queue entries.
+  sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+    sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    sq_ptr_ = map_ring(ring_fd_, sq_size_, IORING_OFF_SQ_RING);
+    cq_ptr_ = sq_ptr_;
+  } else {
+    sq_ptr_ = map_ring(ring_fd_, sq_size_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ != nullptr)
+      cq_ptr_ = map_ring(ring_fd_, cq_size_, IORING_OFF_CQ_RING);
+  }
+  if (sq_ptr_ == nullptr || cq_ptr_ == nullptr)
+    return false;
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(map_ring(ring_fd_, sqes_size_,
+                                              IORING_OFF_SQES));
+  if (sqes_ == nullptr)
+    return false;
+  sq_head_ = ring_field<unsigned>(sq_ptr_, params.sq_off.head);
+  sq_tail_ = ring_field<unsigned>(sq_ptr_, params.sq_off.tail);
+  sq_flags_ = ring_field<unsigned>(sq_ptr_, params.sq_off.flags);
+  sq_array_ = ring_field<unsigned>(sq_ptr_, params.sq_off.array);
+  sq_mask_ = *ring_field<unsigned>(sq_ptr_, params.sq_off.ring_mask);
+  sq_local_tail_ = *sq_tail_;
+  to_submit_ = 0;
+  cq_head_ = ring_field<unsigned>(cq_ptr_, params.cq_off.head);
+  cq_tail_ = ring_field<unsigned>(cq_ptr_, params.cq_off.tail);
+  cqes_ = ring_field<io_uring_cqe>(cq_ptr_, params.cq_off.cqes);
+  cq_mask_ = *ring_field<unsigned>(cq_ptr_, params.cq_off.ring_mask);
+  // Register the buffer pool for multishot receive requests.
+  buf_ring_ = register_buf_ring(ring_fd_);
+  if (buf_ring_ == nullptr)
+    return false;
+  buffers_.resize(num_buffers * buffer_size);
+  for (uint16_t id = 0; id < num_buffers; ++id)
+    add_buffer(id);
+  __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+  return true;
+}
+
+void uring_multiplexer::release_ring() {
+  if (buf_ring_ != nullptr) {
+    munmap(buf_ring_, buf_ring_size);
+    buf_ring_ = nullptr;
+  }
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_)
+    munmap(cq_ptr_, cq_size_);
+  cq_ptr_ = nullptr;
+  if (sq_ptr_ != nullptr) {
+    munmap(sq_ptr_, sq_size_);
+    sq_ptr_ = nullptr;
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+io_uring_sqe* uring_multiplexer::next_sqe(uring_handler* ptr,
+                                          request_tag tag) {
+  auto head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sq_local_tail_ - head > sq_mask_) {
+    // Make room by handing all pending entries to the kernel.
+    submit(0);
+    head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sq_local_tail_ - head > sq_mask_)
+      CAF_CRITICAL("io_uring submission queue overflow");
+  }
+  auto index = sq_local_tail_ & sq_mask_;
+  auto sqe = sqes_ + index;
+  memset(sqe, 0, sizeof(io_uring_sqe));
+  sqe->user_data = make_user_data(ptr, tag);
+  sq_array_[index] = index;
+  ++sq_local_tail_;
+  ++to_submit_;
+  if (tag != poll_tag)
+    ++requests_;
+  return sqe;
+}
+
+void uring_multiplexer::submit(unsigned wait_nr) {
+  // Entering the kernel also flushes completions that did not fit into the
+  // completion queue.
+  auto overflow = (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED)
+                   & IORING_SQ_CQ_OVERFLOW) != 0;
+  if (to_submit_ == 0 && wait_nr == 0 && !overflow)
+    return;
+  __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+  for (;;) {
+    auto res = uring_enter(ring_fd_, to_submit_, wait_nr,
+                           IORING_ENTER_GETEVENTS);
+    if (res >= 0) {
+      to_submit_ -= static_cast<unsigned>(res);
+      return;
+    }
+    switch (errno) {
+      case EINTR:
+        // a signal was caught
+        // just try again
+        continue;
+      case EAGAIN:
+      case EBUSY:
+        // The kernel cannot accept more requests until we have processed
+        // completions.
+        return;
+      default:
+        perror("io_uring_enter() failed");
+        CAF_CRITICAL("io_uring_enter() failed");
+    }
+  }
+}
+
+bool uring_multiplexer::handle_completions() {
+  auto head = *cq_head_;
+  auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  if (head == tail)
+    return false;
+  CAF_LOG_DEBUG("io_uring reported" << (tail - head) << "completion(s)");
+  for (; head != tail; ++head) {
+    auto& cqe = cqes_[head & cq_mask_];
+    auto user_data = cqe.user_data;
+    auto res = cqe.res;
+    auto flags = cqe.flags;
+    // Release the entry before dispatching, because handlers may cause
+    // further completions by submitting new requests.
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    auto tag = static_cast<request_tag>(user_data & tag_mask);
+    auto ptr = reinterpret_cast<uring_handler*>(user_data & ~tag_mask);
+    switch (tag) {
+      case poll_tag:
+        epoll_armed_ = false;
+        if (res > 0 && !closing_)
+          default_multiplexer::poll_once_impl(false);
+        break;
+      case cancel_tag:
+        --requests_;
+        break;
+      default:
+        if ((flags & IORING_CQE_F_MORE) == 0)
+          --requests_;
+        if ((flags & IORING_CQE_F_BUFFER) != 0)
+          --free_buffers_;
+        ptr->complete(tag, res, flags);
+    }
+  }
+  return true;
+}
+
+bool uring_multiplexer::handle_pending() {
+  auto result = false;
+  while (!ready_.empty() || !removed_.empty()) {
+    result = true;
+    // Calling `forget` replaces handlers in the swap space with `nullptr`.
+    resuming_.swap(ready_);
+    for (size_t i = 0; i < resuming_.size(); ++i)
+      if (resuming_[i] != nullptr)
+        resuming_[i]->resume();
+    resuming_.clear();
+    removing_.swap(removed_);
+    for (size_t i = 0; i < removing_.size(); ++i) {
+      auto x = removing_[i];
+      if (x.handler != nullptr)
+        x.ptr->removed_from_loop(x.op);
+    }
+    removing_.clear();
+  }
+  return result;
+}
+
+void uring_multiplexer::add_buffer(uint16_t id) {
+  // The kernel headers declare `bufs` as flexible array member, which C++
+  // compilers place behind an empty struct. Hence, we must not access the
+  // member directly: the ring starts at the first byte of the mapping.
+  auto bufs = reinterpret_cast<io_uring_buf*>(buf_ring_);
+  auto& buf = bufs[buf_tail_ & (num_buffers - 1)];
+  buf.addr = reinterpret_cast<uint64_t>(buffers_.data() + id * buffer_size);
+  buf.len = static_cast<uint32_t>(buffer_size);
+  buf.bid = id;
+  ++buf_tail_;
+  ++free_buffers_;
+}
+
+void uring_multiplexer::forget(uring_handler* ptr) {
+  handlers_.erase(ptr);
+  auto is_ptr = [=](const uring_handler* x) { return x == ptr; };
+  ready_.erase(std::remove_if(ready_.begin(), ready_.end(), is_ptr),
+               ready_.end());
+  starved_.erase(std::remove_if(starved_.begin(), starved_.end(), is_ptr),
+                 starved_.end());
+  std::replace(resuming_.begin(), resuming_.end(), ptr,
+               static_cast<uring_handler*>(nullptr));
+  auto has_ptr = [=](const removal& x) { return x.handler == ptr; };
+  removed_.erase(std::remove_if(removed_.begin(), removed_.end(), has_ptr),
+                 removed_.end());
+  for (auto& x : removing_)
+    if (x.handler == ptr)
+      x.handler = nullptr;
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_ENABLE_IO_URING
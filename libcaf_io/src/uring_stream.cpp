@@ -0,0 +1,240 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#ifdef CAF_ENABLE_IO_URING
+
+#include "caf/io/network/uring_stream.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+
+#include "caf/logger.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+uring_stream::uring_stream(uring_multiplexer& mpx, native_socket sockfd)
+    : stream(mpx, sockfd),
+      uring_handler(mpx),
+      want_read_(false),
+      recv_pending_(false),
+      eof_(false),
+      want_write_(false),
+      send_pending_(false) {
+  memset(&msg_, 0, sizeof(msghdr));
+}
+
+uring_stream::~uring_stream() {
+  // Return all unconsumed buffers to the pool.
+  if (mpx_ != nullptr)
+    for (auto& x : inbox_)
+      mpx_->recycle(x.id);
+}
+
+void uring_stream::handle_event(operation op) {
+  CAF_LOG_TRACE(CAF_ARG(op));
+  // The multiplexer drives this stream via `resume` and `complete`. This
+  // member function only exists to satisfy the `event_handler` interface.
+  switch (op) {
+    case operation::read:
+      deliver();
+      break;
+    case operation::write:
+      if (!send_pending_)
+        start_send();
+      break;
+    case operation::propagate_error:
+      handle_error_propagation();
+      break;
+  }
+}
+
+void uring_stream::arm(operation op) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(op));
+  switch (op) {
+    case operation::read:
+      want_read_ = true;
+      break;
+    case operation::write:
+      want_write_ = true;
+      break;
+    case operation::propagate_error:
+      return;
+  }
+  mpx_->schedule(this);
+}
+
+void uring_stream::disarm(operation op) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(op));
+  switch (op) {
+    case operation::read:
+      want_read_ = false;
+      // Stop receiving to apply backpressure via the socket buffer instead of
+      // filling up the buffer pool.
+      if (recv_pending_)
+        mpx_->cancel(this, uring_multiplexer::recv_tag);
+      break;
+    case operation::write:
+      // Let pending sends run to completion.
+      want_write_ = false;
+      break;
+    case operation::propagate_error:
+      break;
+  }
+}
+
+void uring_stream::resume() {
+  if (mpx_ == nullptr || mpx_->closing())
+    return;
+  if (want_read_) {
+    deliver();
+    if (want_read_ && reader() && !recv_pending_ && !eof_
+        && !mpx_->waiting_for_buffers(this))
+      start_recv();
+  }
+  if (want_write_ && !send_pending_)
+    start_send();
+}
+
+void uring_stream::complete(uint8_t tag, int32_t res, uint32_t flags) {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_) << CAF_ARG(tag) << CAF_ARG(res));
+  switch (tag) {
+    case uring_multiplexer::recv_tag:
+      recv_done(res, flags);
+      break;
+    case uring_multiplexer::send_tag:
+      send_done(res);
+      break;
+    default:
+      CAF_LOG_ERROR("unexpected request tag:" << CAF_ARG(tag));
+  }
+}
+
+void uring_stream::deliver() {
+  while (want_read_ && reader() && !inbox_.empty()) {
+    auto& x = inbox_.front();
+    auto n = std::min(x.size - x.offset, rd_buf_space());
+    memcpy(rd_buf_pos(), mpx_->buffer(x.id) + x.offset, n);
+    x.offset += n;
+    if (x.offset == x.size) {
+      mpx_->recycle(x.id);
+      inbox_.pop_front();
+    }
+    if (!handle_read_result(rw_state::success, n))
+      return;
+  }
+  // Report the end of the stream only after delivering all data.
+  if (want_read_ && reader() && eof_ && inbox_.empty())
+    handle_read_result(rw_state::failure, 0);
+}
+
+void uring_stream::start_recv() {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_));
+  mpx_->submit_recv(this, fd());
+  recv_pending_ = true;
+  recv_guard_ = reader();
+}
+
+void uring_stream::start_send() {
+  CAF_LOG_TRACE(CAF_ARG2("fd", fd_));
+  if (!writer())
+    return;
+  io_vec bufs[max_io_vecs];
+  auto num_bufs = prepare_io_vecs(bufs);
+  if (!has_queued_data()) {
+    // Mimics an empty write on a writable socket, which policies such as SSL
+    // and `force_empty_write` rely on.
+    handle_write_result(rw_state::success, 0);
+    return;
+  }
+  for (size_t i = 0; i < num_bufs; ++i) {
+    iov_[i].iov_base = const_cast<void*>(bufs[i].data);
+    iov_[i].iov_len = bufs[i].size;
+  }
+  memset(&msg_, 0, sizeof(msghdr));
+  msg_.msg_iov = iov_;
+  msg_.msg_iovlen = num_bufs;
+  mpx_->submit_sendmsg(this, fd(), &msg_);
+  send_pending_ = true;
+  send_guard_ = writer();
+}
+
+void uring_stream::recv_done(int32_t res, uint32_t flags) {
+  // The guard keeps this stream alive until the end of this scope.
+  manager_ptr guard;
+  if ((flags & IORING_CQE_F_MORE) == 0) {
+    recv_pending_ = false;
+    guard.swap(recv_guard_);
+  }
+  if (res > 0) {
+    CAF_ASSERT((flags & IORING_CQE_F_BUFFER) != 0);
+    auto id = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+    if (mpx_->closing()) {
+      mpx_->recycle(id);
+      return;
+    }
+    inbox_.push_back(received_data{id, 0, static_cast<size_t>(res)});
+  } else if (res == 0) {
+    // The peer closed the connection.
+    eof_ = true;
+  } else {
+    switch (-res) {
+      case ECANCELED:
+        break;
+      case ENOBUFS:
+        // The pool ran dry. Try again after buffers return to the pool.
+        mpx_->wait_for_buffers(this);
+        break;
+      default:
+        CAF_LOG_DEBUG("recv failed:" << CAF_ARG2("fd", fd_)
+                      << CAF_ARG2("error", strerror(-res)));
+        eof_ = true;
+    }
+  }
+  resume();
+}
+
+void uring_stream::send_done(int32_t res) {
+  // The guard keeps this stream alive until the end of this scope.
+  manager_ptr guard;
+  guard.swap(send_guard_);
+  send_pending_ = false;
+  if (res == -ECANCELED || !writer() || mpx_->closing())
+    return;
+  if (res < 0) {
+    CAF_LOG_DEBUG("sendmsg failed:" << CAF_ARG2("fd", fd_)
+                  << CAF_ARG2("error", strerror(-res)));
+    handle_write_result(rw_state::failure, 0);
+    return;
+  }
+  handle_write_result(rw_state::success, static_cast<size_t>(res));
+  if (want_write_)
+    start_send();
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_ENABLE_IO_URING
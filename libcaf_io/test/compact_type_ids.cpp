@@ -0,0 +1,174 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_compact_type_ids
+#include "caf/test/io_dsl.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+#include "caf/io/basp/header.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr char local_host[] = "127.0.0.1";
+
+using int_vector = std::vector<int>;
+
+class config : public actor_system_config {
+public:
+  config() {
+    load<io::middleman>();
+    set("middleman.compact-type-ids", true);
+    add_message_type<int_vector>("std::vector<int>");
+  }
+};
+
+// Registers an additional type that shifts the type IDs of the client.
+class client_config : public config {
+public:
+  client_config() {
+    add_message_type<std::vector<bool>>("a_bool_vector");
+  }
+};
+
+struct fixture {
+  config server_side_config;
+  actor_system server_side;
+  io::middleman& server_side_mm;
+
+  client_config client_side_config;
+  actor_system client_side;
+  io::middleman& client_side_mm;
+
+  fixture()
+      : server_side(server_side_config),
+        server_side_mm(server_side.middleman()),
+        client_side(client_side_config),
+        client_side_mm(client_side.middleman()) {
+    // nop
+  }
+};
+
+// Simulates the network between two nodes with compact type IDs enabled to
+// inspect the bytes on the wire. Our server is `mars` and our client is
+// `earth`.
+struct wire_fixture
+  : point_to_point_fixture<test_coordinator_fixture<config>> {
+  wire_fixture() {
+    client_hdl = prepare_connection(mars, earth, "mars", 8080).second;
+  }
+
+  // Returns the bytes `earth` wrote to `mars` but `mars` did not read yet.
+  std::vector<char>& wire() {
+    return earth.mpx.output_buffer(client_hdl);
+  }
+
+  io::connection_handle client_hdl;
+};
+
+behavior sorter() {
+  return {
+    [](int_vector& xs) -> int_vector {
+      std::sort(xs.begin(), xs.end());
+      return std::move(xs);
+    },
+    [](int x, const std::string& y) {
+      return make_message(y, x + 1);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(compact_type_ids_tests, fixture)
+
+CAF_TEST(nodes translate type IDs of their peers) {
+  CAF_CHECK_NOT_EQUAL(server_side.types().type_id("std::vector<int>"),
+                      client_side.types().type_id("std::vector<int>"));
+  auto server = server_side.spawn(sorter);
+  auto port = unbox(server_side_mm.publish(server, 0, local_host));
+  auto proxy = unbox(client_side_mm.remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  self->request(proxy, infinite, int_vector{3, 1, 2}).receive(
+    [](const int_vector& xs) {
+      CAF_CHECK_EQUAL(xs, int_vector({1, 2, 3}));
+    },
+    [](error& err) {
+      CAF_FAIL("request failed: " << to_string(err));
+    }
+  );
+  self->request(proxy, infinite, 41, "foo").receive(
+    [](const std::string& x, int y) {
+      CAF_CHECK_EQUAL(x, "foo");
+      CAF_CHECK_EQUAL(y, 42);
+    },
+    [](error& err) {
+      CAF_FAIL("request failed: " << to_string(err));
+    }
+  );
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(compact_type_ids_wire_tests, wire_fixture)
+
+CAF_TEST(direct messages carry type IDs instead of type names) {
+  auto server = mars.sys.spawn(sorter);
+  mars.publish(server, 8080);
+  auto proxy = earth.remote_actor("mars", 8080);
+  CAF_REQUIRE(wire().empty());
+  CAF_MESSAGE("run only earth to keep the message on the wire");
+  earth.self->send(proxy, int_vector{3, 1, 2});
+  std::vector<planet_type*> xs{&earth};
+  exec_all_fixtures(xs.begin(), xs.end());
+  auto& buf = wire();
+  CAF_REQUIRE_GREATER(buf.size(), io::basp::header_size);
+  io::basp::header hdr;
+  binary_deserializer bd{earth.sys, buf};
+  CAF_REQUIRE_EQUAL(bd(hdr), none);
+  CAF_CHECK_EQUAL(hdr.operation, io::basp::message_type::direct_message);
+  CAF_CHECK(hdr.has(io::basp::header::type_ids_flag));
+  CAF_CHECK_EQUAL(buf.size(), io::basp::header_size + hdr.payload_len);
+  std::string type_name = "std::vector<int>";
+  CAF_CHECK(std::search(buf.begin(), buf.end(), type_name.begin(),
+                        type_name.end())
+            == buf.end());
+  CAF_MESSAGE("mars decodes the message and earth receives the result");
+  exec_all();
+  earth.self->receive(
+    [](const int_vector& ys) {
+      CAF_CHECK_EQUAL(ys, int_vector({1, 2, 3}));
+    },
+    after(std::chrono::seconds(0)) >> [] {
+      CAF_FAIL("mars did not respond");
+    }
+  );
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -22,12 +22,19 @@
 #include "caf/test/io_dsl.hpp"
 
 #include <vector>
+#include <string>
 #include <algorithm>
 
+#ifndef CAF_WINDOWS
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #include "caf/all.hpp"
 #include "caf/io/all.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/io/network/operation.hpp"
+#include "caf/policy/tcp.hpp"
 
 using namespace caf;
 
@@ -102,4 +109,28 @@ CAF_TEST(scribe io_failure) {
   CAF_CHECK_EQUAL(server.mpx.num_socket_handlers(), 1u);
 }
 
+#ifndef CAF_WINDOWS
+
+CAF_TEST(tcp policy writes multiple buffers at once) {
+  using io::network::rw_state;
+  int fds[2];
+  CAF_REQUIRE_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  std::string x = "hello ";
+  std::string y = "world";
+  io::network::io_vec bufs[] = {{x.data(), x.size()}, {y.data(), y.size()}};
+  size_t written = 0;
+  CAF_CHECK(policy::tcp::write_some(written, fds[0], bufs, 2)
+            == rw_state::success);
+  CAF_CHECK_EQUAL(written, x.size() + y.size());
+  char buf[32];
+  size_t received = 0;
+  CAF_CHECK(policy::tcp::read_some(received, fds[1], buf, sizeof(buf))
+            == rw_state::success);
+  CAF_CHECK_EQUAL(std::string(buf, received), "hello world");
+  close(fds[0]);
+  close(fds[1]);
+}
+
+#endif // CAF_WINDOWS
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,136 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_multiplexer_threads
+#include "caf/test/dsl.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr char local_host[] = "127.0.0.1";
+
+class config : public actor_system_config {
+public:
+  explicit config(int multiplexer_threads = 1) {
+    load<io::middleman>();
+    set("middleman.multiplexer-threads", multiplexer_threads);
+    if (auto err = parse(test::engine::argc(), test::engine::argv()))
+      CAF_FAIL("failed to parse config: " << to_string(err));
+  }
+};
+
+struct fixture {
+  // State for the server.
+  config server_side_config{3};
+  actor_system server_side{server_side_config};
+  io::middleman& server_side_mm = server_side.middleman();
+
+  // State for the first client.
+  config client1_config;
+  actor_system client1{client1_config};
+  io::middleman& client1_mm = client1.middleman();
+
+  // State for the second client.
+  config client2_config;
+  actor_system client2{client2_config};
+  io::middleman& client2_mm = client2.middleman();
+};
+
+behavior make_pong_behavior() {
+  return {
+    [](int val) {
+      return val + 1;
+    }
+  };
+}
+
+struct cache_state {
+  actor value;
+};
+
+behavior make_cache_behavior(stateful_actor<cache_state>* self) {
+  return {
+    [=](put_atom, actor x) {
+      self->state.value = std::move(x);
+    },
+    [=](get_atom) {
+      return self->state.value;
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(multiplexer_threads_tests, fixture)
+
+CAF_TEST(backends) {
+  CAF_CHECK_EQUAL(server_side_mm.num_backends(), 3u);
+  CAF_CHECK_EQUAL(client1_mm.num_backends(), 1u);
+  CAF_CHECK_EQUAL(&server_side_mm.backend(0), &server_side_mm.backend());
+  CAF_CHECK_NOT_EQUAL(&server_side_mm.backend(1), &server_side_mm.backend());
+}
+
+CAF_TEST(messages between shards) {
+  auto cache = server_side.spawn(make_cache_behavior);
+  auto port = unbox(server_side_mm.publish(cache, 0, local_host));
+  CAF_MESSAGE("client 1 connects and stores a local actor at the server");
+  auto pong = client1.spawn(make_pong_behavior);
+  {
+    auto remote_cache = unbox(client1_mm.remote_actor(local_host, port));
+    scoped_actor self{client1};
+    self->request(remote_cache, infinite, put_atom::value, pong).receive(
+      [] {
+        // nop
+      },
+      [](error& err) {
+        CAF_FAIL("put failed: " << to_string(err));
+      });
+  }
+  CAF_MESSAGE("client 2 connects and talks to client 1 via the server");
+  auto remote_cache = unbox(client2_mm.remote_actor(local_host, port));
+  scoped_actor self{client2};
+  actor remote_pong;
+  self->request(remote_cache, infinite, get_atom::value).receive(
+    [&](actor& x) {
+      remote_pong = std::move(x);
+    },
+    [](error& err) {
+      CAF_FAIL("get failed: " << to_string(err));
+    });
+  CAF_REQUIRE(remote_pong);
+  CAF_CHECK_EQUAL(remote_pong->node(), client1.node());
+  for (int i = 0; i < 10; ++i) {
+    self->request(remote_pong, infinite, i).receive(
+      [&](int y) {
+        CAF_CHECK_EQUAL(y, i + 1);
+      },
+      [](error& err) {
+        CAF_FAIL("ping failed: " << to_string(err));
+      });
+  }
+  anon_send_exit(cache, exit_reason::user_shutdown);
+  anon_send_exit(pong, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
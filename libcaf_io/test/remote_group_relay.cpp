@@ -0,0 +1,163 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_remote_group_relay
+#include "caf/test/io_dsl.hpp"
+
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+class config : public caf::actor_system_config {
+public:
+  config() {
+    load<caf::io::middleman>();
+    set("groups.relay-fan-out", 1);
+  }
+};
+
+const uint16_t port = 8080;
+
+const char* server = "mars";
+
+const char* group_name = "foobar";
+
+struct receiver_state {
+  size_t received = 0;
+};
+
+using receiver_actor = stateful_actor<receiver_state>;
+
+behavior group_receiver(receiver_actor* self) {
+  return {
+    [=](ok_atom) {
+      ++self->state.received;
+    }
+  };
+}
+
+// Our server is `mars`, which hosts the group. With a fan-out of 1, `mars`
+// sends each message only to `earth`, which relays it to `jupiter`.
+struct fixture : belt_fixture<test_coordinator_fixture<config>> {
+  fixture() {
+    // Both clients connect to the same acceptor on mars.
+    auto hdl = next_accept_handle();
+    prepare_connection(mars, earth, server, port, hdl);
+    prepare_connection(mars, jupiter, server, port, hdl);
+    exec_all();
+    loop_after_next_enqueue(mars);
+    CAF_REQUIRE_EQUAL(mars.sys.middleman().publish_local_groups(port), port);
+    mars_grp = mars.sys.groups().get_local(group_name);
+    spawn_receivers(mars, mars_grp);
+    // Subscribe nodes one by one to make `earth` the root of the tree.
+    earth_grp = join(earth);
+    jupiter_grp = join(jupiter);
+  }
+
+  ~fixture() {
+    for (auto& x : receivers)
+      anon_send_exit(x.second, exit_reason::user_shutdown);
+    exec_all();
+  }
+
+  group join(planet_type& planet) {
+    loop_after_next_enqueue(planet);
+    auto grp = unbox(planet.mm.remote_group(group_name, server, port));
+    spawn_receivers(planet, grp);
+    exec_all();
+    return grp;
+  }
+
+  void spawn_receivers(planet_type& planet, const group& grp) {
+    for (size_t i = 0; i < 2; ++i)
+      receivers.emplace_back(&planet,
+                             planet.sys.spawn_in_group(grp, group_receiver));
+  }
+
+  // Returns how many messages each receiver on `planet` has received.
+  std::vector<size_t> received(planet_type& planet) {
+    std::vector<size_t> result;
+    for (auto& x : receivers)
+      if (x.first == &planet)
+        result.emplace_back(
+          planet.deref<receiver_actor>(x.second).state.received);
+    return result;
+  }
+
+  group mars_grp;
+  group earth_grp;
+  group jupiter_grp;
+  std::vector<std::pair<planet_type*, actor>> receivers;
+};
+
+using counts = std::vector<size_t>;
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(remote_group_relay_tests, fixture)
+
+CAF_TEST(the origin relays messages through subscribed nodes) {
+  CAF_MESSAGE("send a message on mars and run only mars and jupiter");
+  mars.self->send(mars_grp, ok_atom::value);
+  std::vector<planet_type*> xs{&mars, &jupiter};
+  exec_all_fixtures(xs.begin(), xs.end());
+  CAF_CHECK_EQUAL(received(mars), counts({1, 1}));
+  CAF_CHECK_EQUAL(received(jupiter), counts({0, 0}));
+  CAF_MESSAGE("earth delivers the message and relays it to jupiter");
+  exec_all();
+  CAF_CHECK_EQUAL(received(earth), counts({1, 1}));
+  CAF_CHECK_EQUAL(received(jupiter), counts({1, 1}));
+}
+
+CAF_TEST(each subscriber receives each message exactly once) {
+  for (int i = 0; i < 3; ++i) {
+    mars.self->send(mars_grp, ok_atom::value);
+    exec_all();
+  }
+  CAF_MESSAGE("messages from subscribed nodes travel through the origin");
+  jupiter.self->send(jupiter_grp, ok_atom::value);
+  exec_all();
+  earth.self->send(earth_grp, ok_atom::value);
+  exec_all();
+  CAF_CHECK_EQUAL(received(mars), counts({5, 5}));
+  CAF_CHECK_EQUAL(received(earth), counts({5, 5}));
+  CAF_CHECK_EQUAL(received(jupiter), counts({5, 5}));
+}
+
+CAF_TEST(the origin repairs the tree when a node leaves) {
+  CAF_MESSAGE("remove all subscribers on earth");
+  for (auto& x : receivers)
+    if (x.first == &earth)
+      anon_send_exit(x.second, exit_reason::user_shutdown);
+  exec_all();
+  CAF_MESSAGE("jupiter becomes the new root");
+  mars.self->send(mars_grp, ok_atom::value);
+  std::vector<planet_type*> xs{&mars, &jupiter};
+  exec_all_fixtures(xs.begin(), xs.end());
+  CAF_CHECK_EQUAL(received(mars), counts({1, 1}));
+  CAF_CHECK_EQUAL(received(jupiter), counts({1, 1}));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_uring_multiplexer
+#include "caf/test/dsl.hpp"
+
+#include <string>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+#ifdef CAF_ENABLE_IO_URING
+#include "caf/io/network/uring_multiplexer.hpp"
+#endif // CAF_ENABLE_IO_URING
+
+using namespace caf;
+
+namespace {
+
+constexpr char local_host[] = "127.0.0.1";
+
+class config : public actor_system_config {
+public:
+  explicit config(int multiplexer_threads = 1) {
+    load<io::middleman>();
+    set("middleman.network-backend", atom("uring"));
+    set("middleman.multiplexer-threads", multiplexer_threads);
+    if (auto err = parse(test::engine::argc(), test::engine::argv()))
+      CAF_FAIL("failed to parse config: " << to_string(err));
+  }
+};
+
+struct fixture {
+  config server_side_config{2};
+  actor_system server_side{server_side_config};
+  io::middleman& server_side_mm = server_side.middleman();
+
+  config client_side_config;
+  actor_system client_side{client_side_config};
+  io::middleman& client_side_mm = client_side.middleman();
+};
+
+behavior make_echo_behavior() {
+  return {
+    [](int x) {
+      return x + 1;
+    },
+    [](std::string& x) {
+      return std::move(x);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(uring_multiplexer_tests, fixture)
+
+CAF_TEST(backend selection) {
+#ifdef CAF_ENABLE_IO_URING
+  using io::network::uring_multiplexer;
+  auto is_uring = [](io::network::multiplexer& mpx) {
+    auto ptr = dynamic_cast<uring_multiplexer*>(&mpx);
+    return ptr != nullptr && ptr->uses_ring();
+  };
+  if (uring_multiplexer::available()) {
+    CAF_CHECK(is_uring(server_side_mm.backend()));
+    CAF_CHECK(is_uring(server_side_mm.backend(1)));
+    CAF_CHECK(is_uring(client_side_mm.backend()));
+  } else {
+    CAF_MESSAGE("kernel does not support io_uring, expect the fallback");
+    CAF_CHECK(!is_uring(server_side_mm.backend()));
+  }
+#else
+  CAF_MESSAGE("built without io_uring, expect the default multiplexer");
+#endif // CAF_ENABLE_IO_URING
+}
+
+CAF_TEST(remote messaging) {
+  auto echo = server_side.spawn(make_echo_behavior);
+  auto port = unbox(server_side_mm.publish(echo, 0, local_host));
+  auto remote_echo = unbox(client_side_mm.remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  CAF_MESSAGE("send small messages");
+  for (int i = 0; i < 10; ++i) {
+    self->request(remote_echo, infinite, i).receive(
+      [&](int y) {
+        CAF_CHECK_EQUAL(y, i + 1);
+      },
+      [](error& err) {
+        CAF_FAIL("request failed: " << to_string(err));
+      });
+  }
+  CAF_MESSAGE("send messages that span many buffers of the pool");
+  // The pool has 2 MB, hence the messages below exhaust the pool.
+  std::string payload(4 * 1024 * 1024, 'a');
+  for (size_t i = 0; i < payload.size(); i += 4096)
+    payload[i] = static_cast<char>('a' + (i / 4096) % 26);
+  for (int i = 0; i < 3; ++i) {
+    self->request(remote_echo, infinite, payload).receive(
+      [&](const std::string& y) {
+        CAF_CHECK(y == payload);
+      },
+      [](error& err) {
+        CAF_FAIL("request failed: " << to_string(err));
+      });
+  }
+  anon_send_exit(echo, exit_reason::user_shutdown);
+}
+
+CAF_TEST(many connections) {
+  auto echo = server_side.spawn(make_echo_behavior);
+  auto port = unbox(server_side_mm.publish(echo, 0, local_host));
+  std::vector<std::unique_ptr<config>> cfgs;
+  std::vector<std::unique_ptr<actor_system>> clients;
+  for (int i = 0; i < 5; ++i) {
+    cfgs.emplace_back(new config);
+    clients.emplace_back(new actor_system(*cfgs.back()));
+  }
+  for (auto& sys : clients) {
+    auto remote_echo = unbox(sys->middleman().remote_actor(local_host, port));
+    scoped_actor self{*sys};
+    self->request(remote_echo, infinite, 41).receive(
+      [&](int y) {
+        CAF_CHECK_EQUAL(y, 42);
+      },
+      [](error& err) {
+        CAF_FAIL("request failed: " << to_string(err));
+      });
+  }
+  anon_send_exit(echo, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -74,6 +74,13 @@ struct ssl_policy {
     return session_->write_some(result, fd, buf, len);
   }
 
+  rw_state write_some(size_t& result, native_socket fd,
+                      const io::network::io_vec* bufs, size_t) {
+    // OpenSSL has no scatter/gather I/O. Hence, we write only the first block
+    // and the stream passes the remaining blocks in subsequent calls.
+    return write_some(result, fd, bufs[0].data, bufs[0].size);
+  }
+
   bool try_accept(native_socket& result, native_socket fd) {
     CAF_LOG_TRACE(CAF_ARG(fd));
     sockaddr_storage addr;
@@ -133,6 +140,10 @@ class scribe_impl : public io::scribe {
       return stream_.rd_buf();
     }
 
+    void write(io::network::chunk_ptr chunk) override {
+      stream_.write(std::move(chunk));
+    }
+
     void graceful_shutdown() override {
       CAF_LOG_TRACE("");
       stream_.graceful_shutdown();
@@ -0,0 +1,96 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+// Converts binary log files (logger.file-encoding='binary') to text.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "caf/all.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/binary_log.hpp"
+
+using std::string;
+
+using namespace caf;
+
+namespace {
+
+struct config : public actor_system_config {
+  string output_file;
+  string format{defaults::logger::file_format.begin(),
+                defaults::logger::file_format.end()};
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(output_file, "output-file,o", "Path for the output file (or stdout)")
+    .add(format, "format,f", "Line format for rendering log entries");
+    // shutdown logging per default
+    set("logger.verbosity", atom("quiet"));
+  }
+};
+
+bool convert(const string& file_name, const logger::line_format& lf,
+             std::ostream& out) {
+  std::ifstream in{file_name, std::ios::binary};
+  if (!in) {
+    std::cerr << "could not open file: " << file_name << std::endl;
+    return false;
+  }
+  detail::binary_log_reader reader{in};
+  if (!reader.read_header()) {
+    std::cerr << "not a binary log (or written on a machine with different "
+                 "byte order): "
+              << file_name << std::endl;
+    return false;
+  }
+  logger::event x;
+  string thread_name;
+  while (reader.read(x, thread_name))
+    logger::render_offline(out, lf, x, reader.t0(), thread_name);
+  if (!in.eof()) {
+    std::cerr << "malformed binary log: " << file_name << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system&, const config& cfg) {
+  using namespace std;
+  if (cfg.remainder.empty()) {
+    cerr << "*** no input file specified" << endl;
+    return;
+  }
+  // The format refers to `cfg.format` and must not outlive it.
+  auto lf = logger::parse_format(cfg.format);
+  std::ofstream fout;
+  if (!cfg.output_file.empty()) {
+    fout.open(cfg.output_file);
+    if (!fout) {
+      cerr << "unable to open output file: " << cfg.output_file << endl;
+      return;
+    }
+  }
+  auto& out = fout.is_open() ? static_cast<std::ostream&>(fout) : cout;
+  for (auto& file : cfg.remainder)
+    convert(file, lf, out);
+}
+
+CAF_MAIN()